@@ -0,0 +1,1047 @@
+
+# include <atomic>
+# include <algorithm>
+# include <chrono>
+# include <cmath>
+# include <string>
+# include <memory>
+# include <thread>
+# include <vector>
+# include <cstdint>
+# include <cstdlib>
+# include <new>
+# include <fstream>
+# include <filesystem>
+# include <iomanip>
+# include <iostream>
+# include <exception>
+# include <functional>
+# include <SDL2/SDL.h>
+# include <SDL2/SDL_ttf.h>
+# include "Brush.hh"
+# include "Gradient.hh"
+# include "ImageCache.hh"
+# include "BitmapLoader.hh"
+# include "TextureBundle.hh"
+# include "SdlEngine.hh"
+# include "FontCache.hh"
+# include "KeyEvent.hh"
+# include "PaintEvent.hh"
+# include "EngineObject.hh"
+# include "SurfaceTexture.hh"
+# include "EventsDispatcher.hh"
+
+namespace {
+
+  using namespace sdl::core::engine;
+
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * @brief - The number of allocations made through the global `operator new`
+   *          since the start of the program.
+   */
+  std::atomic<std::size_t> g_allocations(0u);
+
+  /**
+   * @brief - The measurement of a single path of the engine. Durations are
+   *          expressed in nanoseconds.
+   */
+  struct Result {
+    std::string name;
+    unsigned iterations;
+    double total;
+    double perOp;
+    double allocations;
+  };
+
+  /**
+   * @brief - The number of calls made before measuring a path so that caches
+   *          and lazily allocated buffers are already set up.
+   */
+  constexpr unsigned sk_warmup = 16u;
+
+  /**
+   * @brief - Calls the input function a number of times and records how long
+   *          it took and how many allocations it made on average.
+   * @param results - the list to which the measurement is appended.
+   * @param name - the name of the measured path.
+   * @param iterations - the number of calls to measure.
+   * @param func - the function to measure.
+   */
+  void
+  measure(std::vector<Result>& results,
+          const std::string& name,
+          unsigned iterations,
+          const std::function<void()>& func)
+  {
+    for (unsigned id = 0u ; id < sk_warmup ; ++id) {
+      func();
+    }
+
+    const std::size_t allocations = g_allocations.load();
+    const Clock::time_point start = Clock::now();
+    for (unsigned id = 0u ; id < iterations ; ++id) {
+      func();
+    }
+    const Clock::time_point end = Clock::now();
+
+    const double total = std::chrono::duration<double, std::nano>(end - start).count();
+    const double allocs = 1.0 * (g_allocations.load() - allocations) / iterations;
+    results.push_back(Result{name, iterations, total, total / iterations, allocs});
+
+    std::cout << std::left << std::setw(32) << name
+              << std::right << std::setw(14) << std::fixed << std::setprecision(1) << results.back().perOp
+              << " ns/op"
+              << std::setw(10) << results.back().allocations
+              << " allocs/op" << std::endl;
+  }
+
+  /**
+   * @brief - Writes the measurements in the input stream as a json document.
+   * @param out - the stream to write to.
+   * @param results - the measurements to write.
+   */
+  void
+  writeJson(std::ostream& out,
+            const std::vector<Result>& results)
+  {
+    out << "{" << std::endl;
+    out << "  \"benchmarks\": [" << std::endl;
+
+    for (std::vector<Result>::const_iterator result = results.cbegin() ;
+         result != results.cend() ;
+         ++result)
+    {
+      out << "    {"
+          << "\"name\": \"" << result->name << "\", "
+          << "\"iterations\": " << result->iterations << ", "
+          << std::fixed << std::setprecision(1)
+          << "\"total_ns\": " << result->total << ", "
+          << "\"ns_per_op\": " << result->perOp << ", "
+          << "\"allocs_per_op\": " << result->allocations
+          << "}" << (result + 1 == results.cend() ? "" : ",") << std::endl;
+    }
+
+    out << "  ]" << std::endl;
+    out << "}" << std::endl;
+  }
+
+  /**
+   * @brief - A listener counting the key events it receives so that the
+   *          throughput of the dispatcher can be measured. Listeners which
+   *          are not interested in key events are skipped by the router.
+   */
+  class CountingListener: public EngineObject {
+    public:
+
+      CountingListener(bool interested = true):
+        EngineObject(std::string("bench_listener"), false),
+        m_count(0u)
+      {
+        setInterestedIn(Event::Type::KeyPress, interested);
+      }
+
+      unsigned
+      getCount() const noexcept {
+        return m_count.load();
+      }
+
+    protected:
+
+      bool
+      keyPressEvent(const KeyEvent& /*e*/) override {
+        ++m_count;
+        return true;
+      }
+
+    private:
+
+      std::atomic<unsigned> m_count;
+  };
+
+  SDL_Event
+  createKeyEvent() {
+    SDL_Event event;
+    SDL_zero(event);
+
+    event.type = SDL_KEYDOWN;
+    event.key.state = SDL_PRESSED;
+    event.key.keysym.sym = SDLK_a;
+    event.key.keysym.scancode = SDL_SCANCODE_A;
+
+    return event;
+  }
+
+  /**
+   * @brief - Measures the conversion of the system events into the events of
+   *          the engine. Each iteration pushes a batch of key events in the
+   *          queue of the SDL and polls them, either in a new vector or in a
+   *          buffer reused across iterations: the difference in allocations
+   *          is the cost of the temporary vector.
+   */
+  void
+  benchPollEvents(std::vector<Result>& results,
+                  SdlEngine& engine,
+                  unsigned iterations)
+  {
+    constexpr unsigned batch = 64u;
+    std::vector<SDL_Event> raw(batch, createKeyEvent());
+    std::vector<EventShPtr> events;
+
+    measure(results, "poll_events_64", iterations,
+      [&]() {
+        SDL_PeepEvents(raw.data(), static_cast<int>(raw.size()), SDL_ADDEVENT, 0u, 0u);
+
+        events.clear();
+        engine.pollEvents(events);
+      }
+    );
+
+    measure(results, "poll_events_64_new_vector", iterations,
+      [&]() {
+        SDL_PeepEvents(raw.data(), static_cast<int>(raw.size()), SDL_ADDEVENT, 0u, 0u);
+
+        events = engine.pollEvents();
+      }
+    );
+  }
+
+  /**
+   * @brief - Measures the time needed by the dispatcher to route a batch of
+   *          key events to a listener from the moment they are pumped.
+   */
+  void
+  benchDispatcher(std::vector<Result>& results,
+                  EngineShPtr engine,
+                  unsigned iterations)
+  {
+    constexpr unsigned batch = 64u;
+
+    // The dispatcher should not wait between frames for the measurement to
+    // reflect the routing of events.
+    EventsDispatcher dispatcher(10000.0f, engine, false, std::string("bench_dispatcher"));
+    CountingListener listener;
+    dispatcher.addListener(&listener);
+
+    dispatcher.run();
+
+    const SDL_KeyboardEvent key = createKeyEvent().key;
+    unsigned expected = 0u;
+
+    measure(results, "dispatch_events_64", iterations,
+      [&]() {
+        std::vector<EventShPtr> events;
+        for (unsigned id = 0u ; id < batch ; ++id) {
+          events.push_back(std::make_shared<KeyEvent>(key));
+        }
+
+        expected += batch;
+        dispatcher.pumpEvents(events);
+
+        while (listener.getCount() < expected) {
+          std::this_thread::yield();
+        }
+      }
+    );
+
+    dispatcher.stop();
+  }
+
+  /**
+   * @brief - Measures the routing of key events when many listeners are
+   *          registered but only one of them is interested in such events.
+   */
+  void
+  benchRoutedDispatcher(std::vector<Result>& results,
+                        EngineShPtr engine,
+                        unsigned iterations)
+  {
+    constexpr unsigned batch = 64u;
+    constexpr unsigned listeners = 1000u;
+
+    EventsDispatcher dispatcher(10000.0f, engine, false, std::string("bench_routed_dispatcher"));
+
+    std::vector<std::unique_ptr<CountingListener>> others;
+    for (unsigned id = 0u ; id < listeners - 1u ; ++id) {
+      others.push_back(std::make_unique<CountingListener>(false));
+      dispatcher.addListener(others.back().get());
+    }
+
+    CountingListener listener;
+    dispatcher.addListener(&listener);
+
+    dispatcher.run();
+
+    const SDL_KeyboardEvent key = createKeyEvent().key;
+    unsigned expected = 0u;
+
+    measure(results, "dispatch_routed_64_of_1000", iterations,
+      [&]() {
+        std::vector<EventShPtr> events;
+        for (unsigned id = 0u ; id < batch ; ++id) {
+          events.push_back(std::make_shared<KeyEvent>(key));
+        }
+
+        expected += batch;
+        dispatcher.pumpEvents(events);
+
+        while (listener.getCount() < expected) {
+          std::this_thread::yield();
+        }
+      }
+    );
+
+    dispatcher.stop();
+  }
+
+  void
+  benchTextures(std::vector<Result>& results,
+                SdlEngine& engine,
+                const sdl::utils::Uuid& win,
+                unsigned iterations)
+  {
+    const Palette palette = Palette::fromButtonColor(Color::NamedColor::Orange);
+
+    const sdl::utils::Uuid canvas = engine.createTexture(win, sdl::utils::Sizef(512.0f, 512.0f), Palette::ColorRole::Background);
+    const sdl::utils::Uuid tex = engine.createTexture(win, sdl::utils::Sizef(64.0f, 64.0f), Palette::ColorRole::Base);
+    engine.fillTexture(canvas, palette);
+    engine.fillTexture(tex, palette);
+
+    const sdl::utils::Boxf where(32.0f, 32.0f, 64.0f, 64.0f);
+
+    measure(results, "fill_texture_512", iterations,
+      [&]() {
+        engine.fillTexture(canvas, palette);
+      }
+    );
+
+    measure(results, "draw_texture_64", iterations,
+      [&]() {
+        engine.drawTexture(tex, nullptr, &canvas, &where);
+      }
+    );
+
+    engine.destroyTexture(tex);
+    engine.destroyTexture(canvas);
+  }
+
+  /**
+   * @brief - Measures the rendering of text through the glyphs cache. The
+   *          cache is warm after the first iteration so this reflects the
+   *          steady state of an application.
+   */
+  void
+  benchFonts(std::vector<Result>& results,
+             const std::string& file,
+             unsigned iterations)
+  {
+    TTF_Font* font = TTF_OpenFont(file.c_str(), 25);
+    if (font == nullptr) {
+      std::cerr << "Could not open font \"" << file << "\": " << TTF_GetError() << std::endl;
+      return;
+    }
+
+    {
+      FontCache cache(std::string("bench_font"), font);
+      const std::string text("The quick brown fox jumps over the lazy dog");
+
+      measure(results, "font_cache_render", iterations,
+        [&]() {
+          SDL_Surface* surface = cache.render(text, Color::NamedColor::Black, false);
+          SDL_FreeSurface(surface);
+        }
+      );
+
+      measure(results, "font_cache_query_size", iterations,
+        [&]() {
+          cache.querySize(text, false);
+        }
+      );
+    }
+
+    TTF_CloseFont(font);
+  }
+
+  /**
+   * @brief - Measures the upload of raw pixels into a texture: the surface is
+   *          only converted when the texture is first used.
+   */
+  void
+  benchSurfaceUpload(std::vector<Result>& results,
+                     SDL_Renderer* renderer,
+                     unsigned iterations)
+  {
+    const sdl::utils::Sizei dims(256, 256);
+
+    measure(results, "surface_texture_upload_256", iterations,
+      [&]() {
+        std::vector<Color> colors(dims.w() * dims.h(), Color::NamedColor::Cyan);
+        SurfaceTexture tex(renderer, SurfaceTexture::createFromData(dims, colors));
+        tex();
+      }
+    );
+  }
+
+  void
+  benchGradient(std::vector<Result>& results,
+                SDL_Renderer* renderer,
+                unsigned iterations)
+  {
+    const Gradient grad(std::string("bench_gradient"), gradient::Mode::Linear, Color::NamedColor::Red, Color::NamedColor::Blue);
+
+    measure(results, "brush_draw_gradient_256", iterations,
+      [&]() {
+        Brush brush(std::string("bench_brush"), sdl::utils::Sizef(256.0f, 256.0f));
+        brush.drawGradient(grad);
+        brush.render(renderer);
+      }
+    );
+  }
+
+  /**
+   * @brief - Creates a bitmap image of the specified dimensions filled with
+   *          a single color.
+   * @param file - the path of the image to create.
+   * @param w - the width of the image.
+   * @param h - the height of the image.
+   * @return - `true` if the image could be written.
+   */
+  bool
+  writeBitmap(const std::string& file,
+              int w,
+              int h)
+  {
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, SDL_PIXELFORMAT_ARGB8888);
+    if (surface == nullptr) {
+      return false;
+    }
+
+    SDL_FillRect(surface, nullptr, SDL_MapRGBA(surface->format, 0x20, 0x80, 0xC0, 0xFF));
+    const bool written = (SDL_SaveBMP(surface, file.c_str()) == 0);
+
+    SDL_FreeSurface(surface);
+
+    return written;
+  }
+
+  /**
+   * @brief - Measures the loading of an image through the image cache, both
+   *          when the image needs to be read from the disk and when it is
+   *          already available in the cache.
+   */
+  void
+  benchImageCache(std::vector<Result>& results,
+                  const std::string& dir,
+                  unsigned iterations)
+  {
+    const std::string file = dir + "/cache_256.bmp";
+    if (!writeBitmap(file, 256, 256)) {
+      std::cerr << "Could not create image \"" << file << "\": " << SDL_GetError() << std::endl;
+      return;
+    }
+
+    ImageCache& cache = ImageCache::getInstance();
+
+    measure(results, "image_cache_miss_256", iterations,
+      [&]() {
+        cache.clear();
+        cache.load(file);
+      }
+    );
+
+    measure(results, "image_cache_hit_256", iterations,
+      [&]() {
+        cache.load(file);
+      }
+    );
+
+    cache.clear();
+  }
+
+  /**
+   * @brief - Marks the input bitmap image as stored from the top to the bottom
+   *          by negating its height. The rows are not reordered so the image
+   *          appears flipped but this is irrelevant for the measurements.
+   * @param file - the path of the image to update.
+   * @return - `true` if the image could be updated.
+   */
+  bool
+  makeTopDown(const std::string& file) {
+    // The height is stored after the file header (14 bytes), the size of the
+    // info header and the width (4 bytes each).
+    constexpr std::streamoff offset = 22;
+
+    std::fstream stream(file, std::ios::in | std::ios::out | std::ios::binary);
+    std::uint8_t bytes[4];
+    if (!stream.seekg(offset).read(reinterpret_cast<char*>(bytes), sizeof(bytes))) {
+      return false;
+    }
+
+    const std::uint32_t h = bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (static_cast<std::uint32_t>(bytes[3]) << 24);
+    const std::uint32_t flipped = ~h + 1u;
+    for (unsigned id = 0u ; id < sizeof(bytes) ; ++id) {
+      bytes[id] = static_cast<std::uint8_t>(flipped >> (8u * id));
+    }
+
+    return static_cast<bool>(stream.seekp(offset).write(reinterpret_cast<const char*>(bytes), sizeof(bytes)));
+  }
+
+  /**
+   * @brief - Measures the loading of a 64 MB bitmap image with the mapping
+   *          loader compared to `SDL_LoadBMP`, for images stored both from the
+   *          bottom to the top (copied once) and from the top to the bottom
+   *          (used in place). Loading such images is slow so only a fraction
+   *          of the iterations is used.
+   */
+  void
+  benchBitmapLoader(std::vector<Result>& results,
+                    const std::string& dir,
+                    unsigned iterations)
+  {
+    const std::string bottomUp = dir + "/sheet_4096.bmp";
+    const std::string topDown = dir + "/sheet_4096_top_down.bmp";
+
+    if (!writeBitmap(bottomUp, 4096, 4096) || !writeBitmap(topDown, 4096, 4096) || !makeTopDown(topDown)) {
+      std::cerr << "Could not create images in \"" << dir << "\": " << SDL_GetError() << std::endl;
+      return;
+    }
+
+    const unsigned count = std::max(1u, iterations / 100u);
+
+    measure(results, "load_bitmap_4096", count,
+      [&]() {
+        loadBitmap(bottomUp);
+      }
+    );
+
+    measure(results, "load_bitmap_4096_top_down", count,
+      [&]() {
+        loadBitmap(topDown);
+      }
+    );
+
+    measure(results, "sdl_load_bmp_4096", count,
+      [&]() {
+        SDL_FreeSurface(SDL_LoadBMP(bottomUp.c_str()));
+      }
+    );
+
+    measure(results, "sdl_load_bmp_4096_top_down", count,
+      [&]() {
+        SDL_FreeSurface(SDL_LoadBMP(topDown.c_str()));
+      }
+    );
+
+    std::filesystem::remove(bottomUp);
+    std::filesystem::remove(topDown);
+  }
+
+  /**
+   * @brief - Measures the cold start of an application loading its images
+   *          either from individual files or from a bundle. The cache is
+   *          cleared before each iteration.
+   */
+  void
+  benchTextureBundle(std::vector<Result>& results,
+                     const std::string& dir,
+                     unsigned iterations)
+  {
+    constexpr unsigned count = 64u;
+
+    std::vector<std::string> files;
+    for (unsigned id = 0u ; id < count ; ++id) {
+      files.push_back(dir + "/bundle_" + std::to_string(id) + ".bmp");
+
+      if (!writeBitmap(files.back(), 128, 128)) {
+        std::cerr << "Could not create image \"" << files.back() << "\": " << SDL_GetError() << std::endl;
+        return;
+      }
+    }
+
+    const std::string file = dir + "/images.bundle";
+    TextureBundle(file).write(files);
+
+    ImageCache& cache = ImageCache::getInstance();
+
+    measure(results, "load_files_64", iterations,
+      [&]() {
+        cache.clear();
+        for (std::vector<std::string>::const_iterator image = files.cbegin() ;
+             image != files.cend() ;
+             ++image)
+        {
+          cache.load(*image);
+        }
+      }
+    );
+
+    measure(results, "load_bundle_64", iterations,
+      [&]() {
+        cache.clear();
+        TextureBundle(file).load();
+      }
+    );
+
+    cache.clear();
+  }
+
+  /**
+   * @brief - Measures the drawing operations performed by the input function
+   *          on a brush of the specified size, including the creation of the
+   *          texture from the brush. The brush is cleared before each call so
+   *          that operations do not pile up from one iteration to the next.
+   * @param results - the list to which the measurement is appended.
+   * @param name - the name of the measured path.
+   * @param renderer - the renderer used to create the textures.
+   * @param size - the size of the canvas of the brush.
+   * @param iterations - the number of calls to measure.
+   * @param draw - the drawing operations to measure.
+   */
+  void
+  measureBrush(std::vector<Result>& results,
+               const std::string& name,
+               SDL_Renderer* renderer,
+               const sdl::utils::Sizef& size,
+               unsigned iterations,
+               const std::function<void(Brush&)>& draw)
+  {
+    Brush brush(std::string("bench_brush"), size);
+
+    measure(results, name, iterations,
+      [&]() {
+        brush.clear();
+        draw(brush);
+        brush.render(renderer);
+      }
+    );
+  }
+
+  /**
+   * @brief - Measures the drawing of lines and of a horizontal gradient on
+   *          a 4K canvas. Such canvases are slow to fill so only a fraction
+   *          of the iterations is used.
+   */
+  void
+  benchBrush4K(std::vector<Result>& results,
+               SDL_Renderer* renderer,
+               unsigned iterations)
+  {
+    const sdl::utils::Sizef size(3840.0f, 2160.0f);
+    const unsigned count = std::max(1u, iterations / 10u);
+
+    measureBrush(results, "brush_draw_lines_4k", renderer, size, count,
+      [](Brush& brush) {
+        brush.setColor(Color::NamedColor::Red);
+
+        for (unsigned id = 0u ; id < 256u ; ++id) {
+          brush.drawLine(Brush::Direction::Horizontal, 8.0f * id);
+          brush.drawLine(Brush::Direction::Vertical, 15.0f * id);
+        }
+      }
+    );
+
+    const Gradient grad(std::string("bench_gradient_4k"), gradient::Mode::Linear, Color::NamedColor::Red, Color::NamedColor::Blue);
+
+    measureBrush(results, "brush_draw_gradient_4k", renderer, size, count,
+      [&grad](Brush& brush) {
+        brush.drawGradient(grad);
+      }
+    );
+  }
+
+  /**
+   * @brief - Measures the drawing of gradients computed for each pixel, i.e.
+   *          radial gradients and linear gradients which are not horizontal.
+   *          The canvas is large enough to be drawn by several threads.
+   */
+  void
+  benchPixelGradients(std::vector<Result>& results,
+                      SDL_Renderer* renderer,
+                      unsigned iterations)
+  {
+    const sdl::utils::Sizef size(1024.0f, 1024.0f);
+    const unsigned count = std::max(1u, iterations / 10u);
+
+    Gradient radial(std::string("bench_gradient_radial"), gradient::Mode::Radiant, Color::NamedColor::Red, Color::NamedColor::Blue);
+    radial.setColorAt(0.5f, Color::NamedColor::Green);
+
+    measureBrush(results, "brush_draw_radial_1024", renderer, size, count,
+      [&radial](Brush& brush) {
+        brush.drawGradient(radial);
+      }
+    );
+
+    Gradient angled(std::string("bench_gradient_angled"), gradient::Mode::Linear, Color::NamedColor::Red, Color::NamedColor::Blue);
+    angled.setAngle(30.0f);
+
+    measureBrush(results, "brush_draw_angled_1024", renderer, size, count,
+      [&angled](Brush& brush) {
+        brush.drawGradient(angled);
+      }
+    );
+  }
+
+  /**
+   * @brief - Measures the replay of a list of commands on a canvas split in
+   *          tiles drawn concurrently. The number of threads drawing tiles
+   *          follows the number of cores of the machine: running the bench
+   *          on machines with different core counts gives the speedup. The
+   *          same commands on a canvas drawn as a single tile are measured
+   *          as a reference.
+   */
+  void
+  benchTiledReplay(std::vector<Result>& results,
+                   SDL_Renderer* renderer,
+                   unsigned iterations)
+  {
+    const unsigned count = std::max(1u, iterations / 10u);
+
+    Gradient grad(std::string("bench_gradient_tiles"), gradient::Mode::Radiant, Color::NamedColor::White, Color::NamedColor::Black);
+
+    const std::function<void(Brush&)> scene = [&grad](Brush& brush) {
+      brush.drawGradient(grad);
+      brush.setColor(Color::NamedColor::Orange);
+
+      for (unsigned id = 0u ; id < 64u ; ++id) {
+        brush.drawLine(Brush::Direction::Horizontal, 3.0f * id);
+        brush.drawLine(Brush::Direction::Vertical, 3.0f * id);
+      }
+    };
+
+    measureBrush(results, "brush_replay_single_tile_192", renderer, sdl::utils::Sizef(192.0f, 192.0f), iterations, scene);
+    measureBrush(results, "brush_replay_tiled_2048", renderer, sdl::utils::Sizef(2048.0f, 2048.0f), count, scene);
+  }
+
+  /**
+   * @brief - Measures the rasterization of the anti-aliased primitives on a
+   *          1024x1024 canvas. Shapes are spread over the canvas so that the
+   *          fill rate can be derived from the covered area.
+   */
+  void
+  benchShapes(std::vector<Result>& results,
+              SDL_Renderer* renderer,
+              unsigned iterations)
+  {
+    const sdl::utils::Sizef size(1024.0f, 1024.0f);
+    const unsigned count = std::max(1u, iterations / 10u);
+
+    measureBrush(results, "brush_draw_segments_64", renderer, size, count,
+      [](Brush& brush) {
+        brush.setColor(Color::NamedColor::Blue);
+
+        for (unsigned id = 0u ; id < 64u ; ++id) {
+          const float offset = 16.0f * id - 512.0f;
+          brush.drawSegment(sdl::utils::Vector2f(-500.0f, offset), sdl::utils::Vector2f(500.0f, -offset), 3.0f);
+        }
+      }
+    );
+
+    measureBrush(results, "brush_fill_ellipses_16", renderer, size, count,
+      [](Brush& brush) {
+        brush.setColor(Color::NamedColor::Green);
+
+        for (unsigned id = 0u ; id < 16u ; ++id) {
+          const float x = 256.0f * (id % 4u) - 384.0f;
+          const float y = 256.0f * (id / 4u) - 384.0f;
+          brush.fillEllipse(sdl::utils::Vector2f(x, y), sdl::utils::Sizef(120.0f, 80.0f));
+        }
+      }
+    );
+
+    measureBrush(results, "brush_fill_rounded_rects_16", renderer, size, count,
+      [](Brush& brush) {
+        brush.setColor(Color::NamedColor::Magenta);
+
+        for (unsigned id = 0u ; id < 16u ; ++id) {
+          const float x = 256.0f * (id % 4u) - 384.0f;
+          const float y = 256.0f * (id / 4u) - 384.0f;
+          brush.fillRoundedRect(sdl::utils::Boxf(x, y, 200.0f, 150.0f), 24.0f);
+        }
+      }
+    );
+
+    // A star covering most of the canvas, with self-intersections.
+    std::vector<sdl::utils::Vector2f> star;
+    for (unsigned id = 0u ; id < 5u ; ++id) {
+      const float angle = 2.0f * 3.14159265358979f * (2u * id) / 5.0f;
+      star.push_back(sdl::utils::Vector2f(500.0f * std::cos(angle), 500.0f * std::sin(angle)));
+    }
+
+    measureBrush(results, "brush_fill_polygon_star", renderer, size, count,
+      [&star](Brush& brush) {
+        brush.setColor(Color::NamedColor::Yellow);
+        brush.fillPolygon(star);
+      }
+    );
+  }
+
+  /**
+   * @brief - Measures the span versions of the color space operations against
+   *          the same operations performed one color at a time.
+   */
+  void
+  benchColorSpans(std::vector<Result>& results,
+                  unsigned iterations)
+  {
+    constexpr unsigned count = 4096u;
+
+    std::vector<float> h(count), sat(count), v(count);
+    std::vector<Color> lhs, rhs;
+    for (unsigned id = 0u ; id < count ; ++id) {
+      h[id] = 1.0f * id / count;
+      sat[id] = 0.25f + 0.5f * (id % 7u) / 7.0f;
+      v[id] = 0.5f + 0.5f * (id % 13u) / 13.0f;
+
+      lhs.push_back(Color::fromHSV(h[id], sat[id], v[id]));
+      rhs.push_back(Color::fromHSV(1.0f - h[id], v[id], sat[id]));
+    }
+
+    std::vector<std::uint32_t> out(count);
+
+    const auto pack = [](const Color& c) {
+      const SDL_Color sdl = c.toSDLColor();
+      return (static_cast<std::uint32_t>(sdl.a) << 24) | (sdl.r << 16) | (sdl.g << 8) | sdl.b;
+    };
+
+    measure(results, "color_hsv_scalar_4096", iterations,
+      [&]() {
+        for (unsigned id = 0u ; id < count ; ++id) {
+          out[id] = pack(Color::fromHSV(h[id], sat[id], v[id]));
+        }
+      }
+    );
+
+    measure(results, "color_hsv_span_4096", iterations,
+      [&]() {
+        Color::convertHSVToARGB(h.data(), sat.data(), v.data(), out.data(), count);
+      }
+    );
+
+    measure(results, "color_brighten_scalar_4096", iterations,
+      [&]() {
+        for (unsigned id = 0u ; id < count ; ++id) {
+          out[id] = pack(lhs[id].brighten(1.3f));
+        }
+      }
+    );
+
+    measure(results, "color_brighten_span_4096", iterations,
+      [&]() {
+        Color::brightenSpan(lhs.data(), 1.3f, out.data(), count);
+      }
+    );
+
+    measure(results, "color_blend_scalar_4096", iterations,
+      [&]() {
+        for (unsigned id = 0u ; id < count ; ++id) {
+          out[id] = pack(lhs[id].blend(rhs[id], 0.4f));
+        }
+      }
+    );
+
+    measure(results, "color_blend_span_4096", iterations,
+      [&]() {
+        Color::blendSpan(lhs.data(), rhs.data(), 0.4f, out.data(), count);
+      }
+    );
+  }
+
+  /**
+   * @brief - Measures the merging of paint events, both directly and when
+   *          they are posted to an object which already has a pending repaint.
+   *          The merging of many events into a single one is also measured.
+   */
+  void
+  benchPaintEvents(std::vector<Result>& results,
+                   unsigned iterations)
+  {
+    measure(results, "paint_event_merge", iterations,
+      [&]() {
+        PaintEvent merged(sdl::utils::Boxf(10.0f, 10.0f, 20.0f, 20.0f));
+        for (unsigned id = 0u ; id < 16u ; ++id) {
+          const float offset = 30.0f * id;
+          merged.merge(PaintEvent(sdl::utils::Boxf(offset, offset, 20.0f, 20.0f)));
+        }
+      }
+    );
+
+    // Regions do not overlap so that they are kept individually until the
+    // cap of the regions set is reached.
+    std::vector<std::shared_ptr<PaintEvent>> events;
+    for (unsigned id = 0u ; id < 10000u ; ++id) {
+      events.push_back(std::make_shared<PaintEvent>(sdl::utils::Boxf(20.0f * (id % 100u), 20.0f * (id / 100u), 10.0f, 10.0f)));
+    }
+
+    measure(results, "paint_event_merge_10k", std::max(1u, iterations / 10u),
+      [&]() {
+        PaintEvent merged(sdl::utils::Boxf(-10.0f, -10.0f, 5.0f, 5.0f));
+        for (std::vector<std::shared_ptr<PaintEvent>>::const_iterator event = events.cbegin() ;
+             event != events.cend() ;
+             ++event)
+        {
+          merged.merge(**event);
+        }
+      }
+    );
+
+    EngineObject object(std::string("bench_object"), false);
+
+    measure(results, "post_local_event_16", iterations,
+      [&]() {
+        for (unsigned id = 0u ; id < 16u ; ++id) {
+          const float offset = 30.0f * id;
+          object.postLocalEvent(std::make_shared<PaintEvent>(sdl::utils::Boxf(offset, offset, 20.0f, 20.0f), update::Frame::Global, &object));
+        }
+
+        object.processEvents(EventProcessingPass::Visibility);
+        object.processEvents(EventProcessingPass::Rest);
+      }
+    );
+  }
+
+}
+
+/**
+ * @brief - Replacement of the global allocation functions counting the calls
+ *          so that the benchmarks can report allocations along with timings.
+ *          The other forms of `operator new` rely on this one.
+ */
+void*
+operator new(std::size_t size) {
+  g_allocations.fetch_add(1u, std::memory_order_relaxed);
+
+  void* ptr = std::malloc(size == 0u ? 1u : size);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+
+  return ptr;
+}
+
+void
+operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void
+operator delete(void* ptr, std::size_t /*size*/) noexcept {
+  std::free(ptr);
+}
+
+/**
+ * @brief - Measures the hot paths of the engine without any display: the
+ *          engine renders offscreen and the SDL uses its dummy video driver
+ *          so the results are comparable between machines and can be used
+ *          in continuous integration.
+ *          The measurements, along with the number of allocations made by
+ *          each path, are printed and written as json in the output
+ *          file, if any. Text rendering is only measured when a font is
+ *          provided.
+ *          Usage: sdl_engine_bench [--output <file>] [--font <ttf>] [--iterations <count>]
+ */
+int
+main(int argc, char** argv) {
+  std::string output;
+  std::string font;
+  unsigned iterations = 1000u;
+
+  for (int id = 1 ; id < argc ; ++id) {
+    const std::string arg(argv[id]);
+
+    if (arg == "--output" && id + 1 < argc) {
+      output = argv[++id];
+    }
+    else if (arg == "--font" && id + 1 < argc) {
+      font = argv[++id];
+    }
+    else if (arg == "--iterations" && id + 1 < argc) {
+      iterations = static_cast<unsigned>(std::strtoul(argv[++id], nullptr, 10));
+    }
+    else {
+      std::cerr << "Usage: " << argv[0] << " [--output <file>] [--font <ttf>] [--iterations <count>]" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (iterations == 0u) {
+    std::cerr << "Invalid number of iterations" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Keep the driver requested by the user if any.
+  setenv("SDL_VIDEODRIVER", "dummy", 0);
+
+  std::vector<Result> results;
+
+  try {
+    // Images used by the benchmarks are created in a temporary directory.
+    const std::filesystem::path data = std::filesystem::temp_directory_path() / "sdl_engine_bench";
+    std::filesystem::create_directories(data);
+
+    std::shared_ptr<SdlEngine> engine = std::make_shared<SdlEngine>(RenderBackend::Offscreen);
+    const sdl::utils::Uuid win = engine->createWindow(sdl::utils::Sizei(640, 480), false, std::string("bench"));
+
+    // The paths working directly on the SDL use their own software renderer.
+    SDL_Surface* target = SDL_CreateRGBSurface(0, 640, 480, 32, 0x00FF0000, 0x0000FF00, 0x000000FF, 0xFF000000);
+    SDL_Renderer* renderer = (target == nullptr ? nullptr : SDL_CreateSoftwareRenderer(target));
+    if (renderer == nullptr) {
+      std::cerr << "Could not create software renderer: " << SDL_GetError() << std::endl;
+      SDL_FreeSurface(target);
+      return EXIT_FAILURE;
+    }
+
+    benchPollEvents(results, *engine, iterations);
+    benchDispatcher(results, engine, iterations);
+    benchRoutedDispatcher(results, engine, iterations);
+    benchTextures(results, *engine, win, iterations);
+    benchSurfaceUpload(results, renderer, iterations);
+    benchGradient(results, renderer, iterations);
+    benchBrush4K(results, renderer, iterations);
+    benchPixelGradients(results, renderer, iterations);
+    benchTiledReplay(results, renderer, iterations);
+    benchShapes(results, renderer, iterations);
+    benchPaintEvents(results, iterations);
+    benchColorSpans(results, iterations);
+    benchImageCache(results, data.string(), iterations);
+    benchBitmapLoader(results, data.string(), iterations);
+    benchTextureBundle(results, data.string(), iterations);
+
+    if (!font.empty()) {
+      const bool init = !TTF_WasInit();
+      if (init && TTF_Init() == -1) {
+        std::cerr << "Could not initialize fonts: " << TTF_GetError() << std::endl;
+      }
+      else {
+        benchFonts(results, font, iterations);
+
+        if (init) {
+          TTF_Quit();
+        }
+      }
+    }
+
+    SDL_DestroyRenderer(renderer);
+    SDL_FreeSurface(target);
+
+    engine->destroyWindow(win);
+
+    std::filesystem::remove_all(data);
+  }
+  catch (const std::exception& e) {
+    std::cerr << "Could not run benchmarks: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (!output.empty()) {
+    std::ofstream out(output);
+    if (!out.is_open()) {
+      std::cerr << "Could not write results to \"" << output << "\"" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    writeJson(out, results);
+  }
+
+  return EXIT_SUCCESS;
+}
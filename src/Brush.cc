@@ -1,6 +1,279 @@
 
 # include "Brush.hh"
+# include <cmath>
+# include <thread>
+# include <cstdint>
+# include <vector>
+# include <limits>
+# include <cstring>
+# include <algorithm>
 # include "SurfaceTexture.hh"
+# include "Executor.hh"
+
+namespace {
+
+  /**
+   * @brief - Retrieves the pool of threads shared by all the brushes to draw
+   *          large canvases. It is created the first time it is needed.
+   * @return - the executor to use to draw canvases.
+   */
+  sdl::core::engine::Executor&
+  getRasterizer() {
+    static sdl::core::engine::Executor executor(
+      std::max(1u, std::thread::hardware_concurrency()) - 1u,
+      std::string("brush_rasterizer")
+    );
+
+    return executor;
+  }
+
+  /**
+   * @brief - The initial value of the FNV-1a hash.
+   */
+  constexpr std::uint64_t sk_fnvOffset = 14695981039346656037ull;
+
+  /**
+   * @brief - The prime used to combine bytes in the FNV-1a hash.
+   */
+  constexpr std::uint64_t sk_fnvPrime = 1099511628211ull;
+
+  /**
+   * @brief - Combines the input data into the hash using the FNV-1a algorithm.
+   * @param hash - the current value of the hash.
+   * @param data - the data to combine.
+   * @param size - the size of the data in bytes.
+   * @return - the updated hash.
+   */
+  std::uint64_t
+  fnv1a(std::uint64_t hash,
+        const void* data,
+        std::size_t size) noexcept
+  {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+
+    for (std::size_t id = 0u ; id < size ; ++id) {
+      hash ^= bytes[id];
+      hash *= sk_fnvPrime;
+    }
+
+    return hash;
+  }
+
+  /**
+   * @brief - Convenience wrapper to combine a value into the hash.
+   * @param hash - the current value of the hash.
+   * @param value - the value to combine.
+   * @return - the updated hash.
+   */
+  template <typename T>
+  std::uint64_t
+  fnv1a(std::uint64_t hash,
+        const T& value) noexcept
+  {
+    return fnv1a(hash, &value, sizeof(T));
+  }
+
+  /**
+   * @brief - Converts a signed distance to the edge of a shape into the coverage
+   *          of a pixel: pixels further than half a pixel inside the shape are
+   *          fully covered and pixels further than half a pixel outside are not
+   *          covered at all.
+   * @param distance - the signed distance, negative inside the shape.
+   * @return - the coverage of the pixel in the range `[0; 1]`.
+   */
+  inline
+  float
+  coverageOf(float distance) noexcept {
+    return std::min(std::max(0.5f - distance, 0.0f), 1.0f);
+  }
+
+  /**
+   * @brief - Computes the coverage of a span of pixels by a segment with round
+   *          caps. The inner loop has no branch so that it can be vectorized.
+   * @param g - the geometry of the segment: its ends and half width.
+   * @param px - the abscissa of the center of the first pixel.
+   * @param py - the ordinate of the center of the pixels.
+   * @param count - the number of pixels in the span.
+   * @param out - the output coverage of each pixel.
+   */
+  void
+  coverSegment(const float* g,
+               float px,
+               float py,
+               unsigned count,
+               float* out) noexcept
+  {
+    const float dx = g[2] - g[0];
+    const float dy = g[3] - g[1];
+    const float len2 = dx * dx + dy * dy;
+    const float inv = (len2 > 0.0f ? 1.0f / len2 : 0.0f);
+
+    const float qy = py - g[1];
+
+    for (unsigned id = 0u ; id < count ; ++id) {
+      const float qx = px + id - g[0];
+      const float t = std::min(std::max((qx * dx + qy * dy) * inv, 0.0f), 1.0f);
+
+      const float ex = qx - t * dx;
+      const float ey = qy - t * dy;
+
+      out[id] = coverageOf(std::sqrt(ex * ex + ey * ey) - g[4]);
+    }
+  }
+
+  /**
+   * @brief - Computes the coverage of a span of pixels by an ellipse. The distance
+   *          to the ellipse is approximated from the implicit equation scaled by its
+   *          gradient which is accurate close to the edge.
+   * @param g - the geometry of the ellipse: its center and radii.
+   * @param px - the abscissa of the center of the first pixel.
+   * @param py - the ordinate of the center of the pixels.
+   * @param count - the number of pixels in the span.
+   * @param out - the output coverage of each pixel.
+   */
+  void
+  coverEllipse(const float* g,
+               float px,
+               float py,
+               unsigned count,
+               float* out) noexcept
+  {
+    const float irx = 1.0f / g[2];
+    const float iry = 1.0f / g[3];
+    const float rmin = std::min(g[2], g[3]);
+
+    const float y = (py - g[1]) * iry;
+    const float y2 = y * y;
+    const float yr2 = y2 * iry * iry;
+
+    for (unsigned id = 0u ; id < count ; ++id) {
+      const float x = (px + id - g[0]) * irx;
+
+      const float k0 = std::sqrt(x * x + y2);
+      const float k1 = std::sqrt(x * x * irx * irx + yr2);
+      const float ratio = (k1 > 1e-6f ? k0 / k1 : rmin);
+
+      out[id] = coverageOf((k0 - 1.0f) * ratio);
+    }
+  }
+
+  /**
+   * @brief - Computes the coverage of a span of pixels by a rectangle with rounded
+   *          corners.
+   * @param g - the geometry of the rectangle: its center, half dimensions and the
+   *            radius of its corners.
+   * @param px - the abscissa of the center of the first pixel.
+   * @param py - the ordinate of the center of the pixels.
+   * @param count - the number of pixels in the span.
+   * @param out - the output coverage of each pixel.
+   */
+  void
+  coverRoundedRect(const float* g,
+                   float px,
+                   float py,
+                   unsigned count,
+                   float* out) noexcept
+  {
+    const float r = g[4];
+    const float qy = std::fabs(py - g[1]) - g[3] + r;
+    const float oy = std::max(qy, 0.0f);
+
+    for (unsigned id = 0u ; id < count ; ++id) {
+      const float qx = std::fabs(px + id - g[0]) - g[2] + r;
+      const float ox = std::max(qx, 0.0f);
+
+      const float d = std::sqrt(ox * ox + oy * oy) + std::min(std::max(qx, qy), 0.0f) - r;
+
+      out[id] = coverageOf(d);
+    }
+  }
+
+  /**
+   * @brief - Computes the coverage of a span of pixels by a polygon using the
+   *          even-odd rule. Each edge is processed for the whole span at once so
+   *          that the inner loops can be vectorized.
+   * @param g - the vertices of the polygon.
+   * @param vertices - the number of vertices of the polygon.
+   * @param px - the abscissa of the center of the first pixel.
+   * @param py - the ordinate of the center of the pixels.
+   * @param count - the number of pixels in the span.
+   * @param out - the output coverage of each pixel.
+   * @param distances - a buffer of `count` values used to store the squared
+   *                    distance of each pixel to the closest edge.
+   */
+  void
+  coverPolygon(const float* g,
+               unsigned vertices,
+               float px,
+               float py,
+               unsigned count,
+               float* out,
+               float* distances) noexcept
+  {
+    // `out` holds the sign of the distance until the end: positive outside
+    // of the polygon and negative inside.
+    for (unsigned id = 0u ; id < count ; ++id) {
+      out[id] = 1.0f;
+      distances[id] = std::numeric_limits<float>::max();
+    }
+
+    for (unsigned edge = 0u ; edge < vertices ; ++edge) {
+      const unsigned next = (edge + 1u) % vertices;
+
+      const float ax = g[2u * edge];
+      const float ay = g[2u * edge + 1u];
+      const float dx = g[2u * next] - ax;
+      const float dy = g[2u * next + 1u] - ay;
+
+      const float len2 = dx * dx + dy * dy;
+      const float inv = (len2 > 0.0f ? 1.0f / len2 : 0.0f);
+      const float qy = py - ay;
+
+      for (unsigned id = 0u ; id < count ; ++id) {
+        const float qx = px + id - ax;
+        const float t = std::min(std::max((qx * dx + qy * dy) * inv, 0.0f), 1.0f);
+
+        const float ex = qx - t * dx;
+        const float ey = qy - t * dy;
+
+        distances[id] = std::min(distances[id], ex * ex + ey * ey);
+      }
+
+      // Pixels on the left of the crossing between the edge and the row
+      // toggle their inside status.
+      if ((ay > py) != (ay + dy > py)) {
+        const float cross = ax + qy * dx / dy;
+
+        for (unsigned id = 0u ; id < count ; ++id) {
+          out[id] = (px + id < cross ? -out[id] : out[id]);
+        }
+      }
+    }
+
+    for (unsigned id = 0u ; id < count ; ++id) {
+      out[id] = coverageOf(std::sqrt(distances[id]) * out[id]);
+    }
+  }
+
+  /**
+   * @brief - Blends a channel of the source color over the destination with the
+   *          specified opacity, rounding to the closest value.
+   * @param src - the source channel.
+   * @param dst - the destination channel.
+   * @param alpha - the opacity of the source in the range `[0; 255]`.
+   * @return - the blended channel.
+   */
+  inline
+  Uint32
+  blendChannel(Uint32 src,
+               Uint32 dst,
+               Uint32 alpha) noexcept
+  {
+    const Uint32 v = src * alpha + dst * (255u - alpha) + 128u;
+    return (v + (v >> 8)) >> 8;
+  }
+
+}
 
 namespace sdl {
   namespace core {
@@ -15,7 +288,13 @@ namespace sdl {
 
         m_canvas(nullptr),
         m_rawData(nullptr),
-        m_ownsCanvas(ownsTexture)
+        m_ownsCanvas(ownsTexture),
+
+        m_commands(),
+
+        m_cacheable(false),
+        m_hash(sk_fnvOffset),
+        m_history()
       {
         setService("brush");
       }
@@ -31,6 +310,16 @@ namespace sdl {
       void
       Brush::createFromRaw(const utils::Sizei& dims,
                            std::vector<Color>& colors)
+      {
+        std::vector<PackedColor> packed(colors.cbegin(), colors.cend());
+        colors.clear();
+
+        createFromRaw(dims, packed);
+      }
+
+      void
+      Brush::createFromRaw(const utils::Sizei& dims,
+                           std::vector<PackedColor>& colors)
       {
         // Erase any existing canvas.
         destroy();
@@ -60,16 +349,20 @@ namespace sdl {
           );
         }
 
-        // Create the surface to draw.
-        int w = m_canvas->w, h = m_canvas->h;
+        // Compute the area covered by the line.
+        SDL_Rect dst{0, 0, m_canvas->w, m_canvas->h};
+
         switch (dir) {
           case Direction::Horizontal:
-            w = m_canvas->w;
-            h = 1;
+            // Account for a `-1` as the `y` axis is inverted and the rows of the
+            // surface range from `[0 ; m_canvas->h - 1]` and not `[1; m_canvas->h]`.
+            dst.y = static_cast<int>(m_canvas->h / 2.0f - coord) - 1;
+            dst.h = 1;
             break;
           case Direction::Vertical:
-            w = 1;
-            h = m_canvas->h;
+            // This is not needed here because the `x` axis is not inverted.
+            dst.x = static_cast<int>(coord + m_canvas->w / 2.0f);
+            dst.w = 1;
             break;
           default:
             error(
@@ -79,67 +372,653 @@ namespace sdl {
             break;
         }
 
-        SDL_Surface* line = SDL_CreateRGBSurface(0, w, h, 32, 0, 0, 0, 0);
-        if (line == nullptr) {
+        // Clip the line to the canvas: lines outside of it are just ignored.
+        const SDL_Rect canvas{0, 0, m_canvas->w, m_canvas->h};
+        SDL_Rect area;
+
+        if (!SDL_IntersectRect(&dst, &canvas, &area)) {
+          return;
+        }
+
+        SDL_Color c = m_color.toSDLColor();
+        record(
+          Command{
+            Command::Type::Fill,
+            area,
+            SDL_MapRGBA(m_canvas->format, c.r, c.g, c.b, c.a),
+            nullptr,
+            std::vector<float>()
+          }
+        );
+      }
+
+      void
+      Brush::drawGradient(const Gradient& grad) {
+        // Check consistency.
+        if (!hasCanvas()) {
           error(
-            std::string("Cannot draw line at ") + std::to_string(coord),
-            SDL_GetError()
+            std::string("Cannot draw gradient ") + grad.getName(),
+            std::string("No active canvas")
           );
         }
 
-        // Fill the surface with the adequate color.
-        SDL_Color c = m_color.toSDLColor();
-        SDL_FillRect(line, nullptr, SDL_MapRGBA(m_canvas->format, c.r, c.g, c.b, c.a));
+        // Keep a copy of the gradient: the caller is free to modify it before
+        // the canvas is actually drawn.
+        record(
+          Command{
+            Command::Type::Gradient,
+            SDL_Rect{0, 0, m_canvas->w, m_canvas->h},
+            0u,
+            grad.clone(),
+            std::vector<float>()
+          }
+        );
+      }
 
-        // Display the line at the correct coordinates.
-        int x, y;
-        switch (dir) {
-          case Direction::Horizontal:
-            x = 0;
-            // Account for a `-1` as the `y` axis is inverted and the rows of the
-            // surface range from `[0 ; m_canvas->h - 1]` and not `[1; m_canvas->h]`.
-            y = static_cast<int>(m_canvas->h / 2.0f - coord) - 1;
-            break;
-          case Direction::Vertical:
-          default:
-            // This is not needed here because the `x` axis is not inverted.
-            x = static_cast<int>(coord + m_canvas->w / 2.0f);
-            y = 0;
-            break;
+      void
+      Brush::drawSegment(const utils::Vector2f& from,
+                         const utils::Vector2f& to,
+                         float width)
+      {
+        // Check consistency.
+        if (!hasCanvas()) {
+          error(
+            std::string("Cannot draw segment from ") + from.toString() + " to " + to.toString(),
+            std::string("No active canvas")
+          );
         }
-        SDL_Rect dst{x, y, w, h};
 
-        SDL_BlitSurface(line, nullptr, m_canvas, &dst);
+        // Convert the ends of the segment to pixels: the `y` axis of the canvas
+        // goes downwards.
+        const float cx = m_canvas->w / 2.0f;
+        const float cy = m_canvas->h / 2.0f;
 
-        // Release resources.
-        SDL_FreeSurface(line);
+        const float ax = cx + from.x();
+        const float ay = cy - from.y();
+        const float bx = cx + to.x();
+        const float by = cy - to.y();
+        const float hw = std::max(width, 0.0f) / 2.0f;
+
+        recordShape(
+          Command::Type::Segment,
+          std::min(ax, bx) - hw,
+          std::min(ay, by) - hw,
+          std::max(ax, bx) + hw,
+          std::max(ay, by) + hw,
+          std::vector<float>{ax, ay, bx, by, hw}
+        );
       }
 
       void
-      Brush::drawGradient(const Gradient& grad) {
+      Brush::fillEllipse(const utils::Vector2f& center,
+                         const utils::Sizef& radii)
+      {
         // Check consistency.
         if (!hasCanvas()) {
           error(
-            std::string("Cannot draw gradient ") + grad.getName(),
+            std::string("Cannot fill ellipse at ") + center.toString(),
+            std::string("No active canvas")
+          );
+        }
+
+        const float rx = std::fabs(radii.w());
+        const float ry = std::fabs(radii.h());
+
+        if (rx <= 0.0f || ry <= 0.0f) {
+          return;
+        }
+
+        const float x = m_canvas->w / 2.0f + center.x();
+        const float y = m_canvas->h / 2.0f - center.y();
+
+        recordShape(
+          Command::Type::Ellipse,
+          x - rx,
+          y - ry,
+          x + rx,
+          y + ry,
+          std::vector<float>{x, y, rx, ry}
+        );
+      }
+
+      void
+      Brush::fillRoundedRect(const utils::Boxf& area,
+                             float radius)
+      {
+        // Check consistency.
+        if (!hasCanvas()) {
+          error(
+            std::string("Cannot fill rounded rectangle ") + area.toString(),
             std::string("No active canvas")
           );
         }
 
-        // Sample the gradient with as many samples as the width of
-        // the canvas.
-        for (int id = 0 ; id < m_canvas->w ; ++id) {
-          float perc = 1.0f * id / m_canvas->w;
-          float coord = 1.0f * id - m_canvas->w / 2.0f;
+        const float hw = std::fabs(area.w()) / 2.0f;
+        const float hh = std::fabs(area.h()) / 2.0f;
+        const float r = std::min(std::max(radius, 0.0f), std::min(hw, hh));
+
+        const float x = m_canvas->w / 2.0f + area.x();
+        const float y = m_canvas->h / 2.0f - area.y();
 
-          setColor(grad.getColorAt(perc));
-          drawLine(Direction::Vertical, coord);
+        recordShape(
+          Command::Type::RoundedRect,
+          x - hw,
+          y - hh,
+          x + hw,
+          y + hh,
+          std::vector<float>{x, y, hw, hh, r}
+        );
+      }
+
+      void
+      Brush::fillPolygon(const std::vector<utils::Vector2f>& points) {
+        // Check consistency.
+        if (!hasCanvas()) {
+          error(
+            std::string("Cannot fill polygon with ") + std::to_string(points.size()) + " point(s)",
+            std::string("No active canvas")
+          );
         }
+
+        if (points.size() < 3u) {
+          return;
+        }
+
+        const float cx = m_canvas->w / 2.0f;
+        const float cy = m_canvas->h / 2.0f;
+
+        std::vector<float> geometry(2u * points.size());
+
+        float left = cx + points[0].x();
+        float right = left;
+        float top = cy - points[0].y();
+        float bottom = top;
+
+        for (unsigned id = 0u ; id < points.size() ; ++id) {
+          const float x = cx + points[id].x();
+          const float y = cy - points[id].y();
+
+          geometry[2u * id] = x;
+          geometry[2u * id + 1u] = y;
+
+          left = std::min(left, x);
+          right = std::max(right, x);
+          top = std::min(top, y);
+          bottom = std::max(bottom, y);
+        }
+
+        recordShape(Command::Type::Polygon, left, top, right, bottom, std::move(geometry));
+      }
+
+      void
+      Brush::record(const Command& cmd) {
+        // Fills and gradients covering the whole canvas hide everything drawn
+        // before. This is not the case of shapes which are blended.
+        const bool opaque = (cmd.type == Command::Type::Fill || cmd.type == Command::Type::Gradient);
+        const bool full = (cmd.area.x == 0 && cmd.area.y == 0 && cmd.area.w == m_canvas->w && cmd.area.h == m_canvas->h);
+
+        if (opaque && full) {
+          m_commands.clear();
+          resetHash();
+        }
+
+        m_commands.push_back(cmd);
+
+        // Update the hash of the content of the canvas.
+        m_history.push_back(cmd);
+        m_hash = fnv1a(m_hash, cmd.type);
+
+        switch (cmd.type) {
+          case Command::Type::Fill:
+            m_hash = fnv1a(m_hash, cmd.area);
+            m_hash = fnv1a(m_hash, cmd.color);
+            break;
+          case Command::Type::Gradient: {
+            m_hash = fnv1a(m_hash, cmd.gradient->getMode());
+            m_hash = fnv1a(m_hash, cmd.gradient->getAngle());
+
+            const gradient::Stops stops = cmd.gradient->getStops();
+            for (unsigned id = 0u ; id < stops.size() ; ++id) {
+              const float stop[5] = {
+                stops[id].first,
+                stops[id].second.r(),
+                stops[id].second.g(),
+                stops[id].second.b(),
+                stops[id].second.a()
+              };
+
+              m_hash = fnv1a(m_hash, stop);
+            }
+            break;
+          }
+          default:
+            m_hash = fnv1a(m_hash, cmd.area);
+            m_hash = fnv1a(m_hash, cmd.color);
+            m_hash = fnv1a(m_hash, cmd.geometry.data(), cmd.geometry.size() * sizeof(float));
+            break;
+        }
+      }
+
+      void
+      Brush::resetHash() noexcept {
+        m_hash = fnv1a(sk_fnvOffset, m_canvas->w);
+        m_hash = fnv1a(m_hash, m_canvas->h);
+        m_history.clear();
+      }
+
+      bool
+      Brush::hasContent(const Content& content) const noexcept {
+        if (!hasCanvas() || m_canvas->w != content.w || m_canvas->h != content.h) {
+          return false;
+        }
+
+        if (m_history.size() != content.commands.size()) {
+          return false;
+        }
+
+        for (unsigned id = 0u ; id < m_history.size() ; ++id) {
+          if (!equals(m_history[id], content.commands[id])) {
+            return false;
+          }
+        }
+
+        return true;
+      }
+
+      void
+      Brush::recordShape(const Command::Type& type,
+                         float left,
+                         float top,
+                         float right,
+                         float bottom,
+                         std::vector<float> geometry)
+      {
+        // Include the pixels partially covered by the edges of the shape and
+        // clip the result to the canvas.
+        const float x0 = std::max(std::floor(left) - 1.0f, 0.0f);
+        const float y0 = std::max(std::floor(top) - 1.0f, 0.0f);
+        const float x1 = std::min(std::ceil(right) + 1.0f, static_cast<float>(m_canvas->w));
+        const float y1 = std::min(std::ceil(bottom) + 1.0f, static_cast<float>(m_canvas->h));
+
+        if (!(x0 < x1) || !(y0 < y1)) {
+          return;
+        }
+
+        const SDL_Rect area{
+          static_cast<int>(x0),
+          static_cast<int>(y0),
+          static_cast<int>(x1 - x0),
+          static_cast<int>(y1 - y0)
+        };
+
+        record(
+          Command{
+            type,
+            area,
+            PackedColor(m_color).value(),
+            nullptr,
+            std::move(geometry)
+          }
+        );
+      }
+
+      void
+      Brush::replay() {
+        if (!hasCanvas() || m_commands.empty()) {
+          return;
+        }
+
+        const int w = m_canvas->w;
+        const int h = m_canvas->h;
+
+        if (SDL_MUSTLOCK(m_canvas)) {
+          SDL_LockSurface(m_canvas);
+        }
+
+        // Small canvases are not worth the synchronization: draw them as a
+        // single tile. Otherwise each tile is drawn by a distinct task. As
+        // tiles do not overlap no synchronization is needed between tasks.
+        Executor& executor = getRasterizer();
+
+        if (w * h < sk_parallelPixels || executor.getWorkersCount() == 0u) {
+          replayTile(SDL_Rect{0, 0, w, h});
+        }
+        else {
+          std::vector<Executor::Task> tasks;
+
+          for (int y = 0 ; y < h ; y += sk_tileSize) {
+            for (int x = 0 ; x < w ; x += sk_tileSize) {
+              const SDL_Rect tile{x, y, std::min(sk_tileSize, w - x), std::min(sk_tileSize, h - y)};
+
+              tasks.push_back(
+                [this, tile]() {
+                  replayTile(tile);
+                }
+              );
+            }
+          }
+
+          executor.run(tasks);
+        }
+
+        if (SDL_MUSTLOCK(m_canvas)) {
+          SDL_UnlockSurface(m_canvas);
+        }
+
+        m_commands.clear();
+      }
+
+      void
+      Brush::replayTile(const SDL_Rect& tile) const {
+        for (unsigned id = 0u ; id < m_commands.size() ; ++id) {
+          const Command& cmd = m_commands[id];
+
+          switch (cmd.type) {
+            case Command::Type::Fill: {
+              SDL_Rect area;
+              if (SDL_IntersectRect(&cmd.area, &tile, &area)) {
+                fill(area, cmd.color);
+              }
+              break;
+            }
+            case Command::Type::Gradient:
+              rasterizeGradient(*cmd.gradient, tile);
+              break;
+            default:
+              rasterizeShape(cmd, tile);
+              break;
+          }
+        }
+      }
+
+      bool
+      Brush::equals(const Command& lhs,
+                    const Command& rhs) noexcept
+      {
+        if (lhs.type != rhs.type) {
+          return false;
+        }
+
+        // Gradients cover the whole canvas: only the gradient matters.
+        if (lhs.type == Command::Type::Gradient) {
+          if (lhs.gradient == rhs.gradient) {
+            return true;
+          }
+
+          return
+            lhs.gradient != nullptr && rhs.gradient != nullptr &&
+            lhs.gradient->getMode() == rhs.gradient->getMode() &&
+            lhs.gradient->getAngle() == rhs.gradient->getAngle() &&
+            lhs.gradient->getStops() == rhs.gradient->getStops()
+          ;
+        }
+
+        return
+          lhs.area.x == rhs.area.x &&
+          lhs.area.y == rhs.area.y &&
+          lhs.area.w == rhs.area.w &&
+          lhs.area.h == rhs.area.h &&
+          lhs.color == rhs.color &&
+          lhs.geometry == rhs.geometry
+        ;
+      }
+
+      void
+      Brush::fill(const SDL_Rect& area,
+                  Uint32 color) const
+      {
+        // `SDL_FillRect` would lock the surface again: handle the common
+        // case of 32 bits pixels directly.
+        if (m_canvas->format->BytesPerPixel != sizeof(Uint32)) {
+          SDL_Rect dst = area;
+          SDL_FillRect(m_canvas, &dst, color);
+          return;
+        }
+
+        for (int y = area.y ; y < area.y + area.h ; ++y) {
+          Uint8* row = static_cast<Uint8*>(m_canvas->pixels) + static_cast<std::size_t>(y) * m_canvas->pitch;
+          std::fill_n(reinterpret_cast<Uint32*>(row) + area.x, area.w, color);
+        }
+      }
+
+      void
+      Brush::rasterizeGradient(const Gradient& grad,
+                               const SDL_Rect& tile) const
+      {
+        const int w = m_canvas->w;
+        const int h = m_canvas->h;
+
+        const float cx = w / 2.0f;
+        const float cy = h / 2.0f;
+
+        std::vector<Uint32> row(tile.w);
+
+        // Note that the colors are computed from the position of each pixel in
+        // the canvas and never accumulated along a row: this guarantees that a
+        // pixel gets the same color no matter how the canvas is split in tiles.
+        const gradient::Mode mode = grad.getMode();
+        const float angle = grad.getAngle();
+
+        // Horizontal linear gradients use the same color for each column: we
+        // only need to compute a single row and copy it on each row.
+        if (mode == gradient::Mode::Linear && angle == 0.0f) {
+          grad.fillSpan(0.0f, 1.0f / w, row.data(), tile.w, tile.x);
+
+          for (int y = tile.y ; y < tile.y + tile.h ; ++y) {
+            writeRow(tile.x, y, tile.w, row.data());
+          }
+
+          return;
+        }
+
+        // Radial gradients: the coordinate is the distance to the center of the
+        // canvas, normalized so that the corners of the canvas are at `1`.
+        if (mode == gradient::Mode::Radiant) {
+          const float radius = std::sqrt(cx * cx + cy * cy);
+          const float scale = (radius > 0.0f ? 1.0f / radius : 0.0f);
+
+          for (int y = tile.y ; y < tile.y + tile.h ; ++y) {
+            grad.fillRadialSpan(tile.x - cx, y - cy, scale, row.data(), tile.w);
+            writeRow(tile.x, y, tile.w, row.data());
+          }
+
+          return;
+        }
+
+        // Linear gradients: the coordinate is the projection of the pixel on the
+        // direction of the gradient, normalized by the extent of the canvas along
+        // this direction. Note that the rows of the canvas go downwards while the
+        // angle is expressed with an upward `y` axis.
+        const float theta = angle * 3.14159265358979f / 180.0f;
+        const float cosT = std::cos(theta);
+        const float sinT = std::sin(theta);
+
+        const float extent = std::fabs(w * cosT) + std::fabs(h * sinT);
+        const float scale = (extent > 0.0f ? 1.0f / extent : 0.0f);
+
+        for (int y = tile.y ; y < tile.y + tile.h ; ++y) {
+          const float start = (-cx * cosT - (y - cy) * sinT) * scale + 0.5f;
+
+          grad.fillSpan(start, cosT * scale, row.data(), tile.w, tile.x);
+          writeRow(tile.x, y, tile.w, row.data());
+        }
+      }
+
+      void
+      Brush::rasterizeShape(const Command& cmd,
+                            const SDL_Rect& tile) const
+      {
+        SDL_Rect area;
+        if (!SDL_IntersectRect(&cmd.area, &tile, &area)) {
+          return;
+        }
+
+        std::vector<float> coverage(area.w);
+        std::vector<float> distances(cmd.type == Command::Type::Polygon ? area.w : 0);
+
+        const float* g = cmd.geometry.data();
+        const unsigned count = static_cast<unsigned>(area.w);
+
+        // Coverage is evaluated at the center of each pixel.
+        const float px = area.x + 0.5f;
+
+        for (int y = area.y ; y < area.y + area.h ; ++y) {
+          const float py = y + 0.5f;
+
+          switch (cmd.type) {
+            case Command::Type::Segment:
+              coverSegment(g, px, py, count, coverage.data());
+              break;
+            case Command::Type::Ellipse:
+              coverEllipse(g, px, py, count, coverage.data());
+              break;
+            case Command::Type::RoundedRect:
+              coverRoundedRect(g, px, py, count, coverage.data());
+              break;
+            case Command::Type::Polygon:
+              coverPolygon(g, cmd.geometry.size() / 2u, px, py, count, coverage.data(), distances.data());
+              break;
+            default:
+              return;
+          }
+
+          blendRow(area.x, y, area.w, coverage.data(), cmd.color);
+        }
+      }
+
+      void
+      Brush::blendRow(int x,
+                      int y,
+                      int count,
+                      const float* coverage,
+                      Uint32 argb) const
+      {
+        // Only 32 bits canvases are supported, which is what `create` builds.
+        if (m_canvas->format->BytesPerPixel != sizeof(Uint32)) {
+          return;
+        }
+
+        Uint8* pixels = static_cast<Uint8*>(m_canvas->pixels) + static_cast<std::size_t>(y) * m_canvas->pitch;
+        Uint32* dst = reinterpret_cast<Uint32*>(pixels) + x;
+
+        const float alpha = static_cast<float>(argb >> 24);
+        const Uint32 sr = (argb >> 16) & 0xFFu;
+        const Uint32 sg = (argb >> 8) & 0xFFu;
+        const Uint32 sb = argb & 0xFFu;
+
+        // The default canvas format stores the channels at the same position as
+        // the color: we can blend the pixels directly.
+        const Uint32 format = m_canvas->format->format;
+        if (format == SDL_PIXELFORMAT_ARGB8888 || format == SDL_PIXELFORMAT_RGB888) {
+          for (int id = 0 ; id < count ; ++id) {
+            const Uint32 c = static_cast<Uint32>(coverage[id] * alpha + 0.5f);
+            const Uint32 d = dst[id];
+
+            dst[id] =
+              (d & 0xFF000000u) |
+              (blendChannel(sr, (d >> 16) & 0xFFu, c) << 16) |
+              (blendChannel(sg, (d >> 8) & 0xFFu, c) << 8) |
+              blendChannel(sb, d & 0xFFu, c)
+            ;
+          }
+
+          return;
+        }
+
+        // Otherwise convert each pixel.
+        for (int id = 0 ; id < count ; ++id) {
+          const Uint32 c = static_cast<Uint32>(coverage[id] * alpha + 0.5f);
+          if (c == 0u) {
+            continue;
+          }
+
+          Uint8 r, g, b, a;
+          SDL_GetRGBA(dst[id], m_canvas->format, &r, &g, &b, &a);
+
+          dst[id] = SDL_MapRGBA(
+            m_canvas->format,
+            blendChannel(sr, r, c),
+            blendChannel(sg, g, c),
+            blendChannel(sb, b, c),
+            a
+          );
+        }
+      }
+
+      void
+      Brush::writeRow(int x,
+                      int y,
+                      int count,
+                      const Uint32* row) const
+      {
+        Uint8* pixels = static_cast<Uint8*>(m_canvas->pixels) + static_cast<std::size_t>(y) * m_canvas->pitch;
+
+        // The samples are packed in a format compatible with the default canvas:
+        // in this case we can copy the row of colors directly.
+        const Uint32 format = m_canvas->format->format;
+        const bool packed = (format == SDL_PIXELFORMAT_ARGB8888 || format == SDL_PIXELFORMAT_RGB888);
+
+        if (packed) {
+          std::memcpy(reinterpret_cast<Uint32*>(pixels) + x, row, count * sizeof(Uint32));
+          return;
+        }
+
+        // Otherwise convert each pixel.
+        for (int id = 0 ; id < count ; ++id) {
+          const Uint32 c = SDL_MapRGBA(
+            m_canvas->format,
+            (row[id] >> 16) & 0xFFu,
+            (row[id] >> 8) & 0xFFu,
+            row[id] & 0xFFu,
+            (row[id] >> 24) & 0xFFu
+          );
+
+          if (m_canvas->format->BytesPerPixel == sizeof(Uint32)) {
+            reinterpret_cast<Uint32*>(pixels)[x + id] = c;
+          }
+          else {
+            SDL_Rect dst{x + id, y, 1, 1};
+            SDL_FillRect(m_canvas, &dst, c);
+          }
+        }
+      }
+
+      std::shared_ptr<Brush>
+      Brush::snapshot() const {
+        std::shared_ptr<Brush> copy = std::make_shared<Brush>(getName() + "_snapshot", false);
+
+        copy->m_color = m_color;
+        copy->m_clearColor = m_clearColor;
+
+        if (hasCanvas()) {
+          copy->m_canvas = SDL_DuplicateSurface(m_canvas);
+
+          if (copy->m_canvas == nullptr) {
+            error(
+              std::string("Could not create snapshot of canvas"),
+              SDL_GetError()
+            );
+          }
+        }
+
+        // Raw data is never modified once created so it can be shared.
+        copy->m_rawData = m_rawData;
+        copy->m_commands = m_commands;
+
+        copy->m_cacheable = m_cacheable;
+        copy->m_hash = m_hash;
+        copy->m_history = m_history;
+
+        return copy;
       }
 
       TextureShPtr
       Brush::render(SDL_Renderer* renderer) {
         // Check for a valid canvas.
         if (hasCanvas()) {
+          // Apply the pending drawing operations.
+          replay();
+
           // If this brush owns the texture we shouldn't be transferring the
           // ownership to the texture and conversely.
           return std::make_shared<SurfaceTexture>(
@@ -2,12 +2,17 @@
 # define   BRUSH_HH
 
 # include <memory>
+# include <vector>
+# include <cstdint>
 # include <SDL2/SDL.h>
 # include <core_utils/CoreObject.hh>
 # include <maths_utils/Size.hh>
+# include <maths_utils/Box.hh>
+# include <maths_utils/Vector2.hh>
 # include "Texture.hh"
 # include "Palette.hh"
 # include "Gradient.hh"
+# include "PackedColor.hh"
 # include "SurfaceTexture.hh"
 
 namespace sdl {
@@ -68,6 +73,14 @@ namespace sdl {
           void
           setColor(const Color& color) noexcept;
 
+          /**
+           * @brief - Similar to the above method but the color is provided in its
+           *          packed representation.
+           * @param color - the new drawing color to use.
+           */
+          void
+          setColor(const PackedColor& color) noexcept;
+
           /**
            * @brief - Assign a new clear color to use when clearing the internal
            *          canvas. This color is distinct from the drawing color.
@@ -106,6 +119,19 @@ namespace sdl {
           createFromRaw(const utils::Sizei& dims,
                         std::vector<Color>& colors);
 
+          /**
+           * @brief - Similar to the above method but the colors are provided in
+           *          their packed representation which can be used as is to
+           *          create the surface. The vector is also emptied.
+           * @param dims - the dimensions of the `colors` vector when interpreted
+           *               as a 2D array.
+           * @param colors - the raw data of the surface to associate to the brush,
+           *                 as a 1D array.
+           */
+          void
+          createFromRaw(const utils::Sizei& dims,
+                        std::vector<PackedColor>& colors);
+
           /**
            * @brief - Used to clear the whole canvas if any with the clear color.
            *          Note that nothing happens if the canvas has not been allocated
@@ -131,16 +157,69 @@ namespace sdl {
            * @brief - Used to perform the drawing of the gradient into the internal
            *          brush's canvas. NO allocation is performed meaning that if no
            *          canvas is attached already to the brush an error is raised.
+           *          Linear gradients are drawn along the angle they define while
+           *          radial gradients are centered on the canvas and reach their
+           *          last stop in the corners of the canvas.
+           *          The gradient is copied and drawn when the content of the canvas
+           *          is needed: large canvases are then drawn using several threads.
            * @param grad - the gradient to represent with this brush.
            */
           void
           drawGradient(const Gradient& grad);
 
+          /**
+           * @brief - Draws an anti-aliased segment between the two input points expressed
+           *          in the local brush's canvas coordinate frame, using the current color.
+           *          The segment can have any orientation and has round caps.
+           *          If no canvas is defined an error is raised.
+           * @param from - the first end of the segment.
+           * @param to - the second end of the segment.
+           * @param width - the width of the segment in pixels.
+           */
+          void
+          drawSegment(const utils::Vector2f& from,
+                      const utils::Vector2f& to,
+                      float width = 1.0f);
+
+          /**
+           * @brief - Fills an anti-aliased ellipse centered on the input position with the
+           *          current color. Circles are obtained by using identical radii.
+           *          If no canvas is defined an error is raised.
+           * @param center - the center of the ellipse in the local brush's canvas frame.
+           * @param radii - the radius of the ellipse along each axis.
+           */
+          void
+          fillEllipse(const utils::Vector2f& center,
+                      const utils::Sizef& radii);
+
+          /**
+           * @brief - Fills an anti-aliased rectangle with rounded corners with the current
+           *          color. The radius is clamped to half the smallest dimension of the
+           *          rectangle. If no canvas is defined an error is raised.
+           * @param area - the rectangle to fill in the local brush's canvas frame.
+           * @param radius - the radius of the corners.
+           */
+          void
+          fillRoundedRect(const utils::Boxf& area,
+                          float radius);
+
+          /**
+           * @brief - Fills an anti-aliased polygon with the current color. The polygon is
+           *          closed automatically and uses the even-odd rule for self-intersecting
+           *          outlines. Polygons with less than three points are ignored.
+           *          If no canvas is defined an error is raised.
+           * @param points - the vertices of the polygon in the local brush's canvas frame.
+           */
+          void
+          fillPolygon(const std::vector<utils::Vector2f>& points);
+
           /**
            * @brief - Performs the rendering of the content of this brush using
            *          the provided renderer so that we create a valid texture
            *          from it. Note that the texture is guaranteed to be valid
            *          if the method returns.
+           *          The drawing operations requested so far are applied on the
+           *          canvas before creating the texture.
            *          The created texture is *not* set to take ownership of the
            *          canvas used to create it.
            * @param renderer - the renderer to use to perform the drawing of the
@@ -150,6 +229,94 @@ namespace sdl {
           virtual TextureShPtr
           render(SDL_Renderer* renderer);
 
+          /**
+           * @brief - Creates a copy of this brush holding its current content: the
+           *          canvas and the drawing operations not yet applied to it. The
+           *          copy shares nothing with this brush and can thus be rendered
+           *          by another thread while this brush is still used.
+           *          The texture created from the copy takes ownership of its canvas.
+           * @return - a copy of this brush.
+           */
+          std::shared_ptr<Brush>
+          snapshot() const;
+
+          /**
+           * @brief - Defines whether the textures created from this brush can be shared
+           *          with the ones created from identical brushes. In this case a window
+           *          rendering several brushes with the same content only rasterizes and
+           *          uploads the first one.
+           *          Such textures can't be modified afterwards (filled or used as a
+           *          rendering target) as modifications would be visible to all the users
+           *          of the texture: the window raises an error instead.
+           *          The default is `false`.
+           * @param cacheable - `true` if the textures can be shared.
+           */
+          void
+          setCacheable(bool cacheable) noexcept;
+
+          /**
+           * @brief - Used to determine whether the texture created from this brush can be
+           *          shared with other identical brushes. This is only possible when the
+           *          sharing is enabled and when the brush uses a canvas which content is
+           *          fully described by drawing operations: brushes created from raw data
+           *          or which canvas was never drawn on are never shared.
+           * @return - `true` if the texture of this brush can be shared.
+           */
+          bool
+          isCacheable() const noexcept;
+
+          /**
+           * @brief - Returns a hash of the content of the canvas. It is computed from the
+           *          dimensions of the canvas and the drawing operations performed since
+           *          it was created or since the last operation covering the whole canvas
+           *          so two brushes with the same hash produce the same texture.
+           * @return - a hash of the content of the canvas.
+           */
+          std::uint64_t
+          getContentHash() const noexcept;
+
+          /**
+           * @brief - Describes the content of a canvas which is fully described by its
+           *          drawing operations: its dimensions and the operations performed
+           *          since it was created or since the last operation covering it.
+           */
+          struct Content;
+
+          /**
+           * @brief - Returns a copy of the description of the content of the canvas.
+           *          It can be compared with the content of other brushes through the
+           *          `hasContent` method.
+           * @return - the description of the content of the canvas.
+           */
+          Content
+          getContent() const;
+
+          /**
+           * @brief - Determines whether the content of the canvas is identical to the
+           *          input description. Unlike comparing the hashes of the content, it
+           *          can't be fooled by collisions.
+           * @param content - the description to compare with.
+           * @return - `true` if this brush produces the texture described by `content`.
+           */
+          bool
+          hasContent(const Content& content) const noexcept;
+
+          /**
+           * @brief - Returns the dimensions of the canvas of the brush or an empty size
+           *          if no canvas is defined.
+           * @return - the dimensions of the canvas.
+           */
+          utils::Sizei
+          getCanvasSize() const noexcept;
+
+          /**
+           * @brief - Used to release the canvas of the brush when an identical texture is
+           *          already available: this allows to not leak the canvas when it would
+           *          have been transferred to the texture.
+           */
+          void
+          discard() noexcept;
+
         private:
 
           /**
@@ -181,11 +348,204 @@ namespace sdl {
           hasRawData() const noexcept;
 
           /**
-           * @brief - Used to destroy any existing canvas.
+           * @brief - Used to destroy any existing canvas. Pending drawing operations
+           *          are discarded.
            */
           void
           destroy() noexcept;
 
+          /**
+           * @brief - Describes a drawing operation recorded by the brush. Operations
+           *          are recorded until the content of the canvas is needed, at which
+           *          point they are replayed on the canvas.
+           */
+          struct Command {
+            /**
+             * @brief - The kind of operation: either filling an area with a single
+             *          color or drawing a gradient on the whole canvas.
+             */
+            enum class Type {
+              Fill,
+              Gradient,
+              Segment,
+              Ellipse,
+              RoundedRect,
+              Polygon
+            };
+
+            Type type;
+
+            /**
+             * @brief - The area covered by the operation, clipped to the canvas.
+             */
+            SDL_Rect area;
+
+            /**
+             * @brief - The color used to fill the area, in the format of the canvas
+             *          for fill operations and as `0xAARRGGBB` for shapes.
+             */
+            Uint32 color;
+
+            /**
+             * @brief - A copy of the gradient to draw if any: the gradient provided
+             *          by the caller might change before the operation is replayed.
+             */
+            GradientShPtr gradient;
+
+            /**
+             * @brief - The description of the shape in pixels of the canvas. It holds
+             *          the ends and half width of segments, the center and radii of
+             *          ellipses, the center, half dimensions and radius of rounded
+             *          rectangles and the vertices of polygons.
+             */
+            std::vector<float> geometry;
+          };
+
+          /**
+           * @brief - Records a new drawing operation. If the operation covers the
+           *          whole canvas, all the previously recorded operations are just
+           *          discarded as they would be overwritten anyway.
+           * @param cmd - the operation to record.
+           */
+          void
+          record(const Command& cmd);
+
+          /**
+           * @brief - Resets the hash of the content of the canvas so that it only
+           *          describes the dimensions of the canvas. Assumes that a canvas
+           *          is available.
+           */
+          void
+          resetHash() noexcept;
+
+          /**
+           * @brief - Records the drawing of a shape covering the input bounding box with
+           *          the current color. The box is clipped to the canvas and nothing is
+           *          recorded if it is empty.
+           * @param type - the type of shape to draw.
+           * @param left - the left bound of the shape in pixels.
+           * @param top - the top bound of the shape in pixels.
+           * @param right - the right bound of the shape in pixels.
+           * @param bottom - the bottom bound of the shape in pixels.
+           * @param geometry - the description of the shape.
+           */
+          void
+          recordShape(const Command::Type& type,
+                      float left,
+                      float top,
+                      float right,
+                      float bottom,
+                      std::vector<float> geometry);
+
+          /**
+           * @brief - Computes the coverage of the shape described by the command for
+           *          the pixels of the input tile and blends the color of the command
+           *          accordingly. Assumes that the canvas is valid and locked if needed.
+           * @param cmd - the shape to draw.
+           * @param tile - the area of the canvas to draw.
+           */
+          void
+          rasterizeShape(const Command& cmd,
+                         const SDL_Rect& tile) const;
+
+          /**
+           * @brief - Blends the input color on a span of the canvas, weighted by the
+           *          coverage of each pixel.
+           *          Assumes that the canvas is valid and locked if needed.
+           * @param x - the first column to blend.
+           * @param y - the row to blend.
+           * @param count - the number of pixels to blend.
+           * @param coverage - the coverage of each pixel in the range `[0; 1]`.
+           * @param argb - the color to blend, as `0xAARRGGBB`.
+           */
+          void
+          blendRow(int x,
+                   int y,
+                   int count,
+                   const float* coverage,
+                   Uint32 argb) const;
+
+          /**
+           * @brief - Replays all the recorded drawing operations on the canvas. The
+           *          canvas is split in tiles which are drawn in parallel if it is
+           *          large enough. Each tile replays all operations in the order they
+           *          were recorded so the result is identical no matter the number of
+           *          threads used.
+           *          Nothing happens if no operations are pending.
+           */
+          void
+          replay();
+
+          /**
+           * @brief - Replays all the recorded operations on the input tile of the canvas.
+           *          Assumes that the canvas is valid and locked if needed.
+           * @param tile - the area of the canvas to draw.
+           */
+          void
+          replayTile(const SDL_Rect& tile) const;
+
+          /**
+           * @brief - Compares two drawing operations.
+           * @param lhs - the first operation.
+           * @param rhs - the second operation.
+           * @return - `true` if both operations draw the same pixels.
+           */
+          static
+          bool
+          equals(const Command& lhs,
+                 const Command& rhs) noexcept;
+
+          /**
+           * @brief - Fills the input area of the canvas with the specified color. The
+           *          area is assumed to lie within the canvas.
+           * @param area - the area to fill.
+           * @param color - the color to use, in the format of the canvas.
+           */
+          void
+          fill(const SDL_Rect& area,
+               Uint32 color) const;
+
+          /**
+           * @brief - Computes the colors of the gradient for the input tile of the canvas
+           *          and writes them. Assumes that the canvas is valid and locked if needed.
+           * @param grad - the gradient to draw.
+           * @param tile - the area of the canvas to draw.
+           */
+          void
+          rasterizeGradient(const Gradient& grad,
+                            const SDL_Rect& tile) const;
+
+          /**
+           * @brief - Writes the input colors on the specified row of the canvas, starting
+           *          at the specified column. The colors are expected in the format given
+           *          by `SDL_PIXELFORMAT_ARGB8888` and are converted if the canvas uses a
+           *          different format.
+           *          Assumes that the canvas is valid and locked if needed.
+           * @param x - the first column to write.
+           * @param y - the index of the row to write.
+           * @param count - the number of colors to write.
+           * @param row - the colors to write.
+           */
+          void
+          writeRow(int x,
+                   int y,
+                   int count,
+                   const Uint32* row) const;
+
+        private:
+
+          /**
+           * @brief - The minimum number of pixels for a canvas to be drawn by
+           *          several threads.
+           */
+          static constexpr int sk_parallelPixels = 256 * 256;
+
+          /**
+           * @brief - The dimensions of the tiles into which the canvas is split
+           *          when replaying the drawing operations.
+           */
+          static constexpr int sk_tileSize = 64;
+
         private:
 
           /**
@@ -220,6 +580,36 @@ namespace sdl {
            *          internal surface is always freed).
            */
           bool m_ownsCanvas;
+
+          /**
+           * @brief - The drawing operations recorded since the last time the canvas
+           *          was updated.
+           */
+          std::vector<Command> m_commands;
+
+          /**
+           * @brief - Whether the textures created from this brush can be shared.
+           */
+          bool m_cacheable;
+
+          /**
+           * @brief - The hash of the content of the canvas, updated each time a
+           *          drawing operation is recorded.
+           */
+          std::uint64_t m_hash;
+
+          /**
+           * @brief - The drawing operations accounted for in the hash. Unlike the
+           *          `m_commands` they are kept once replayed on the canvas so that
+           *          the content can be compared exactly.
+           */
+          std::vector<Command> m_history;
+      };
+
+      struct Brush::Content {
+        int w;
+        int h;
+        std::vector<Command> commands;
       };
 
       using BrushShPtr = std::shared_ptr<Brush>;
@@ -21,6 +21,12 @@ namespace sdl {
         m_color = color;
       }
 
+      inline
+      void
+      Brush::setColor(const PackedColor& color) noexcept {
+        m_color = color.toColor();
+      }
+
       inline
       void
       Brush::setClearColor(const Color& color) noexcept {
@@ -47,6 +53,8 @@ namespace sdl {
           );
         }
 
+        resetHash();
+
         // Perform a clear operation if needed.
         if (fill) {
           clear();
@@ -62,7 +70,60 @@ namespace sdl {
         }
 
         SDL_Color c = m_clearColor.toSDLColor();
-        SDL_FillRect(m_canvas, nullptr, SDL_MapRGBA(m_canvas->format, c.r, c.g, c.b, c.a));
+
+        record(
+          Command{
+            Command::Type::Fill,
+            SDL_Rect{0, 0, m_canvas->w, m_canvas->h},
+            SDL_MapRGBA(m_canvas->format, c.r, c.g, c.b, c.a),
+            nullptr,
+            std::vector<float>()
+          }
+        );
+      }
+
+      inline
+      void
+      Brush::setCacheable(bool cacheable) noexcept {
+        m_cacheable = cacheable;
+      }
+
+      inline
+      bool
+      Brush::isCacheable() const noexcept {
+        return m_cacheable && hasCanvas() && !m_history.empty();
+      }
+
+      inline
+      std::uint64_t
+      Brush::getContentHash() const noexcept {
+        return m_hash;
+      }
+
+      inline
+      Brush::Content
+      Brush::getContent() const {
+        const utils::Sizei size = getCanvasSize();
+        return Content{size.w(), size.h(), m_history};
+      }
+
+      inline
+      utils::Sizei
+      Brush::getCanvasSize() const noexcept {
+        if (!hasCanvas()) {
+          return utils::Sizei();
+        }
+
+        return utils::Sizei(m_canvas->w, m_canvas->h);
+      }
+
+      inline
+      void
+      Brush::discard() noexcept {
+        // Brushes owning their canvas release it when destroyed.
+        if (!m_ownsCanvas) {
+          destroy();
+        }
       }
 
       inline
@@ -86,6 +147,8 @@ namespace sdl {
       inline
       void
       Brush::destroy() noexcept {
+        m_commands.clear();
+
         if (hasCanvas()) {
           SDL_FreeSurface(m_canvas);
           m_canvas = nullptr;
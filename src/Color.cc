@@ -1,5 +1,8 @@
 
 # include "Color.hh"
+# include <cmath>
+# include <algorithm>
+# include "PackedColor.hh"
 
 namespace sdl {
   namespace core {
@@ -69,6 +72,111 @@ namespace sdl {
         return sdl::core::engine::Color::fromRGB(r1 + m, g1 + m, b1 + m);
       }
 
+      void
+      Color::convertHSVToARGB(const float* h,
+                              const float* s,
+                              const float* v,
+                              std::uint32_t* out,
+                              unsigned count) noexcept
+      {
+        // This follows `fromHSV` closely so that the results are identical: the
+        // sectors of the hue are selected without branches.
+        for (unsigned id = 0u ; id < count ; ++id) {
+          const float hc = std::min(1.0f, std::max(0.0f, h[id]));
+          const float sc = std::min(1.0f, std::max(0.0f, s[id]));
+          const float vc = std::min(1.0f, std::max(0.0f, v[id]));
+
+          const float c = vc * sc;
+          const float hp = (360.0f * hc) / 60.0f;
+
+          // `hp` lies in `[0; 6]`: this is equivalent to `std::fmod(hp, 2)` and
+          // exact as dividing by `2` is.
+          const float mod = hp - 2.0f * std::floor(hp / 2.0f);
+          const float x = c * (1.0f - std::abs(mod - 1.0f));
+
+          const float r1 = (hp <= 1.0f || hp >= 5.0f ? c : (hp < 2.0f || (hp >= 4.0f && hp < 5.0f) ? x : 0.0f));
+          const float g1 = (hp > 1.0f && hp < 3.0f ? c : (hp <= 1.0f || (hp >= 3.0f && hp < 4.0f) ? x : 0.0f));
+          const float b1 = (hp >= 3.0f && hp < 5.0f ? c : ((hp >= 2.0f && hp < 3.0f) || hp >= 5.0f ? x : 0.0f));
+
+          const float m = vc - c;
+
+          out[id] = PackedColor::fromRGBA(r1 + m, g1 + m, b1 + m, sk_opaqueAlpha).value();
+        }
+      }
+
+      void
+      Color::convertToARGB(const Color* in,
+                           std::uint32_t* out,
+                           unsigned count) noexcept
+      {
+        for (unsigned id = 0u ; id < count ; ++id) {
+          out[id] = PackedColor::fromRGBA(in[id].m_r, in[id].m_g, in[id].m_b, in[id].m_a).value();
+        }
+      }
+
+      void
+      Color::brightenSpan(const Color* in,
+                          float factor,
+                          std::uint32_t* out,
+                          unsigned count) noexcept
+      {
+        const float f = std::abs(factor);
+
+        for (unsigned id = 0u ; id < count ; ++id) {
+          out[id] = PackedColor::fromRGBA(
+            std::min(1.0f, in[id].m_r * f),
+            std::min(1.0f, in[id].m_g * f),
+            std::min(1.0f, in[id].m_b * f),
+            in[id].m_a
+          ).value();
+        }
+      }
+
+      void
+      Color::darkenSpan(const Color* in,
+                        float factor,
+                        std::uint32_t* out,
+                        unsigned count) noexcept
+      {
+        // Darkening is the same operation as brightening with a smaller factor.
+        brightenSpan(in, factor, out, count);
+      }
+
+      void
+      Color::blendSpan(const Color* lhs,
+                       const Color* rhs,
+                       float perc,
+                       std::uint32_t* out,
+                       unsigned count) noexcept
+      {
+        const float comp = 1.0f - perc;
+
+        for (unsigned id = 0u ; id < count ; ++id) {
+          out[id] = PackedColor::fromRGBA(
+            perc * lhs[id].m_r + comp * rhs[id].m_r,
+            perc * lhs[id].m_g + comp * rhs[id].m_g,
+            perc * lhs[id].m_b + comp * rhs[id].m_b,
+            lhs[id].m_a
+          ).value();
+        }
+      }
+
+      void
+      Color::mixSpan(const Color* lhs,
+                     const Color* rhs,
+                     std::uint32_t* out,
+                     unsigned count) noexcept
+      {
+        for (unsigned id = 0u ; id < count ; ++id) {
+          out[id] = PackedColor::fromRGBA(
+            std::min(1.0f, (lhs[id].m_r + rhs[id].m_r) / 2.0f),
+            std::min(1.0f, (lhs[id].m_g + rhs[id].m_g) / 2.0f),
+            std::min(1.0f, (lhs[id].m_b + rhs[id].m_b) / 2.0f),
+            std::min(1.0f, (lhs[id].m_a + rhs[id].m_a) / 2.0f)
+          ).value();
+        }
+      }
+
       void
       Color::fromNamedColor(const NamedColor& color,
                             float& r,
@@ -3,6 +3,7 @@
 
 # include <memory>
 # include <string>
+# include <cstdint>
 # include <SDL2/SDL.h>
 
 namespace sdl {
@@ -52,7 +53,7 @@ namespace sdl {
           float&
           r() noexcept;
 
-          float
+          std::uint8_t
           rU() const noexcept;
 
           float
@@ -61,7 +62,7 @@ namespace sdl {
           float&
           g() noexcept;
 
-          float
+          std::uint8_t
           gU() const noexcept;
 
           float
@@ -70,7 +71,7 @@ namespace sdl {
           float&
           b() noexcept;
 
-          float
+          std::uint8_t
           bU() const noexcept;
 
           float
@@ -79,7 +80,7 @@ namespace sdl {
           float&
           a() noexcept;
 
-          float
+          std::uint8_t
           aU() const noexcept;
 
           bool
@@ -160,6 +161,101 @@ namespace sdl {
                   float s,
                   float v) noexcept;
 
+          /**
+           * @brief - Converts a span of colors expressed in the `HSV` color space
+           *          into packed `0xAARRGGBB` values with opaque alpha. The result
+           *          is identical to calling `fromHSV` and converting each color
+           *          with `toSDLColor` but the loop has no branch which allows it
+           *          to be vectorized.
+           * @param h - the hue of each color.
+           * @param s - the saturation of each color.
+           * @param v - the value of each color.
+           * @param out - the output packed colors.
+           * @param count - the number of colors to convert.
+           */
+          static
+          void
+          convertHSVToARGB(const float* h,
+                           const float* s,
+                           const float* v,
+                           std::uint32_t* out,
+                           unsigned count) noexcept;
+
+          /**
+           * @brief - Converts a span of colors into packed `0xAARRGGBB` values with
+           *          the same rounding as `toSDLColor`.
+           * @param in - the colors to convert.
+           * @param out - the output packed colors.
+           * @param count - the number of colors to convert.
+           */
+          static
+          void
+          convertToARGB(const Color* in,
+                        std::uint32_t* out,
+                        unsigned count) noexcept;
+
+          /**
+           * @brief - Applies `brighten` to a span of colors and packs the result as
+           *          `0xAARRGGBB` values.
+           * @param in - the colors to brighten.
+           * @param factor - the factor to apply to each color.
+           * @param out - the output packed colors.
+           * @param count - the number of colors to process.
+           */
+          static
+          void
+          brightenSpan(const Color* in,
+                       float factor,
+                       std::uint32_t* out,
+                       unsigned count) noexcept;
+
+          /**
+           * @brief - Applies `darken` to a span of colors and packs the result as
+           *          `0xAARRGGBB` values.
+           * @param in - the colors to darken.
+           * @param factor - the factor to apply to each color.
+           * @param out - the output packed colors.
+           * @param count - the number of colors to process.
+           */
+          static
+          void
+          darkenSpan(const Color* in,
+                     float factor,
+                     std::uint32_t* out,
+                     unsigned count) noexcept;
+
+          /**
+           * @brief - Applies `blend` to each pair of colors of the input spans and
+           *          packs the result as `0xAARRGGBB` values.
+           * @param lhs - the colors weighted by `perc`, which also provide the alpha.
+           * @param rhs - the colors weighted by `1 - perc`.
+           * @param perc - the weight of the `lhs` colors.
+           * @param out - the output packed colors.
+           * @param count - the number of colors to process.
+           */
+          static
+          void
+          blendSpan(const Color* lhs,
+                    const Color* rhs,
+                    float perc,
+                    std::uint32_t* out,
+                    unsigned count) noexcept;
+
+          /**
+           * @brief - Applies `mix` to each pair of colors of the input spans and
+           *          packs the result as `0xAARRGGBB` values.
+           * @param lhs - the first colors to mix.
+           * @param rhs - the second colors to mix.
+           * @param out - the output packed colors.
+           * @param count - the number of colors to process.
+           */
+          static
+          void
+          mixSpan(const Color* lhs,
+                  const Color* rhs,
+                  std::uint32_t* out,
+                  unsigned count) noexcept;
+
         protected:
 
           Color(float r,
@@ -59,7 +59,7 @@ namespace sdl {
       }
 
       inline
-      float
+      std::uint8_t
       Color::rU() const noexcept {
         return static_cast<uint8_t>(utils::clamp(m_r, 0.0f, 1.0f) * 255.0f);
       }
@@ -77,7 +77,7 @@ namespace sdl {
       }
 
       inline
-      float
+      std::uint8_t
       Color::gU() const noexcept {
         return static_cast<uint8_t>(utils::clamp(m_g, 0.0f, 1.0f) * 255.0f);
       }
@@ -95,7 +95,7 @@ namespace sdl {
       }
 
       inline
-      float
+      std::uint8_t
       Color::bU() const noexcept {
         return static_cast<uint8_t>(utils::clamp(m_b, 0.0f, 1.0f) * 255.0f);
       }
@@ -113,7 +113,7 @@ namespace sdl {
       }
 
       inline
-      float
+      std::uint8_t
       Color::aU() const noexcept {
         return static_cast<uint8_t>(utils::clamp(m_a, 0.0f, 1.0f) * 255.0f);
       }
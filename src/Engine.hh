@@ -22,6 +22,7 @@
 # include "ResizeEvent.hh"
 # include "WindowEvent.hh"
 # include "Brush.hh"
+# include "FrameStats.hh"
 
 namespace sdl {
   namespace core {
@@ -57,6 +58,74 @@ namespace sdl {
           updateViewport(const utils::Uuid& uuid,
                          const utils::Boxf& area) = 0;
 
+          /**
+           * @brief - Defines whether the window uses a retained framebuffer: in this
+           *          mode only the areas which were modified need to be redrawn and
+           *          frames with no modifications are not presented at all.
+           *          The default implementation does nothing.
+           * @param uuid - the identifier of the window to update.
+           * @param retained - `true` if the window should use retained mode.
+           */
+          virtual void
+          setWindowRetained(const utils::Uuid& uuid,
+                            bool retained);
+
+          /**
+           * @brief - Marks an area of the window as damaged so that it is presented
+           *          at the next frame even if nothing is drawn on it. Only relevant
+           *          for windows in retained mode.
+           *          The default implementation does nothing.
+           * @param uuid - the identifier of the window to invalidate.
+           * @param area - the area to invalidate or `null` for the whole window.
+           */
+          virtual void
+          invalidateWindow(const utils::Uuid& uuid,
+                           const utils::Boxf* area = nullptr);
+
+          /**
+           * @brief - Defines the rate at which the window is expected to present its
+           *          frames and whether presenting is synchronized with the display.
+           *          The default implementation does nothing.
+           * @param uuid - the identifier of the window to update.
+           * @param rate - the expected number of frames per second or `0` if frames
+           *               are not expected at any particular rate.
+           * @param vsync - `true` if presenting should wait for the vertical sync.
+           */
+          virtual void
+          setWindowFramePacing(const utils::Uuid& uuid,
+                               float rate,
+                               bool vsync);
+
+          /**
+           * @brief - Retrieves the statistics about the durations of the frames of the
+           *          window. The default implementation returns empty statistics.
+           * @param uuid - the identifier of the window to query.
+           * @return - the frame statistics of the window.
+           */
+          virtual FrameStats
+          getWindowFrameStats(const utils::Uuid& uuid);
+
+          /**
+           * @brief - Retrieves the number of frames presented and skipped by the
+           *          window along with the damaged area of the last frame. The
+           *          default implementation returns empty statistics.
+           * @param uuid - the identifier of the window to query.
+           * @return - the damage statistics of the window.
+           */
+          virtual Window::DamageStats
+          getWindowDamageStats(const utils::Uuid& uuid);
+
+          /**
+           * @brief - Reads back the content of the window. See `Window::readPixels`
+           *          for details about which content is read. The default
+           *          implementation returns `null` which indicates that reading
+           *          back the pixels is not supported.
+           * @param uuid - the identifier of the window to read.
+           * @return - the pixels of the window or `null` if they can't be read.
+           */
+          virtual SurfaceTexture::RawSurfaceDataShPtr
+          readWindowPixels(const utils::Uuid& uuid);
+
           virtual void
           destroyWindow(const utils::Uuid& uuid) = 0;
 
@@ -101,6 +170,39 @@ namespace sdl {
           createTextureFromFile(ImageShPtr img,
                                 const Palette::ColorRole& role) = 0;
 
+          /**
+           * @brief - Similar to `createTextureFromFile` but returns right away without
+           *          waiting for the image to be decoded. The texture can be used as any
+           *          other texture: until the image is available a placeholder is used.
+           *          The default implementation falls back to `createTextureFromFile`.
+           * @param win - the window into which the texture should be created.
+           * @param img - the image from which the texture should be created.
+           * @param role - the role of the texture.
+           * @return - the identifier of the created texture.
+           */
+          virtual utils::Uuid
+          createTextureFromFileAsync(const utils::Uuid& win,
+                                     ImageShPtr img,
+                                     const Palette::ColorRole& role);
+
+          /**
+           * @brief - Returns the number of images requested through the asynchronous
+           *          texture creation which are not yet decoded. The default
+           *          implementation returns `0`.
+           * @return - the number of images waiting to be decoded.
+           */
+          virtual unsigned
+          getPendingDecodesCount() const noexcept;
+
+          /**
+           * @brief - Returns the average time elapsed between the request to create
+           *          a texture asynchronously and the completion of the decoding of
+           *          its image. The default implementation returns `0`.
+           * @return - the average decode latency in milliseconds.
+           */
+          virtual float
+          getDecodeLatency() const noexcept;
+
           virtual utils::Uuid
           createTextureFromText(const utils::Uuid& win,
                                 const std::string& text,
@@ -217,6 +319,19 @@ namespace sdl {
           virtual std::vector<EventShPtr>
           pollEvents() = 0;
 
+          /**
+           * @brief - Similar to `pollEvents` but appends the events to the input vector
+           *          instead of returning a new one. This allows callers to reuse the
+           *          same buffer from one frame to the next and thus avoid allocating
+           *          memory for each poll.
+           *          The default implementation relies on `pollEvents` so inheriting
+           *          classes are encouraged to specialize it.
+           * @param out - the vector to which events should be appended. Its content is
+           *              not cleared by this method.
+           */
+          virtual void
+          pollEvents(std::vector<EventShPtr>& out);
+
           virtual void
           populateEvent(Event& event);
 
@@ -7,6 +7,77 @@ namespace sdl {
   namespace core {
     namespace engine {
 
+      inline
+      void
+      Engine::setWindowRetained(const utils::Uuid& /*uuid*/,
+                                bool /*retained*/)
+      {
+        // Empty implementation.
+      }
+
+      inline
+      void
+      Engine::invalidateWindow(const utils::Uuid& /*uuid*/,
+                               const utils::Boxf* /*area*/)
+      {
+        // Empty implementation.
+      }
+
+      inline
+      void
+      Engine::setWindowFramePacing(const utils::Uuid& /*uuid*/,
+                                   float /*rate*/,
+                                   bool /*vsync*/)
+      {
+        // Empty implementation.
+      }
+
+      inline
+      FrameStats
+      Engine::getWindowFrameStats(const utils::Uuid& /*uuid*/) {
+        return FrameStats{0u, 0u, 0.0f, 0.0f, 0.0f, 0.0f};
+      }
+
+      inline
+      Window::DamageStats
+      Engine::getWindowDamageStats(const utils::Uuid& /*uuid*/) {
+        return Window::DamageStats{0u, 0u, 0.0f};
+      }
+
+      inline
+      SurfaceTexture::RawSurfaceDataShPtr
+      Engine::readWindowPixels(const utils::Uuid& /*uuid*/) {
+        return nullptr;
+      }
+
+      inline
+      utils::Uuid
+      Engine::createTextureFromFileAsync(const utils::Uuid& win,
+                                         ImageShPtr img,
+                                         const Palette::ColorRole& role)
+      {
+        return createTextureFromFile(win, img, role);
+      }
+
+      inline
+      unsigned
+      Engine::getPendingDecodesCount() const noexcept {
+        return 0u;
+      }
+
+      inline
+      float
+      Engine::getDecodeLatency() const noexcept {
+        return 0.0f;
+      }
+
+      inline
+      void
+      Engine::pollEvents(std::vector<EventShPtr>& out) {
+        std::vector<EventShPtr> events = pollEvents();
+        out.insert(out.end(), events.cbegin(), events.cend());
+      }
+
       inline
       void
       Engine::populateEvent(Event& /*event*/) {
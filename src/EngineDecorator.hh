@@ -37,6 +37,28 @@ namespace sdl {
           updateViewport(const utils::Uuid& uuid,
                          const utils::Boxf& area) override;
 
+          void
+          setWindowRetained(const utils::Uuid& uuid,
+                            bool retained) override;
+
+          void
+          invalidateWindow(const utils::Uuid& uuid,
+                           const utils::Boxf* area = nullptr) override;
+
+          void
+          setWindowFramePacing(const utils::Uuid& uuid,
+                               float rate,
+                               bool vsync) override;
+
+          FrameStats
+          getWindowFrameStats(const utils::Uuid& uuid) override;
+
+          Window::DamageStats
+          getWindowDamageStats(const utils::Uuid& uuid) override;
+
+          SurfaceTexture::RawSurfaceDataShPtr
+          readWindowPixels(const utils::Uuid& uuid) override;
+
           void
           destroyWindow(const utils::Uuid& uuid) override;
 
@@ -74,6 +96,17 @@ namespace sdl {
           createTextureFromFile(ImageShPtr img,
                                 const Palette::ColorRole& role) override;
 
+          utils::Uuid
+          createTextureFromFileAsync(const utils::Uuid& win,
+                                     ImageShPtr img,
+                                     const Palette::ColorRole& role) override;
+
+          unsigned
+          getPendingDecodesCount() const noexcept override;
+
+          float
+          getDecodeLatency() const noexcept override;
+
           utils::Uuid
           createTextureFromText(const utils::Uuid& win,
                                 const std::string& text,
@@ -142,6 +175,9 @@ namespace sdl {
           std::vector<EventShPtr>
           pollEvents() override;
 
+          void
+          pollEvents(std::vector<EventShPtr>& out) override;
+
           void
           populateEvent(Event& event) override;
 
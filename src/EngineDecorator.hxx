@@ -44,6 +44,49 @@ namespace sdl {
         m_engine->updateViewport(uuid, area);
       }
 
+      inline
+      void
+      EngineDecorator::setWindowRetained(const utils::Uuid& uuid,
+                                         bool retained)
+      {
+        m_engine->setWindowRetained(uuid, retained);
+      }
+
+      inline
+      void
+      EngineDecorator::invalidateWindow(const utils::Uuid& uuid,
+                                        const utils::Boxf* area)
+      {
+        m_engine->invalidateWindow(uuid, area);
+      }
+
+      inline
+      void
+      EngineDecorator::setWindowFramePacing(const utils::Uuid& uuid,
+                                            float rate,
+                                            bool vsync)
+      {
+        m_engine->setWindowFramePacing(uuid, rate, vsync);
+      }
+
+      inline
+      FrameStats
+      EngineDecorator::getWindowFrameStats(const utils::Uuid& uuid) {
+        return m_engine->getWindowFrameStats(uuid);
+      }
+
+      inline
+      Window::DamageStats
+      EngineDecorator::getWindowDamageStats(const utils::Uuid& uuid) {
+        return m_engine->getWindowDamageStats(uuid);
+      }
+
+      inline
+      SurfaceTexture::RawSurfaceDataShPtr
+      EngineDecorator::readWindowPixels(const utils::Uuid& uuid) {
+        return m_engine->readWindowPixels(uuid);
+      }
+
       inline
       void
       EngineDecorator::destroyWindow(const utils::Uuid& uuid) {
@@ -84,6 +127,27 @@ namespace sdl {
         return m_engine->createTextureFromFile(img, role);
       }
 
+      inline
+      utils::Uuid
+      EngineDecorator::createTextureFromFileAsync(const utils::Uuid& win,
+                                                  ImageShPtr img,
+                                                  const Palette::ColorRole& role)
+      {
+        return m_engine->createTextureFromFileAsync(win, img, role);
+      }
+
+      inline
+      unsigned
+      EngineDecorator::getPendingDecodesCount() const noexcept {
+        return m_engine->getPendingDecodesCount();
+      }
+
+      inline
+      float
+      EngineDecorator::getDecodeLatency() const noexcept {
+        return m_engine->getDecodeLatency();
+      }
+
       inline
       utils::Uuid
       EngineDecorator::createTextureFromText(const utils::Uuid& win,
@@ -200,6 +264,12 @@ namespace sdl {
         return m_engine->pollEvents();
       }
 
+      inline
+      void
+      EngineDecorator::pollEvents(std::vector<EventShPtr>& out) {
+        m_engine->pollEvents(out);
+      }
+
       inline
       void
       EngineDecorator::populateEvent(Event& event) {
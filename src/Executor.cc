@@ -0,0 +1,231 @@
+
+# include "Executor.hh"
+# include <core_utils/SafetyNet.hh>
+
+namespace {
+
+  /**
+   * @brief - Describes a batch of tasks executed by the `run` method. The
+   *          thread running the batch waits on the condition variable until
+   *          all the tasks are completed.
+   */
+  struct Batch {
+    std::mutex locker;
+    std::condition_variable done;
+    unsigned remaining;
+  };
+
+  /**
+   * @brief - Convenience structure counting a task of a batch as completed
+   *          when destroyed. It allows to count the tasks as completed even
+   *          if they raise an error.
+   */
+  struct Countdown {
+    Batch& batch;
+
+    ~Countdown() {
+      // The batch is destroyed as soon as the waiting thread sees that no
+      // tasks remain: we need to notify it while holding the lock.
+      const std::lock_guard guard(batch.locker);
+
+      --batch.remaining;
+      if (batch.remaining == 0u) {
+        batch.done.notify_all();
+      }
+    }
+  };
+
+}
+
+namespace sdl {
+  namespace core {
+    namespace engine {
+
+      Executor::Executor(unsigned workers,
+                         const std::string& name):
+        utils::CoreObject(name),
+
+        m_queues(),
+        m_workers(),
+
+        m_pending(0u),
+        m_next(0u),
+
+        m_sleepLocker(),
+        m_sleeper(),
+        m_running(true)
+      {
+        setService("executor");
+
+        // Create the queues first so that they are available as soon as the
+        // workers start.
+        for (unsigned id = 0u ; id < workers ; ++id) {
+          m_queues.push_back(std::make_shared<Queue>());
+        }
+
+        m_workers.reserve(workers);
+        for (unsigned id = 0u ; id < workers ; ++id) {
+          m_workers.emplace_back(&Executor::work, this, id);
+        }
+      }
+
+      Executor::~Executor() {
+        {
+          const std::lock_guard guard(m_sleepLocker);
+          m_running = false;
+        }
+
+        m_sleeper.notify_all();
+
+        for (unsigned id = 0u ; id < m_workers.size() ; ++id) {
+          m_workers[id].join();
+        }
+      }
+
+      void
+      Executor::post(Task task) {
+        // Without workers the task is executed right away.
+        if (m_queues.empty()) {
+          execute(task);
+          return;
+        }
+
+        const unsigned id = m_next.fetch_add(1u) % m_queues.size();
+
+        {
+          const std::lock_guard guard(m_queues[id]->locker);
+          m_queues[id]->tasks.push_back(std::move(task));
+        }
+
+        // Increase the number of pending tasks and wake up a worker. We need
+        // to acquire the lock used by workers to sleep in order not to miss
+        // the notification.
+        {
+          const std::lock_guard guard(m_sleepLocker);
+          ++m_pending;
+        }
+
+        m_sleeper.notify_one();
+      }
+
+      void
+      Executor::run(std::vector<Task>& tasks) {
+        // Without workers, execute the tasks in order.
+        if (m_queues.empty()) {
+          for (unsigned id = 0u ; id < tasks.size() ; ++id) {
+            execute(tasks[id]);
+          }
+
+          tasks.clear();
+          return;
+        }
+
+        // Wrap each task so that it signals its completion and distribute
+        // them to the workers.
+        Batch batch;
+        batch.remaining = tasks.size();
+
+        for (unsigned id = 0u ; id < tasks.size() ; ++id) {
+          Task task = std::move(tasks[id]);
+
+          post(
+            [task, &batch]() {
+              const Countdown countdown{batch};
+              task();
+            }
+          );
+        }
+
+        tasks.clear();
+
+        // Help executing the tasks: this allows to progress even if the
+        // workers are busy with other work.
+        const unsigned home = m_next.load() % m_queues.size();
+
+        Task task;
+        while (pop(home, task)) {
+          execute(task);
+        }
+
+        // All the tasks have been picked: wait for the workers to complete
+        // the ones they are still executing.
+        std::unique_lock guard(batch.locker);
+        batch.done.wait(
+          guard,
+          [&batch]() {
+            return batch.remaining == 0u;
+          }
+        );
+      }
+
+      void
+      Executor::work(unsigned id) {
+        while (true) {
+          Task task;
+
+          if (pop(id, task)) {
+            execute(task);
+            continue;
+          }
+
+          // No more tasks: wait for some to be posted or for the executor to
+          // be stopped.
+          std::unique_lock guard(m_sleepLocker);
+          m_sleeper.wait(
+            guard,
+            [this]() {
+              return m_pending.load() > 0u || !m_running;
+            }
+          );
+
+          if (!m_running && m_pending.load() == 0u) {
+            break;
+          }
+        }
+      }
+
+      bool
+      Executor::pop(unsigned id,
+                    Task& task)
+      {
+        // Search our own queue first and then try to steal from the others.
+        // Our own tasks are taken from the back (most recent first) while we
+        // steal from the front of the other queues to limit the contention.
+        for (unsigned offset = 0u ; offset < m_queues.size() ; ++offset) {
+          Queue& queue = *m_queues[(id + offset) % m_queues.size()];
+
+          const std::lock_guard guard(queue.locker);
+          if (queue.tasks.empty()) {
+            continue;
+          }
+
+          if (offset == 0u) {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+          }
+          else {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+          }
+
+          --m_pending;
+
+          return true;
+        }
+
+        return false;
+      }
+
+      void
+      Executor::execute(Task& task) {
+        withSafetyNet(
+          [&task]() {
+            task();
+          },
+          std::string("execute")
+        );
+      }
+
+    }
+  }
+}
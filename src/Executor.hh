@@ -0,0 +1,142 @@
+#ifndef    EXECUTOR_HH
+# define   EXECUTOR_HH
+
+# include <deque>
+# include <mutex>
+# include <atomic>
+# include <memory>
+# include <thread>
+# include <vector>
+# include <functional>
+# include <condition_variable>
+# include <core_utils/CoreObject.hh>
+
+namespace sdl {
+  namespace core {
+    namespace engine {
+
+      /**
+       * @brief - A small pool of threads executing tasks. Each worker has its own
+       *          queue of tasks from which it pops tasks: when it is empty, the
+       *          worker tries to steal some tasks from the other workers. This is
+       *          well suited for batches of tasks with unbalanced durations.
+       *          Tasks can either be posted asynchronously (see `post`) or run as
+       *          a batch (see `run`) in which case the calling thread waits for
+       *          all the tasks to complete and helps executing them.
+       *          Note that an executor with no workers is valid: all the tasks are
+       *          then executed on the calling thread.
+       */
+      class Executor: public utils::CoreObject {
+        public:
+
+          using Task = std::function<void(void)>;
+
+          /**
+           * @brief - Creates a new executor with the specified number of workers.
+           * @param workers - the number of threads to create. If this value is `0`
+           *                  all the tasks will be executed by the calling thread.
+           * @param name - the name of the executor.
+           */
+          Executor(unsigned workers,
+                   const std::string& name = std::string("executor"));
+
+          /**
+           * @brief - Stops the workers. Tasks which were not executed yet are still
+           *          executed before the workers terminate.
+           */
+          ~Executor();
+
+          /**
+           * @brief - Returns the number of threads available in this executor.
+           * @return - the number of workers of this executor.
+           */
+          unsigned
+          getWorkersCount() const noexcept;
+
+          /**
+           * @brief - Posts a task to be executed asynchronously by one of the workers.
+           *          Tasks are distributed among the workers in a round robin way. If
+           *          no workers are available the task is executed right away.
+           * @param task - the task to execute.
+           */
+          void
+          post(Task task);
+
+          /**
+           * @brief - Executes all the input tasks and waits for them to complete. The
+           *          calling thread participates in the execution of the tasks so the
+           *          batch progresses even if all the workers are busy.
+           *          Note that the input vector is emptied by this method.
+           * @param tasks - the tasks to execute.
+           */
+          void
+          run(std::vector<Task>& tasks);
+
+        private:
+
+          /**
+           * @brief - The queue of tasks of a single worker.
+           */
+          struct Queue {
+            std::mutex locker;
+            std::deque<Task> tasks;
+          };
+
+          using QueueShPtr = std::shared_ptr<Queue>;
+
+          /**
+           * @brief - Main loop of a worker: pops tasks from the queue of the worker
+           *          (or steal them from other workers) until the executor is stopped.
+           * @param id - the index of the worker.
+           */
+          void
+          work(unsigned id);
+
+          /**
+           * @brief - Tries to retrieve a task to execute. The queue with the input
+           *          index is searched first (from the back) and then all the other
+           *          queues are searched (from the front).
+           * @param id - the index of the queue to search first.
+           * @param task - output argument receiving the task if any.
+           * @return - `true` if a task was retrieved and `false` otherwise.
+           */
+          bool
+          pop(unsigned id,
+              Task& task);
+
+          /**
+           * @brief - Executes the input task, protecting from any exception raised.
+           * @param task - the task to execute.
+           */
+          void
+          execute(Task& task);
+
+        private:
+
+          std::vector<QueueShPtr> m_queues;
+          std::vector<std::thread> m_workers;
+
+          /**
+           * @brief - The number of tasks queued and not yet picked by any worker. This
+           *          is used by workers to determine whether they should go to sleep.
+           */
+          std::atomic<unsigned> m_pending;
+
+          /**
+           * @brief - Index of the next queue which will receive a posted task.
+           */
+          std::atomic<unsigned> m_next;
+
+          std::mutex m_sleepLocker;
+          std::condition_variable m_sleeper;
+          bool m_running;
+      };
+
+      using ExecutorShPtr = std::shared_ptr<Executor>;
+    }
+  }
+}
+
+# include "Executor.hxx"
+
+#endif    /* EXECUTOR_HH */
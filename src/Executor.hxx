@@ -0,0 +1,20 @@
+#ifndef    EXECUTOR_HXX
+# define   EXECUTOR_HXX
+
+# include "Executor.hh"
+
+namespace sdl {
+  namespace core {
+    namespace engine {
+
+      inline
+      unsigned
+      Executor::getWorkersCount() const noexcept {
+        return m_workers.size();
+      }
+
+    }
+  }
+}
+
+#endif    /* EXECUTOR_HXX */
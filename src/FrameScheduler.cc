@@ -0,0 +1,144 @@
+
+# include "FrameScheduler.hh"
+# include <algorithm>
+# include <core_utils/SafetyNet.hh>
+
+namespace sdl {
+  namespace core {
+    namespace engine {
+
+      FrameScheduler::FrameScheduler(EngineShPtr engine,
+                                     float rate,
+                                     bool vsync,
+                                     const std::string& name):
+        utils::CoreObject(name),
+
+        m_engine(engine),
+
+        m_rate(std::max(0.1f, rate)),
+        m_vsync(vsync),
+
+        m_period(
+          std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<float>(1.0f / m_rate)
+          )
+        ),
+        m_deadline(std::chrono::steady_clock::now()),
+
+        m_windowsLocker(),
+        m_windows(),
+
+        m_frame(),
+
+        m_running(false),
+        m_thread()
+      {
+        setService("frames");
+
+        if (m_engine == nullptr) {
+          error(std::string("Cannot create frame scheduler with null engine"));
+        }
+      }
+
+      void
+      FrameScheduler::addWindow(const utils::Uuid& uuid,
+                                DrawCallback draw)
+      {
+        if (draw == nullptr) {
+          error(
+            std::string("Cannot add window ") + uuid.toString() + " to scheduler",
+            std::string("Invalid null draw callback")
+          );
+        }
+
+        m_engine->setWindowFramePacing(uuid, m_rate, m_vsync);
+
+        const std::lock_guard guard(m_windowsLocker);
+        m_windows[uuid] = draw;
+      }
+
+      void
+      FrameScheduler::run() {
+        if (m_running.exchange(true)) {
+          error(
+            std::string("Cannot start frame scheduler"),
+            std::string("Process already running")
+          );
+        }
+
+        m_deadline = std::chrono::steady_clock::now();
+        m_thread = std::thread(&FrameScheduler::loop, this);
+      }
+
+      void
+      FrameScheduler::stop() {
+        m_running.store(false);
+
+        if (m_thread.joinable()) {
+          m_thread.join();
+        }
+      }
+
+      void
+      FrameScheduler::step() {
+        // Copy the windows so that callbacks can add or remove windows.
+        {
+          const std::lock_guard guard(m_windowsLocker);
+          m_frame.assign(m_windows.cbegin(), m_windows.cend());
+        }
+
+        for (unsigned id = 0u ; id < m_frame.size() ; ++id) {
+          render(m_frame[id].first, m_frame[id].second);
+        }
+
+        const bool presented = !m_frame.empty();
+        m_frame.clear();
+
+        // Presenting already waited for the display in vsync mode. When no
+        // window was presented nothing did, so we still wait for the deadline
+        // so as not to spin.
+        const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        if (m_vsync && presented) {
+          m_deadline = now;
+          return;
+        }
+
+        // Wait until the deadline of the next frame. In case we're late we
+        // don't try to catch up, which would render a burst of frames, but
+        // rather start again from now.
+        m_deadline += m_period;
+
+        if (now >= m_deadline) {
+          m_deadline = now;
+          return;
+        }
+
+        std::this_thread::sleep_until(m_deadline);
+      }
+
+      void
+      FrameScheduler::loop() {
+        while (m_running.load()) {
+          step();
+        }
+
+        notice("Exiting frames thread");
+      }
+
+      void
+      FrameScheduler::render(const utils::Uuid& uuid,
+                             const DrawCallback& draw)
+      {
+        withSafetyNet(
+          [&uuid, &draw, this]() {
+            m_engine->clearWindow(uuid);
+            draw(uuid);
+            m_engine->renderWindow(uuid);
+          },
+          std::string("render")
+        );
+      }
+
+    }
+  }
+}
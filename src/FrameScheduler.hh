@@ -0,0 +1,170 @@
+#ifndef    FRAME_SCHEDULER_HH
+# define   FRAME_SCHEDULER_HH
+
+# include <mutex>
+# include <atomic>
+# include <chrono>
+# include <memory>
+# include <thread>
+# include <vector>
+# include <utility>
+# include <functional>
+# include <unordered_map>
+# include <core_utils/CoreObject.hh>
+# include <core_utils/Uuid.hh>
+# include "Engine.hh"
+
+namespace sdl {
+  namespace core {
+    namespace engine {
+
+      /**
+       * @brief - Drives the rendering of a set of windows at a fixed rate. Each
+       *          frame, every registered window is cleared, drawn through its
+       *          callback and presented. Frames are paced using absolute
+       *          deadlines so that the rate does not drift with the time spent
+       *          drawing: when a frame is late the scheduler does not try to
+       *          catch up but restarts from the current time.
+       *          In vsync mode presenting blocks until the display is ready so
+       *          the scheduler does not wait at all, unless no window was
+       *          presented during the frame.
+       *          The scheduler can either run its own thread (see `run`) or be
+       *          driven by the caller (see `step`).
+       *          Note that windows are cleared and presented from the thread
+       *          calling `step`: SDL only allows this from the thread which
+       *          created the windows. When using `run`, the engine should thus
+       *          forward these calls to the thread owning the renderers, for
+       *          example through a `RenderThreadEngine`. With a plain engine,
+       *          `step` should be called from the thread creating the windows.
+       *          The durations of the frames are available through the engine
+       *          with `Engine::getWindowFrameStats`.
+       */
+      class FrameScheduler: public utils::CoreObject {
+        public:
+
+          /**
+           * @brief - Callback drawing the content of a window. It is called with
+           *          the window already cleared and the window is presented right
+           *          after it returns.
+           */
+          using DrawCallback = std::function<void(const utils::Uuid&)>;
+
+          /**
+           * @brief - Creates a scheduler for windows of the input engine.
+           * @param engine - the engine to which the windows belong.
+           * @param rate - the number of frames per second to render.
+           * @param vsync - `true` if presenting should be synchronized with the
+           *                display rather than paced by the scheduler.
+           * @param name - the name of the scheduler.
+           */
+          explicit
+          FrameScheduler(EngineShPtr engine,
+                         float rate = 60.0f,
+                         bool vsync = false,
+                         const std::string& name = std::string("frame_scheduler"));
+
+          ~FrameScheduler();
+
+          /**
+           * @brief - Registers a window to render. The pacing of the window is set
+           *          to match the scheduler. Any callback already registered for the
+           *          window is replaced.
+           * @param uuid - the identifier of the window.
+           * @param draw - the callback drawing the content of the window.
+           */
+          void
+          addWindow(const utils::Uuid& uuid,
+                    DrawCallback draw);
+
+          /**
+           * @brief - Stops rendering the input window. Nothing happens if the window
+           *          is not registered.
+           * @param uuid - the identifier of the window.
+           */
+          void
+          removeWindow(const utils::Uuid& uuid);
+
+          /**
+           * @brief - Starts rendering frames on a dedicated thread. An error is
+           *          raised if the scheduler is already running.
+           *          The engine must accept window commands from this thread (see
+           *          `RenderThreadEngine`).
+           */
+          void
+          run();
+
+          /**
+           * @brief - Stops the thread started by `run` after the current frame.
+           */
+          void
+          stop();
+
+          bool
+          isRunning() const noexcept;
+
+          /**
+           * @brief - Renders a single frame for all the windows and waits until the
+           *          deadline of the next one. This can be used to drive the frames
+           *          from the calling thread instead of using `run`.
+           */
+          void
+          step();
+
+        private:
+
+          using Windows = std::unordered_map<utils::Uuid, DrawCallback>;
+
+          /**
+           * @brief - Renders frames until the scheduler is stopped.
+           */
+          void
+          loop();
+
+          /**
+           * @brief - Renders the input window, catching any error raised by its
+           *          callback or by the engine.
+           * @param uuid - the identifier of the window.
+           * @param draw - the callback drawing the window.
+           */
+          void
+          render(const utils::Uuid& uuid,
+                 const DrawCallback& draw);
+
+        private:
+
+          EngineShPtr m_engine;
+
+          float m_rate;
+          bool m_vsync;
+
+          /**
+           * @brief - The duration of a frame and the deadline of the next one.
+           */
+          std::chrono::steady_clock::duration m_period;
+          std::chrono::steady_clock::time_point m_deadline;
+
+          /**
+           * @brief - The windows to render, protected by the locker so that they
+           *          can be updated while frames are rendered.
+           */
+          std::mutex m_windowsLocker;
+          Windows m_windows;
+
+          /**
+           * @brief - The windows rendered during the current frame. Kept from one
+           *          frame to the next to avoid allocations.
+           */
+          std::vector<std::pair<utils::Uuid, DrawCallback>> m_frame;
+
+          std::atomic<bool> m_running;
+          std::thread m_thread;
+      };
+
+      using FrameSchedulerShPtr = std::shared_ptr<FrameScheduler>;
+    }
+  }
+}
+
+# include "FrameScheduler.hxx"
+
+#endif    /* FRAME_SCHEDULER_HH */
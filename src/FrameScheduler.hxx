@@ -0,0 +1,32 @@
+#ifndef    FRAME_SCHEDULER_HXX
+# define   FRAME_SCHEDULER_HXX
+
+# include "FrameScheduler.hh"
+
+namespace sdl {
+  namespace core {
+    namespace engine {
+
+      inline
+      FrameScheduler::~FrameScheduler() {
+        stop();
+      }
+
+      inline
+      void
+      FrameScheduler::removeWindow(const utils::Uuid& uuid) {
+        const std::lock_guard guard(m_windowsLocker);
+        m_windows.erase(uuid);
+      }
+
+      inline
+      bool
+      FrameScheduler::isRunning() const noexcept {
+        return m_running.load();
+      }
+
+    }
+  }
+}
+
+#endif    /* FRAME_SCHEDULER_HXX */
@@ -0,0 +1,34 @@
+
+# include "FrameStats.hh"
+# include <cmath>
+
+namespace sdl {
+  namespace core {
+    namespace engine {
+
+      float
+      FrameHistogram::percentile(float perc) const noexcept {
+        if (m_frames == 0u) {
+          return 0.0f;
+        }
+
+        // Find the first bucket such that the requested amount of frames are
+        // at most as long as the frames it contains. We report the upper bound
+        // of the bucket, except for the last one which has none.
+        const unsigned target = std::max(1u, static_cast<unsigned>(std::ceil(perc * m_frames)));
+        unsigned count = 0u;
+
+        for (unsigned id = 0u ; id < sk_bucketsCount - 1u ; ++id) {
+          count += m_buckets[id];
+
+          if (count >= target) {
+            return std::min(m_max, (id + 1u) * sk_resolution);
+          }
+        }
+
+        return m_max;
+      }
+
+    }
+  }
+}
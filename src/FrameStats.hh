@@ -0,0 +1,91 @@
+#ifndef    FRAME_STATS_HH
+# define   FRAME_STATS_HH
+
+# include <array>
+
+namespace sdl {
+  namespace core {
+    namespace engine {
+
+      /**
+       * @brief - Summary of the durations of the frames presented by a window.
+       *          All the durations are expressed in milliseconds.
+       */
+      struct FrameStats {
+        unsigned frames;
+        unsigned missed;
+
+        float p50;
+        float p95;
+        float p99;
+        float max;
+      };
+
+      /**
+       * @brief - Histogram of frame durations. The durations are accumulated in
+       *          buckets of fixed width so that recording a frame is constant
+       *          time and does not allocate memory. The percentiles computed from
+       *          the histogram are thus precise up to the width of a bucket.
+       */
+      class FrameHistogram {
+        public:
+
+          FrameHistogram() noexcept;
+
+          /**
+           * @brief - Records a new frame.
+           * @param duration - the duration of the frame in milliseconds.
+           * @param missed - whether the frame missed its deadline.
+           */
+          void
+          record(float duration,
+                 bool missed) noexcept;
+
+          /**
+           * @brief - Discards all the frames recorded so far.
+           */
+          void
+          reset() noexcept;
+
+          /**
+           * @brief - Computes the statistics of the frames recorded so far.
+           * @return - the statistics of the recorded frames.
+           */
+          FrameStats
+          getStats() const noexcept;
+
+        private:
+
+          /**
+           * @brief - The width of a bucket in milliseconds and the number of buckets.
+           *          Durations larger than what the buckets cover are accumulated in
+           *          the last one.
+           */
+          static constexpr float sk_resolution = 0.1f;
+          static constexpr unsigned sk_bucketsCount = 1000u;
+
+          /**
+           * @brief - Computes the duration below which the input percentage of the
+           *          frames fall.
+           * @param perc - the percentage of frames, in the range `[0; 1]`.
+           * @return - the corresponding duration in milliseconds.
+           */
+          float
+          percentile(float perc) const noexcept;
+
+        private:
+
+          std::array<unsigned, sk_bucketsCount> m_buckets;
+
+          unsigned m_frames;
+          unsigned m_missed;
+          float m_max;
+      };
+
+    }
+  }
+}
+
+# include "FrameStats.hxx"
+
+#endif    /* FRAME_STATS_HH */
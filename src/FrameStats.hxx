@@ -0,0 +1,66 @@
+#ifndef    FRAME_STATS_HXX
+# define   FRAME_STATS_HXX
+
+# include "FrameStats.hh"
+# include <algorithm>
+
+namespace sdl {
+  namespace core {
+    namespace engine {
+
+      inline
+      FrameHistogram::FrameHistogram() noexcept:
+        m_buckets(),
+
+        m_frames(0u),
+        m_missed(0u),
+        m_max(0.0f)
+      {
+        m_buckets.fill(0u);
+      }
+
+      inline
+      void
+      FrameHistogram::record(float duration,
+                             bool missed) noexcept
+      {
+        const unsigned bucket = static_cast<unsigned>(std::max(0.0f, duration) / sk_resolution);
+        ++m_buckets[std::min(bucket, sk_bucketsCount - 1u)];
+
+        ++m_frames;
+        if (missed) {
+          ++m_missed;
+        }
+
+        m_max = std::max(m_max, duration);
+      }
+
+      inline
+      void
+      FrameHistogram::reset() noexcept {
+        m_buckets.fill(0u);
+
+        m_frames = 0u;
+        m_missed = 0u;
+        m_max = 0.0f;
+      }
+
+      inline
+      FrameStats
+      FrameHistogram::getStats() const noexcept {
+        return FrameStats{
+          m_frames,
+          m_missed,
+
+          percentile(0.5f),
+          percentile(0.95f),
+          percentile(0.99f),
+          m_max
+        };
+      }
+
+    }
+  }
+}
+
+#endif    /* FRAME_STATS_HXX */
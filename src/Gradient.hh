@@ -5,8 +5,10 @@
 # include <memory>
 # include <string>
 # include <vector>
+# include <cstdint>
 # include <core_utils/CoreObject.hh>
 # include "Color.hh"
+# include "PackedColor.hh"
 
 namespace sdl {
   namespace core {
@@ -71,6 +73,25 @@ namespace sdl {
           gradient::Mode
           getMode() const noexcept;
 
+          /**
+           * @brief - Retrieves the angle of the gradient. This is only relevant for
+           *          linear gradients and indicates the direction along which the
+           *          colors vary.
+           * @return - the angle of the gradient in degrees.
+           */
+          float
+          getAngle() const noexcept;
+
+          /**
+           * @brief - Defines the angle of the gradient. An angle of `0` (which is the
+           *          default) produces a horizontal gradient going from left to right
+           *          while an angle of `90` produces a vertical gradient going from the
+           *          bottom to the top. This is ignored for radial gradients.
+           * @param angle - the angle of the gradient in degrees.
+           */
+          void
+          setAngle(float angle) noexcept;
+
           /**
            * @brief - Retrieves the list of stops registered for this gradient.
            *          Note that the value is copied so cache the returned value
@@ -95,6 +116,16 @@ namespace sdl {
           setColorAt(float coord,
                      const Color& color);
 
+          /**
+           * @brief - Similar to the above method but the color is provided in its
+           *          packed representation.
+           * @param coord - the coordinate at which the color should be added.
+           * @param color - the color to add.
+           */
+          void
+          setColorAt(float coord,
+                     const PackedColor& color);
+
           /**
            * @brief - Used to make the gradient wrap. This means adding a stop at
            *          max coordinates (usually `1`) with a color identical to the
@@ -118,8 +149,84 @@ namespace sdl {
           Color
           getColorAt(float coord) const noexcept;
 
+          /**
+           * @brief - Creates a copy of this gradient. The copy is independent from this
+           *          gradient: further modifications of either of them do not impact
+           *          the other one.
+           * @return - a copy of this gradient.
+           */
+          std::shared_ptr<Gradient>
+          clone() const;
+
+          /**
+           * @brief - Used to sample the gradient at regularly spaced coordinates. The
+           *          color of the `i`-th element is the color of the gradient at the
+           *          coordinate `start + (first + i) * step`. The value of a sample
+           *          only depends on its index so that a span can be filled in several
+           *          parts and yield the exact same colors.
+           *          As opposed to `getColorAt` the colors are read from a table of
+           *          precomputed values which is built when the stops change: this
+           *          makes it suited to fill many pixels at once.
+           *          Colors are packed as `0xAARRGGBB` values which corresponds to the
+           *          `SDL_PIXELFORMAT_ARGB8888` format.
+           * @param start - the coordinate of the first sample.
+           * @param step - the distance between two consecutive samples.
+           * @param out - the output array receiving the samples. It should be large
+           *              enough to contain at least `count` elements.
+           * @param count - the number of samples to compute.
+           * @param first - the index of the first sample to compute.
+           */
+          void
+          fillSpan(float start,
+                   float step,
+                   std::uint32_t* out,
+                   unsigned count,
+                   unsigned first = 0u) const;
+
+          /**
+           * @brief - Similar to `fillSpan` but the coordinate of each sample is the
+           *          distance to the origin of the position `(x + i, y)`, multiplied
+           *          by the `scale`. This is used to render radial gradients.
+           * @param x - the abscissa of the first sample relatively to the origin.
+           * @param y - the ordinate of the samples relatively to the origin.
+           * @param scale - the factor to apply to the distance to get a coordinate
+           *                in the range `[0; 1]`.
+           * @param out - the output array receiving the samples.
+           * @param count - the number of samples to compute.
+           */
+          void
+          fillRadialSpan(float x,
+                         float y,
+                         float scale,
+                         std::uint32_t* out,
+                         unsigned count) const;
+
         private:
 
+          /**
+           * @brief - Similar to `getColorAt` but assumes that the locker is already
+           *          acquired.
+           * @param coord - the coordinate at which the color should be retrieved.
+           * @return - the color at the specified coordinate or transparent black.
+           */
+          Color
+          computeColorAt(float coord) const noexcept;
+
+          /**
+           * @brief - Convenience define for the table of colors of the gradient.
+           */
+          using Table = std::vector<std::uint32_t>;
+          using TableShPtr = std::shared_ptr<const Table>;
+
+          /**
+           * @brief - Builds the table of colors used by `fillSpan` if it is not up to
+           *          date and returns it. Acquires the locker: the returned table can
+           *          be used without holding the locker as it is never modified.
+           * @return - the table of colors.
+           */
+          TableShPtr
+          bake() const;
+
           /**
            * @brief - Retrieves the comparison threshold when trying to replace a
            *          color by a new one. Basically when two stops are closer than
@@ -194,6 +301,24 @@ namespace sdl {
            * @brief - The list of stops currently registered for this gradient.
            */
           gradient::Stops m_stops;
+
+          /**
+           * @brief - The number of entries of the table of colors.
+           */
+          static constexpr unsigned sk_tableSize = 1024u;
+
+          /**
+           * @brief - The angle of the gradient in degrees.
+           */
+          float m_angle;
+
+          /**
+           * @brief - A table of colors sampling the gradient at regular intervals in
+           *          the range `[0; 1]`. It is built lazily and reset when the stops
+           *          change. A new table is created each time so that users can keep
+           *          reading the previous one without holding the locker.
+           */
+          mutable TableShPtr m_table;
       };
 
       using GradientShPtr = std::shared_ptr<Gradient>;
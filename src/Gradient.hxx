@@ -15,6 +15,30 @@ namespace sdl {
         return m_mode;
       }
 
+      inline
+      float
+      Gradient::getAngle() const noexcept {
+        const std::lock_guard guard(m_propsLocker);
+
+        return m_angle;
+      }
+
+      inline
+      void
+      Gradient::setAngle(float angle) noexcept {
+        const std::lock_guard guard(m_propsLocker);
+
+        m_angle = angle;
+      }
+
+      inline
+      void
+      Gradient::setColorAt(float coord,
+                           const PackedColor& color)
+      {
+        setColorAt(coord, color.toColor());
+      }
+
       inline
       gradient::Stops
       Gradient::getStops() const noexcept {
@@ -33,10 +33,10 @@ namespace sdl {
         }
       }
 
-      std::vector<EventShPtr>
-      MouseState::updateEvent(MouseEvent& event) {
-        std::vector<EventShPtr> newEvents;
-
+      void
+      MouseState::updateEvent(MouseEvent& event,
+                              std::vector<EventShPtr>& newEvents)
+      {
         // Call the dedicated handler.
         switch (event.getType()) {
           case Event::Type::MouseDrag:
@@ -58,9 +58,6 @@ namespace sdl {
             // is a mouse event already.
             break;
         }
-
-        // Return the new events created by the update.
-        return newEvents;
       }
 
       utils::Uuid
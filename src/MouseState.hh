@@ -43,14 +43,17 @@ namespace sdl {
            *          Some event might also trigger some new events which are
            *          used to refine the engine's information with some more
            *          context.
+           *          Such events are appended to the output vector so that
+           *          callers can reuse the same buffer.
            * @param event - the mouse event to use to update the internal state.
            *                It can be modified in some occasions.
-           * @return - a list of events (which may be empty) containing all
-           *           the events generated from the information conveyed by
-           *           the input mouse event.
+           * @param newEvents - output vector to which all the events generated
+           *                    from the information conveyed by the input mouse
+           *                    event are appended.
            */
-          std::vector<EventShPtr>
-          updateEvent(MouseEvent& event);
+          void
+          updateEvent(MouseEvent& event,
+                      std::vector<EventShPtr>& newEvents);
 
           /**
            * @brief - Used to try to guess a valid window identifier for the
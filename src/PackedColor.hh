@@ -0,0 +1,141 @@
+#ifndef    PACKED_COLOR_HH
+# define   PACKED_COLOR_HH
+
+# include <memory>
+# include <string>
+# include <cstdint>
+# include <SDL2/SDL.h>
+# include "Color.hh"
+
+namespace sdl {
+  namespace core {
+    namespace engine {
+
+      /**
+       * @brief - A color stored on 32 bits with 8 bits per channel, packed as
+       *          `0xAARRGGBB` (i.e. `SDL_PIXELFORMAT_ARGB8888`). This is the
+       *          format used by the brushes, gradients and raw surfaces: it is
+       *          four times smaller than a `Color` and can be compared with a
+       *          single integer comparison.
+       *          Conversions from and to `SDL_Color` are exact while converting
+       *          from a `Color` rounds the channels like `Color::toSDLColor`.
+       */
+      class PackedColor {
+        public:
+
+          /**
+           * @brief - Creates an opaque black color.
+           */
+          constexpr
+          PackedColor() noexcept;
+
+          /**
+           * @brief - Creates a color from its packed representation.
+           * @param argb - the color packed as `0xAARRGGBB`.
+           */
+          explicit constexpr
+          PackedColor(std::uint32_t argb) noexcept;
+
+          /**
+           * @brief - Creates a color from its individual channels.
+           * @param r - the red channel.
+           * @param g - the green channel.
+           * @param b - the blue channel.
+           * @param a - the alpha channel, opaque by default.
+           */
+          constexpr
+          PackedColor(std::uint8_t r,
+                      std::uint8_t g,
+                      std::uint8_t b,
+                      std::uint8_t a = SDL_ALPHA_OPAQUE) noexcept;
+
+          /**
+           * @brief - Creates a packed color from the input SDL color.
+           * @param color - the color to convert.
+           */
+          constexpr
+          PackedColor(const SDL_Color& color) noexcept;
+
+          /**
+           * @brief - Creates a packed color from the input color. The channels are
+           *          rounded like `Color::toSDLColor` does.
+           * @param color - the color to convert.
+           */
+          PackedColor(const Color& color) noexcept;
+
+          /**
+           * @brief - Creates a packed color from floating point channels in the
+           *          range `[0; 1]`. Values outside of this range are clamped and
+           *          the channels are rounded like `Color::toSDLColor` does.
+           * @param r - the red channel.
+           * @param g - the green channel.
+           * @param b - the blue channel.
+           * @param a - the alpha channel.
+           * @return - the packed color.
+           */
+          static
+          PackedColor
+          fromRGBA(float r,
+                   float g,
+                   float b,
+                   float a) noexcept;
+
+          constexpr bool
+          operator==(const PackedColor& rhs) const noexcept;
+
+          constexpr bool
+          operator!=(const PackedColor& rhs) const noexcept;
+
+          /**
+           * @brief - Returns the packed representation of this color.
+           * @return - the color as `0xAARRGGBB`.
+           */
+          constexpr std::uint32_t
+          value() const noexcept;
+
+          constexpr std::uint8_t
+          r() const noexcept;
+
+          constexpr std::uint8_t
+          g() const noexcept;
+
+          constexpr std::uint8_t
+          b() const noexcept;
+
+          constexpr std::uint8_t
+          a() const noexcept;
+
+          constexpr SDL_Color
+          toSDLColor() const noexcept;
+
+          Color
+          toColor() const noexcept;
+
+          std::string
+          toString() const noexcept;
+
+        private:
+
+          /**
+           * @brief - Converts a floating point channel to its 8 bits value.
+           * @param v - the value of the channel.
+           * @return - the 8 bits value of the channel.
+           */
+          static
+          std::uint8_t
+          quantize(float v) noexcept;
+
+        private:
+
+          std::uint32_t m_argb;
+      };
+
+      static_assert(sizeof(PackedColor) == sizeof(std::uint32_t), "PackedColor should be 32 bits");
+
+    }
+  }
+}
+
+# include "PackedColor.hxx"
+
+#endif    /* PACKED_COLOR_HH */
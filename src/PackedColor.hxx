@@ -0,0 +1,133 @@
+#ifndef    PACKED_COLOR_HXX
+# define   PACKED_COLOR_HXX
+
+# include <algorithm>
+# include "PackedColor.hh"
+
+namespace sdl {
+  namespace core {
+    namespace engine {
+
+      inline
+      constexpr
+      PackedColor::PackedColor() noexcept:
+        m_argb(0xFF000000u)
+      {}
+
+      inline
+      constexpr
+      PackedColor::PackedColor(std::uint32_t argb) noexcept:
+        m_argb(argb)
+      {}
+
+      inline
+      constexpr
+      PackedColor::PackedColor(std::uint8_t r,
+                               std::uint8_t g,
+                               std::uint8_t b,
+                               std::uint8_t a) noexcept:
+        m_argb(
+          (static_cast<std::uint32_t>(a) << 24) |
+          (static_cast<std::uint32_t>(r) << 16) |
+          (static_cast<std::uint32_t>(g) << 8) |
+          static_cast<std::uint32_t>(b)
+        )
+      {}
+
+      inline
+      constexpr
+      PackedColor::PackedColor(const SDL_Color& color) noexcept:
+        PackedColor(color.r, color.g, color.b, color.a)
+      {}
+
+      inline
+      PackedColor::PackedColor(const Color& color) noexcept:
+        PackedColor(fromRGBA(color.r(), color.g(), color.b(), color.a()))
+      {}
+
+      inline
+      PackedColor
+      PackedColor::fromRGBA(float r,
+                            float g,
+                            float b,
+                            float a) noexcept
+      {
+        return PackedColor(quantize(r), quantize(g), quantize(b), quantize(a));
+      }
+
+      inline
+      constexpr bool
+      PackedColor::operator==(const PackedColor& rhs) const noexcept {
+        return m_argb == rhs.m_argb;
+      }
+
+      inline
+      constexpr bool
+      PackedColor::operator!=(const PackedColor& rhs) const noexcept {
+        return !operator==(rhs);
+      }
+
+      inline
+      constexpr std::uint32_t
+      PackedColor::value() const noexcept {
+        return m_argb;
+      }
+
+      inline
+      constexpr std::uint8_t
+      PackedColor::r() const noexcept {
+        return static_cast<std::uint8_t>((m_argb >> 16) & 0xFFu);
+      }
+
+      inline
+      constexpr std::uint8_t
+      PackedColor::g() const noexcept {
+        return static_cast<std::uint8_t>((m_argb >> 8) & 0xFFu);
+      }
+
+      inline
+      constexpr std::uint8_t
+      PackedColor::b() const noexcept {
+        return static_cast<std::uint8_t>(m_argb & 0xFFu);
+      }
+
+      inline
+      constexpr std::uint8_t
+      PackedColor::a() const noexcept {
+        return static_cast<std::uint8_t>((m_argb >> 24) & 0xFFu);
+      }
+
+      inline
+      constexpr SDL_Color
+      PackedColor::toSDLColor() const noexcept {
+        return SDL_Color{r(), g(), b(), a()};
+      }
+
+      inline
+      Color
+      PackedColor::toColor() const noexcept {
+        return Color::fromRGBA(r() / 255.0f, g() / 255.0f, b() / 255.0f, a() / 255.0f);
+      }
+
+      inline
+      std::string
+      PackedColor::toString() const noexcept {
+        return
+          std::string("[PackedColor: ") +
+          "r: " + std::to_string(r()) + ", " +
+          "g: " + std::to_string(g()) + ", " +
+          "b: " + std::to_string(b()) + ", " +
+          "a: " + std::to_string(a()) + "]";
+      }
+
+      inline
+      std::uint8_t
+      PackedColor::quantize(float v) noexcept {
+        return static_cast<std::uint8_t>(std::min(1.0f, std::max(0.0f, v)) * 255.0f);
+      }
+
+    }
+  }
+}
+
+#endif    /* PACKED_COLOR_HXX */
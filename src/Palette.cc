@@ -18,7 +18,7 @@ namespace sdl {
 
       void
       Palette::setColorForRole(const ColorRole& role,
-                               const Color& color)
+                               const Color& color) noexcept
       {
         // The input color is assumed to refer to the provided role for the
         // active color group.
@@ -40,9 +40,9 @@ namespace sdl {
         }
 
         // Set color for each color group.
-        setActiveColor(role, color);
-        setInactiveColor(role, inaColor);
-        setDisabledColor(role, disColor);
+        setColor(ColorGroup::Active, role, color);
+        setColor(ColorGroup::Inactive, role, inaColor);
+        setColor(ColorGroup::Disabled, role, disColor);
       }
 
       std::string
@@ -172,7 +172,7 @@ namespace sdl {
       }
 
       void
-      Palette::initFromButtonColor(const Color& color) {
+      Palette::initFromButtonColor(const Color& color) noexcept {
         // The `Background` color is identical to the input button's color.
         Color bg = color;
 
@@ -252,50 +252,25 @@ namespace sdl {
                                        const Color& mid,
                                        const Color& shadow,
                                        const Color& highlight,
-                                       const Color& highlightedText)
+                                       const Color& highlightedText) noexcept
       {
-        std::unordered_map<ColorRole, Color>* colors = nullptr;
-
-        switch (group) {
-          case ColorGroup::Disabled:
-            colors = &m_disabledColors;
-            break;
-          case ColorGroup::Inactive:
-            colors = &m_inactiveColors;
-            break;
-          case ColorGroup::Active:
-            colors = &m_activeColors;
-            break;
-          default:
-            break;
-        }
-
-        // Check whether the input color group is valid.
-        if (colors == nullptr) {
-          error(
-            std::string("Cannot assign color role from input color group ") + std::to_string(static_cast<int>(group)),
-            std::string("Unknown color group")
-          );
-        }
-
-        setColorForRoleAndGroup(*colors, ColorRole::Background, background);
-        setColorForRoleAndGroup(*colors, ColorRole::WindowText, windowText);
-        setColorForRoleAndGroup(*colors, ColorRole::Base, base);
-        setColorForRoleAndGroup(*colors, ColorRole::AlternateBase, alternateBase);
-        setColorForRoleAndGroup(*colors, ColorRole::Text, text);
-        setColorForRoleAndGroup(*colors, ColorRole::Button, button);
-        setColorForRoleAndGroup(*colors, ColorRole::ButtonText, buttonText);
-
-        setColorForRoleAndGroup(*colors, ColorRole::BrightText, brightText);
-        setColorForRoleAndGroup(*colors, ColorRole::Light, light);
-        setColorForRoleAndGroup(*colors, ColorRole::Dark, dark);
-        setColorForRoleAndGroup(*colors, ColorRole::Mid, mid);
-        setColorForRoleAndGroup(*colors, ColorRole::Shadow, shadow);
-        setColorForRoleAndGroup(*colors, ColorRole::Highlight, highlight);
-        setColorForRoleAndGroup(*colors, ColorRole::HighlightedText, highlightedText);
+        setColor(group, ColorRole::Background, background);
+        setColor(group, ColorRole::WindowText, windowText);
+        setColor(group, ColorRole::Base, base);
+        setColor(group, ColorRole::AlternateBase, alternateBase);
+        setColor(group, ColorRole::Text, text);
+        setColor(group, ColorRole::Button, button);
+        setColor(group, ColorRole::ButtonText, buttonText);
+
+        setColor(group, ColorRole::BrightText, brightText);
+        setColor(group, ColorRole::Light, light);
+        setColor(group, ColorRole::Dark, dark);
+        setColor(group, ColorRole::Mid, mid);
+        setColor(group, ColorRole::Shadow, shadow);
+        setColor(group, ColorRole::Highlight, highlight);
+        setColor(group, ColorRole::HighlightedText, highlightedText);
       }
 
     }
   }
 }
-
@@ -1,16 +1,26 @@
 #ifndef    PALETTE_HH
 # define   PALETTE_HH
 
+# include <array>
 # include <memory>
-# include <unordered_map>
-# include <core_utils/CoreObject.hh>
+# include <string>
+# include <cstdint>
+# include <type_traits>
+# include <SDL2/SDL.h>
 # include "Color.hh"
+# include "PackedColor.hh"
 
 namespace sdl {
   namespace core {
     namespace engine {
 
-      class Palette: public utils::CoreObject {
+      /**
+       * @brief - Associates a color to each role of an element, for each of the
+       *          possible states of the element. The colors are stored in flat
+       *          arrays indexed by the group and the role so that a palette can
+       *          be copied cheaply and queried without any lookup.
+       */
+      class Palette {
         public:
 
           enum class ColorRole {
@@ -39,49 +49,55 @@ namespace sdl {
 
         public:
 
+          /**
+           * @brief - The number of color roles and color groups.
+           */
+          static constexpr unsigned sk_rolesCount = 14u;
+          static constexpr unsigned sk_groupsCount = 3u;
+
           ~Palette() = default;
 
-          Color
-          getBackgroundColor() const;
+          const Color&
+          getBackgroundColor() const noexcept;
 
-          Color
-          getWindowTextColor() const;
+          const Color&
+          getWindowTextColor() const noexcept;
 
-          Color
-          getBaseColor() const;
+          const Color&
+          getBaseColor() const noexcept;
 
-          Color
-          getAlternateBaseColor() const;
+          const Color&
+          getAlternateBaseColor() const noexcept;
 
-          Color
-          getTextColor() const;
+          const Color&
+          getTextColor() const noexcept;
 
-          Color
-          getButtonColor() const;
+          const Color&
+          getButtonColor() const noexcept;
 
-          Color
-          getButtonTextColor() const;
+          const Color&
+          getButtonTextColor() const noexcept;
 
-          Color
-          getBrightTextColor() const;
+          const Color&
+          getBrightTextColor() const noexcept;
 
-          Color
-          getLightColor() const;
+          const Color&
+          getLightColor() const noexcept;
 
-          Color
-          getDarkColor() const;
+          const Color&
+          getDarkColor() const noexcept;
 
-          Color
-          getMidColor() const;
+          const Color&
+          getMidColor() const noexcept;
 
-          Color
-          getShadowColor() const;
+          const Color&
+          getShadowColor() const noexcept;
 
-          Color
-          getHighlightColor() const;
+          const Color&
+          getHighlightColor() const noexcept;
 
-          Color
-          getHighlightedTextColor() const;
+          const Color&
+          getHighlightedTextColor() const noexcept;
 
           ColorGroup
           getActiveGroup() const noexcept;
@@ -89,12 +105,51 @@ namespace sdl {
           void
           setActiveGroup(const ColorGroup& group) noexcept;
 
-          Color
-          getColorForRole(const ColorRole& role) const;
+          const Color&
+          getColorForRole(const ColorRole& role) const noexcept;
 
-          Color
+          const Color&
           getColorForRole(const ColorGroup& group,
-                          const ColorRole& role) const;
+                          const ColorRole& role) const noexcept;
+
+          /**
+           * @brief - Similar to `getColorForRole` but returns the color already
+           *          converted to a `SDL_Color`. The conversion is performed when
+           *          the color is set so this is just a lookup.
+           * @param role - the role for which the color should be retrieved.
+           * @return - the color for this role in the active group.
+           */
+          SDL_Color
+          getSDLColorForRole(const ColorRole& role) const noexcept;
+
+          /**
+           * @brief - Similar to `getSDLColorForRole` for the specified group.
+           * @param group - the group for which the color should be retrieved.
+           * @param role - the role for which the color should be retrieved.
+           * @return - the color for this role in the specified group.
+           */
+          SDL_Color
+          getSDLColorForRole(const ColorGroup& group,
+                             const ColorRole& role) const noexcept;
+
+          /**
+           * @brief - Returns the color for the role in the active group packed as
+           *          `0xAARRGGBB`, the format used by the brushes and gradients.
+           * @param role - the role for which the color should be retrieved.
+           * @return - the packed color for this role.
+           */
+          std::uint32_t
+          getPackedColorForRole(const ColorRole& role) const noexcept;
+
+          /**
+           * @brief - Similar to `getPackedColorForRole` for the specified group.
+           * @param group - the group for which the color should be retrieved.
+           * @param role - the role for which the color should be retrieved.
+           * @return - the packed color for this role in the specified group.
+           */
+          std::uint32_t
+          getPackedColorForRole(const ColorGroup& group,
+                                const ColorRole& role) const noexcept;
 
           static
           Palette
@@ -109,7 +164,7 @@ namespace sdl {
            */
           void
           setColorForRole(const ColorRole& role,
-                          const Color& color);
+                          const Color& color) noexcept;
 
           /**
            * @brief - Dumps all the color for this palette in a human-readable
@@ -127,40 +182,26 @@ namespace sdl {
 
         private:
 
-          Palette(const std::string& name = std::string("Palette"));
-
-          Color
-          getDisabledColorFromRole(const ColorRole& role) const;
-
-          Color
-          getInactiveColorFromRole(const ColorRole& role) const;
-
-          Color
-          getActiveColorFromRole(const ColorRole& role) const;
-
-          Color
-          getColorFromRole(const std::unordered_map<ColorRole, Color>& colors,
-                           const ColorRole& role) const;
-
-          void
-          initFromButtonColor(const Color& color);
-
-          void
-          setDisabledColor(const ColorRole& role,
-                           const Color& color) noexcept;
-
-          void
-          setInactiveColor(const ColorRole& role,
-                           const Color& color) noexcept;
+          /**
+           * @brief - Creates a palette where all the roles are associated to the
+           *          default color. Use `fromButtonColor` to create a palette.
+           */
+          Palette() noexcept;
 
           void
-          setActiveColor(const ColorRole& role,
-                         const Color& color) noexcept;
+          initFromButtonColor(const Color& color) noexcept;
 
+          /**
+           * @brief - Assigns the color for the role in the specified group and
+           *          updates the converted versions of the color.
+           * @param group - the group for which the color should be set.
+           * @param role - the role for which the color should be set.
+           * @param color - the color to assign.
+           */
           void
-          setColorForRoleAndGroup(std::unordered_map<ColorRole, Color>& colorGroup,
-                                  const ColorRole& role,
-                                  const Color& color) noexcept;
+          setColor(const ColorGroup& group,
+                   const ColorRole& role,
+                   const Color& color) noexcept;
 
           void
           setColorGroupFromColors(const ColorGroup& group,
@@ -177,7 +218,7 @@ namespace sdl {
                                   const Color& mid,
                                   const Color& shadow,
                                   const Color& highlight,
-                                  const Color& highlightedText);
+                                  const Color& highlightedText) noexcept;
 
           void
           copyInactiveFromActiveColorGroup() noexcept;
@@ -194,13 +235,27 @@ namespace sdl {
 
         private:
 
+          /**
+           * @brief - Convenience define to store a value for each role of each group.
+           *          The values are indexed by the group and then by the role.
+           */
+          template <typename T>
+          using Table = std::array<std::array<T, sk_rolesCount>, sk_groupsCount>;
+
           ColorGroup m_activeGroup;
-          std::unordered_map<ColorRole, Color> m_disabledColors;
-          std::unordered_map<ColorRole, Color> m_inactiveColors;
-          std::unordered_map<ColorRole, Color> m_activeColors;
 
+          /**
+           * @brief - The colors of each role along with their conversion to a SDL
+           *          color and to a packed value. They are kept in sync by the
+           *          `setColor` method.
+           */
+          Table<Color> m_colors;
+          Table<SDL_Color> m_sdlColors;
+          Table<std::uint32_t> m_packedColors;
       };
 
+      static_assert(std::is_trivially_copyable<Palette>::value, "Palette should be trivially copyable");
+
       using PaletteShPtr = std::shared_ptr<Palette>;
     }
   }
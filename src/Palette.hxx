@@ -8,97 +8,102 @@ namespace sdl {
     namespace engine {
 
       inline
-      Palette::Palette(const std::string& name):
-        utils::CoreObject(name),
+      Palette::Palette() noexcept:
         m_activeGroup(ColorGroup::Active),
-        m_disabledColors(),
-        m_inactiveColors(),
-        m_activeColors()
+
+        m_colors(),
+        m_sdlColors(),
+        m_packedColors()
       {
-        setService(std::string("palette"));
+        // Make sure that the converted colors match the default ones.
+        for (unsigned group = 0u ; group < sk_groupsCount ; ++group) {
+          for (unsigned role = 0u ; role < sk_rolesCount ; ++role) {
+            setColor(static_cast<ColorGroup>(group), static_cast<ColorRole>(role), Color());
+          }
+        }
       }
 
       inline
-      Color
-      Palette::getBackgroundColor() const {
+      const Color&
+      Palette::getBackgroundColor() const noexcept {
         return getColorForRole(ColorRole::Background);
       }
 
       inline
-      Color
-      Palette::getWindowTextColor() const {
+      const Color&
+      Palette::getWindowTextColor() const noexcept {
         return getColorForRole(ColorRole::WindowText);
       }
 
       inline
-      Color
-      Palette::getBaseColor() const {
+      const Color&
+      Palette::getBaseColor() const noexcept {
         return getColorForRole(ColorRole::Base);
       }
 
       inline
-      Color
-      Palette::getAlternateBaseColor() const {
+      const Color&
+      Palette::getAlternateBaseColor() const noexcept {
         return getColorForRole(ColorRole::AlternateBase);
       }
 
       inline
-      Color
-      Palette::getTextColor() const {
+      const Color&
+      Palette::getTextColor() const noexcept {
         return getColorForRole(ColorRole::Text);
       }
 
       inline
-      Color
-      Palette::getButtonColor() const {
+      const Color&
+      Palette::getButtonColor() const noexcept {
         return getColorForRole(ColorRole::Button);
       }
 
       inline
-      Color
-      Palette::getButtonTextColor() const {
+      const Color&
+      Palette::getButtonTextColor() const noexcept {
         return getColorForRole(ColorRole::ButtonText);
       }
 
       inline
-      Color
-      Palette::getBrightTextColor() const {
+      const Color&
+      Palette::getBrightTextColor() const noexcept {
         return getColorForRole(ColorRole::BrightText);
       }
 
       inline
-      Color
-      Palette::getLightColor() const {
+      const Color&
+      Palette::getLightColor() const noexcept {
         return getColorForRole(ColorRole::Light);
       }
 
       inline
-      Color
-      Palette::getDarkColor() const {
+      const Color&
+      Palette::getDarkColor() const noexcept {
         return getColorForRole(ColorRole::Dark);
       }
 
       inline
-      Color
-      Palette::getMidColor() const {
+      const Color&
+      Palette::getMidColor() const noexcept {
         return getColorForRole(ColorRole::Mid);
       }
 
       inline
-      Color
-      Palette::getShadowColor() const {
+      const Color&
+      Palette::getShadowColor() const noexcept {
         return getColorForRole(ColorRole::Shadow);
       }
 
       inline
-      Color
-      Palette::getHighlightColor() const {
+      const Color&
+      Palette::getHighlightColor() const noexcept {
         return getColorForRole(ColorRole::Highlight);
       }
 
       inline
-      Color
-      Palette::getHighlightedTextColor() const {
+      const Color&
+      Palette::getHighlightedTextColor() const noexcept {
         return getColorForRole(ColorRole::HighlightedText);
       }
 
@@ -115,113 +120,73 @@ namespace sdl {
       }
 
       inline
-      Color
-      Palette::getColorForRole(const ColorRole& role) const {
+      const Color&
+      Palette::getColorForRole(const ColorRole& role) const noexcept {
         // Use the active group to retrieve the corresponding color.
         return getColorForRole(getActiveGroup(), role);
       }
 
       inline
-      Color
+      const Color&
       Palette::getColorForRole(const ColorGroup& group,
-                               const ColorRole& role) const
+                               const ColorRole& role) const noexcept
       {
-        // Retrieve the correct color based on the group.
-        switch (group) {
-          case ColorGroup::Disabled:
-            return getDisabledColorFromRole(role);
-          case ColorGroup::Inactive:
-            return getInactiveColorFromRole(role);
-          case ColorGroup::Active:
-            return getActiveColorFromRole(role);
-          default:
-            break;
-        }
-
-        // This is a problem.
-        error(
-          std::string("Cannot retrieve color for role ") + std::to_string(static_cast<int>(role)) + " in group " + std::to_string(static_cast<int>(group)),
-          std::string("Unknown color group")
-        );
-
-        // Silent the compiler's complaint.
-        return Color::NamedColor::Black;
-      }
-
-      inline
-      Color
-      Palette::getDisabledColorFromRole(const ColorRole& role) const {
-        return getColorFromRole(m_disabledColors, role);
-      }
-
-      inline
-      Color
-      Palette::getInactiveColorFromRole(const ColorRole& role) const {
-        return getColorFromRole(m_inactiveColors, role);
+        return m_colors[static_cast<unsigned>(group)][static_cast<unsigned>(role)];
       }
 
       inline
-      Color
-      Palette::getActiveColorFromRole(const ColorRole& role) const {
-        return getColorFromRole(m_activeColors, role);
+      SDL_Color
+      Palette::getSDLColorForRole(const ColorRole& role) const noexcept {
+        return getSDLColorForRole(getActiveGroup(), role);
       }
 
       inline
-      Color
-      Palette::getColorFromRole(const std::unordered_map<ColorRole, Color>& colors,
-                                const ColorRole& role) const
+      SDL_Color
+      Palette::getSDLColorForRole(const ColorGroup& group,
+                                  const ColorRole& role) const noexcept
       {
-        const std::unordered_map<ColorRole, Color>::const_iterator color = colors.find(role);
-
-        // Check whether this role is available.
-        if (color == colors.cend()) {
-          error(
-            std::string("Cannot retrieve color role ") + std::to_string(static_cast<int>(role)),
-            std::string("Empty role")
-          );
-        }
-
-        // Return the color for this role.
-        return color->second;
+        return m_sdlColors[static_cast<unsigned>(group)][static_cast<unsigned>(role)];
       }
 
       inline
-      void
-      Palette::setDisabledColor(const ColorRole& role,
-                                const Color& color) noexcept
-      {
-        setColorForRoleAndGroup(m_disabledColors, role, color);
+      std::uint32_t
+      Palette::getPackedColorForRole(const ColorRole& role) const noexcept {
+        return getPackedColorForRole(getActiveGroup(), role);
       }
 
       inline
-      void
-      Palette::setInactiveColor(const ColorRole& role,
-                                const Color& color) noexcept
+      std::uint32_t
+      Palette::getPackedColorForRole(const ColorGroup& group,
+                                     const ColorRole& role) const noexcept
       {
-        setColorForRoleAndGroup(m_inactiveColors, role, color);
+        return m_packedColors[static_cast<unsigned>(group)][static_cast<unsigned>(role)];
       }
 
       inline
       void
-      Palette::setActiveColor(const ColorRole& role,
-                              const Color& color) noexcept
+      Palette::setColor(const ColorGroup& group,
+                        const ColorRole& role,
+                        const Color& color) noexcept
       {
-        setColorForRoleAndGroup(m_activeColors, role, color);
-      }
+        const unsigned g = static_cast<unsigned>(group);
+        const unsigned r = static_cast<unsigned>(role);
 
-      inline
-      void
-      Palette::setColorForRoleAndGroup(std::unordered_map<ColorRole, Color>& colorGroup,
-                                       const ColorRole& role,
-                                       const Color& color) noexcept
-      {
-        colorGroup[role] = color;
+        const PackedColor packed(color);
+
+        m_colors[g][r] = color;
+        m_sdlColors[g][r] = packed.toSDLColor();
+        m_packedColors[g][r] = packed.value();
       }
 
       inline
       void
       Palette::copyInactiveFromActiveColorGroup() noexcept {
-        m_inactiveColors = m_activeColors;
+        const unsigned from = static_cast<unsigned>(ColorGroup::Active);
+        const unsigned to = static_cast<unsigned>(ColorGroup::Inactive);
+
+        m_colors[to] = m_colors[from];
+        m_sdlColors[to] = m_sdlColors[from];
+        m_packedColors[to] = m_packedColors[from];
       }
 
       inline
@@ -0,0 +1,680 @@
+
+# include "ProfilingEngineDecorator.hh"
+# include <thread>
+# include <cstdlib>
+# include <fstream>
+# include <functional>
+# include <core_utils/SafetyNet.hh>
+
+namespace {
+
+  /**
+   * @brief - Retrieves the value of the input environment variable.
+   * @param name - the name of the variable.
+   * @return - the value of the variable or an empty string if it is not set.
+   */
+  std::string
+  getEnvironment(const char* name) {
+    const char* value = std::getenv(name);
+    return (value == nullptr ? std::string() : std::string(value));
+  }
+
+  /**
+   * @brief - Whether the profiling is requested by the environment.
+   * @return - `true` if the profiling should be enabled.
+   */
+  bool
+  isProfilingRequested() {
+    const std::string profiling = getEnvironment("SDL_ENGINE_PROFILING");
+    return (!profiling.empty() && profiling != "0") || !getEnvironment("SDL_ENGINE_TRACE").empty();
+  }
+
+  /**
+   * @brief - Converts the input duration in nanoseconds into microseconds as
+   *          expected by the trace event format.
+   * @param ns - the duration in nanoseconds.
+   * @return - a string representing the duration in microseconds.
+   */
+  std::string
+  toMicroseconds(std::uint64_t ns) {
+    return std::to_string(ns / 1000u) + "." + std::to_string(ns % 1000u / 100u);
+  }
+
+}
+
+namespace sdl {
+  namespace core {
+    namespace engine {
+
+      ProfilingEngineDecorator::ProfilingEngineDecorator(EngineShPtr engine,
+                                                         const std::string& name):
+        EngineDecorator(engine, name),
+
+        m_enabled(isProfilingRequested()),
+        m_tracing(false),
+        m_traceFile(getEnvironment("SDL_ENGINE_TRACE")),
+
+        m_counters(),
+
+        m_createdTextures(0u),
+        m_destroyedTextures(0u),
+        m_createdBytes(0u),
+        m_liveBytes(0u),
+
+        m_texturesLocker(),
+        m_textures(),
+
+        m_origin(Clock::now()),
+
+        m_traceLocker(),
+        m_spans(),
+        m_droppedSpans(0u)
+      {
+        setService("profiling");
+
+        m_tracing = !m_traceFile.empty();
+      }
+
+      ProfilingEngineDecorator::~ProfilingEngineDecorator() {
+        if (!m_traceFile.empty()) {
+          writeTrace(m_traceFile);
+        }
+      }
+
+      std::string
+      ProfilingEngineDecorator::getNameFromMethod(const Method& method) noexcept {
+        switch (method) {
+          case Method::CreateWindow:
+            return "createWindow";
+          case Method::SetWindowIcon:
+            return "setWindowIcon";
+          case Method::ClearWindow:
+            return "clearWindow";
+          case Method::RenderWindow:
+            return "renderWindow";
+          case Method::UpdateViewport:
+            return "updateViewport";
+          case Method::SetWindowRetained:
+            return "setWindowRetained";
+          case Method::InvalidateWindow:
+            return "invalidateWindow";
+          case Method::SetWindowFramePacing:
+            return "setWindowFramePacing";
+          case Method::GetWindowFrameStats:
+            return "getWindowFrameStats";
+          case Method::GetWindowDamageStats:
+            return "getWindowDamageStats";
+          case Method::ReadWindowPixels:
+            return "readWindowPixels";
+          case Method::DestroyWindow:
+            return "destroyWindow";
+          case Method::CreateTexture:
+            return "createTexture";
+          case Method::CreateTextureFromFile:
+            return "createTextureFromFile";
+          case Method::CreateTextureFromFileAsync:
+            return "createTextureFromFileAsync";
+          case Method::CreateTextureFromText:
+            return "createTextureFromText";
+          case Method::CreateTextureFromBrush:
+            return "createTextureFromBrush";
+          case Method::FillTexture:
+            return "fillTexture";
+          case Method::SetTextureAlpha:
+            return "setTextureAlpha";
+          case Method::GetTextureRole:
+            return "getTextureRole";
+          case Method::SetTextureRole:
+            return "setTextureRole";
+          case Method::DrawTexture:
+            return "drawTexture";
+          case Method::QueryTexture:
+            return "queryTexture";
+          case Method::GetTextSize:
+            return "getTextSize";
+          case Method::DestroyTexture:
+            return "destroyTexture";
+          case Method::CreateColoredFont:
+            return "createColoredFont";
+          case Method::DestroyColoredFont:
+            return "destroyColoredFont";
+          case Method::PollEvents:
+            return "pollEvents";
+          default:
+            return "unknown";
+        }
+      }
+
+      EngineShPtr
+      ProfilingEngineDecorator::fromEnvironment(EngineShPtr engine) {
+        if (!isProfilingRequested()) {
+          return engine;
+        }
+
+        return std::make_shared<ProfilingEngineDecorator>(engine);
+      }
+
+      std::vector<ProfilingEngineDecorator::MethodStats>
+      ProfilingEngineDecorator::getMethodStats() const {
+        std::vector<MethodStats> stats;
+
+        for (unsigned id = 0u ; id < m_counters.size() ; ++id) {
+          const Counter& counter = m_counters[id];
+
+          const std::uint64_t calls = counter.calls.load(std::memory_order_relaxed);
+          if (calls == 0u) {
+            continue;
+          }
+
+          stats.push_back(
+            MethodStats{
+              getNameFromMethod(static_cast<Method>(id)),
+              calls,
+              counter.total.load(std::memory_order_relaxed) / 1000000.0f,
+              counter.max.load(std::memory_order_relaxed) / 1000000.0f
+            }
+          );
+        }
+
+        return stats;
+      }
+
+      void
+      ProfilingEngineDecorator::reset() {
+        for (unsigned id = 0u ; id < m_counters.size() ; ++id) {
+          m_counters[id].calls = 0u;
+          m_counters[id].total = 0u;
+          m_counters[id].max = 0u;
+        }
+
+        // The live textures are kept so that destroying them later on does not
+        // corrupt the memory estimation.
+        m_createdTextures = 0u;
+        m_destroyedTextures = 0u;
+        m_createdBytes = 0u;
+
+        const std::lock_guard guard(m_traceLocker);
+        m_spans.clear();
+        m_droppedSpans = 0u;
+      }
+
+      bool
+      ProfilingEngineDecorator::writeTrace(const std::string& file) const {
+        std::ofstream out(file, std::ios::out | std::ios::trunc);
+        if (!out.is_open()) {
+          warn("Could not open file \"" + file + "\" to write trace");
+          return false;
+        }
+
+        const std::lock_guard guard(m_traceLocker);
+
+        // See the trace event format specification: all the spans are complete
+        // events (`X` phase) which carry both their start and their duration.
+        out << "{\"traceEvents\":[";
+
+        for (unsigned id = 0u ; id < m_spans.size() ; ++id) {
+          const Span& span = m_spans[id];
+
+          out << (id > 0u ? ",\n" : "\n")
+              << "{\"name\":\"" << getNameFromMethod(span.method) << "\","
+              << "\"cat\":\"engine\","
+              << "\"ph\":\"X\","
+              << "\"ts\":" << toMicroseconds(span.start) << ","
+              << "\"dur\":" << toMicroseconds(span.duration) << ","
+              << "\"pid\":1,"
+              << "\"tid\":" << span.thread << "}";
+        }
+
+        out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+        if (m_droppedSpans > 0u) {
+          warn("Dropped " + std::to_string(m_droppedSpans) + " span(s) from trace \"" + file + "\"");
+        }
+
+        verbose("Wrote " + std::to_string(m_spans.size()) + " span(s) to trace \"" + file + "\"");
+
+        return out.good();
+      }
+
+      utils::Uuid
+      ProfilingEngineDecorator::createWindow(const utils::Sizei& size,
+                                             const bool resizable,
+                                             const std::string& title)
+      {
+        return profile(Method::CreateWindow,
+          [&]() {
+            return EngineDecorator::createWindow(size, resizable, title);
+          }
+        );
+      }
+
+      void
+      ProfilingEngineDecorator::setWindowIcon(const utils::Uuid& uuid,
+                                              const std::string& icon)
+      {
+        profile(Method::SetWindowIcon,
+          [&]() {
+            EngineDecorator::setWindowIcon(uuid, icon);
+          }
+        );
+      }
+
+      void
+      ProfilingEngineDecorator::clearWindow(const utils::Uuid& uuid) {
+        profile(Method::ClearWindow,
+          [&]() {
+            EngineDecorator::clearWindow(uuid);
+          }
+        );
+      }
+
+      void
+      ProfilingEngineDecorator::renderWindow(const utils::Uuid& uuid) {
+        profile(Method::RenderWindow,
+          [&]() {
+            EngineDecorator::renderWindow(uuid);
+          }
+        );
+      }
+
+      void
+      ProfilingEngineDecorator::updateViewport(const utils::Uuid& uuid,
+                                               const utils::Boxf& area)
+      {
+        profile(Method::UpdateViewport,
+          [&]() {
+            EngineDecorator::updateViewport(uuid, area);
+          }
+        );
+      }
+
+      void
+      ProfilingEngineDecorator::setWindowRetained(const utils::Uuid& uuid,
+                                                  bool retained)
+      {
+        profile(Method::SetWindowRetained,
+          [&]() {
+            EngineDecorator::setWindowRetained(uuid, retained);
+          }
+        );
+      }
+
+      void
+      ProfilingEngineDecorator::invalidateWindow(const utils::Uuid& uuid,
+                                                 const utils::Boxf* area)
+      {
+        profile(Method::InvalidateWindow,
+          [&]() {
+            EngineDecorator::invalidateWindow(uuid, area);
+          }
+        );
+      }
+
+      void
+      ProfilingEngineDecorator::setWindowFramePacing(const utils::Uuid& uuid,
+                                                     float rate,
+                                                     bool vsync)
+      {
+        profile(Method::SetWindowFramePacing,
+          [&]() {
+            EngineDecorator::setWindowFramePacing(uuid, rate, vsync);
+          }
+        );
+      }
+
+      FrameStats
+      ProfilingEngineDecorator::getWindowFrameStats(const utils::Uuid& uuid) {
+        return profile(Method::GetWindowFrameStats,
+          [&]() {
+            return EngineDecorator::getWindowFrameStats(uuid);
+          }
+        );
+      }
+
+      Window::DamageStats
+      ProfilingEngineDecorator::getWindowDamageStats(const utils::Uuid& uuid) {
+        return profile(Method::GetWindowDamageStats,
+          [&]() {
+            return EngineDecorator::getWindowDamageStats(uuid);
+          }
+        );
+      }
+
+      SurfaceTexture::RawSurfaceDataShPtr
+      ProfilingEngineDecorator::readWindowPixels(const utils::Uuid& uuid) {
+        return profile(Method::ReadWindowPixels,
+          [&]() {
+            return EngineDecorator::readWindowPixels(uuid);
+          }
+        );
+      }
+
+      void
+      ProfilingEngineDecorator::destroyWindow(const utils::Uuid& uuid) {
+        profile(Method::DestroyWindow,
+          [&]() {
+            EngineDecorator::destroyWindow(uuid);
+          }
+        );
+      }
+
+      utils::Uuid
+      ProfilingEngineDecorator::createTexture(const utils::Uuid& win,
+                                              const utils::Sizef& size,
+                                              const Palette::ColorRole& role)
+      {
+        return recordTexture(profile(Method::CreateTexture,
+          [&]() {
+            return EngineDecorator::createTexture(win, size, role);
+          }
+        ));
+      }
+
+      utils::Uuid
+      ProfilingEngineDecorator::createTexture(const utils::Sizef& size,
+                                              const Palette::ColorRole& role)
+      {
+        return recordTexture(profile(Method::CreateTexture,
+          [&]() {
+            return EngineDecorator::createTexture(size, role);
+          }
+        ));
+      }
+
+      utils::Uuid
+      ProfilingEngineDecorator::createTextureFromFile(const utils::Uuid& win,
+                                                      ImageShPtr img,
+                                                      const Palette::ColorRole& role)
+      {
+        return recordTexture(profile(Method::CreateTextureFromFile,
+          [&]() {
+            return EngineDecorator::createTextureFromFile(win, img, role);
+          }
+        ));
+      }
+
+      utils::Uuid
+      ProfilingEngineDecorator::createTextureFromFile(ImageShPtr img,
+                                                      const Palette::ColorRole& role)
+      {
+        return recordTexture(profile(Method::CreateTextureFromFile,
+          [&]() {
+            return EngineDecorator::createTextureFromFile(img, role);
+          }
+        ));
+      }
+
+      utils::Uuid
+      ProfilingEngineDecorator::createTextureFromFileAsync(const utils::Uuid& win,
+                                                           ImageShPtr img,
+                                                           const Palette::ColorRole& role)
+      {
+        // The size of the texture is not known until the image is decoded: the
+        // texture is counted but not its memory.
+        const utils::Uuid uuid = profile(Method::CreateTextureFromFileAsync,
+          [&]() {
+            return EngineDecorator::createTextureFromFileAsync(win, img, role);
+          }
+        );
+
+        if (isEnabled()) {
+          ++m_createdTextures;
+        }
+
+        return uuid;
+      }
+
+      utils::Uuid
+      ProfilingEngineDecorator::createTextureFromText(const utils::Uuid& win,
+                                                      const std::string& text,
+                                                      const utils::Uuid& font,
+                                                      const Palette::ColorRole& role)
+      {
+        return recordTexture(profile(Method::CreateTextureFromText,
+          [&]() {
+            return EngineDecorator::createTextureFromText(win, text, font, role);
+          }
+        ));
+      }
+
+      utils::Uuid
+      ProfilingEngineDecorator::createTextureFromText(const std::string& text,
+                                                      const utils::Uuid& font,
+                                                      const Palette::ColorRole& role)
+      {
+        return recordTexture(profile(Method::CreateTextureFromText,
+          [&]() {
+            return EngineDecorator::createTextureFromText(text, font, role);
+          }
+        ));
+      }
+
+      utils::Uuid
+      ProfilingEngineDecorator::createTextureFromBrush(BrushShPtr brush) {
+        return recordTexture(profile(Method::CreateTextureFromBrush,
+          [&]() {
+            return EngineDecorator::createTextureFromBrush(brush);
+          }
+        ));
+      }
+
+      utils::Uuid
+      ProfilingEngineDecorator::createTextureFromBrush(const utils::Uuid& win,
+                                                       BrushShPtr brush)
+      {
+        return recordTexture(profile(Method::CreateTextureFromBrush,
+          [&]() {
+            return EngineDecorator::createTextureFromBrush(win, brush);
+          }
+        ));
+      }
+
+      void
+      ProfilingEngineDecorator::fillTexture(const utils::Uuid& uuid,
+                                            const Palette& palette,
+                                            const utils::Boxf* area)
+      {
+        profile(Method::FillTexture,
+          [&]() {
+            EngineDecorator::fillTexture(uuid, palette, area);
+          }
+        );
+      }
+
+      void
+      ProfilingEngineDecorator::setTextureAlpha(const utils::Uuid& uuid,
+                                                const Color& color)
+      {
+        profile(Method::SetTextureAlpha,
+          [&]() {
+            EngineDecorator::setTextureAlpha(uuid, color);
+          }
+        );
+      }
+
+      Palette::ColorRole
+      ProfilingEngineDecorator::getTextureRole(const utils::Uuid& uuid) {
+        return profile(Method::GetTextureRole,
+          [&]() {
+            return EngineDecorator::getTextureRole(uuid);
+          }
+        );
+      }
+
+      void
+      ProfilingEngineDecorator::setTextureRole(const utils::Uuid& uuid,
+                                               const Palette::ColorRole& role)
+      {
+        profile(Method::SetTextureRole,
+          [&]() {
+            EngineDecorator::setTextureRole(uuid, role);
+          }
+        );
+      }
+
+      void
+      ProfilingEngineDecorator::drawTexture(const utils::Uuid& tex,
+                                            const utils::Boxf* from,
+                                            const utils::Uuid* on,
+                                            const utils::Boxf* where)
+      {
+        profile(Method::DrawTexture,
+          [&]() {
+            EngineDecorator::drawTexture(tex, from, on, where);
+          }
+        );
+      }
+
+      utils::Sizef
+      ProfilingEngineDecorator::queryTexture(const utils::Uuid& uuid) {
+        return profile(Method::QueryTexture,
+          [&]() {
+            return EngineDecorator::queryTexture(uuid);
+          }
+        );
+      }
+
+      utils::Sizef
+      ProfilingEngineDecorator::getTextSize(const std::string& text,
+                                            const utils::Uuid& font,
+                                            bool exact)
+      {
+        return profile(Method::GetTextSize,
+          [&]() {
+            return EngineDecorator::getTextSize(text, font, exact);
+          }
+        );
+      }
+
+      void
+      ProfilingEngineDecorator::destroyTexture(const utils::Uuid& uuid) {
+        profile(Method::DestroyTexture,
+          [&]() {
+            EngineDecorator::destroyTexture(uuid);
+          }
+        );
+
+        if (!isEnabled()) {
+          return;
+        }
+
+        ++m_destroyedTextures;
+
+        // Textures created while the profiling was disabled are not tracked.
+        const std::lock_guard guard(m_texturesLocker);
+
+        std::unordered_map<utils::Uuid, std::uint64_t>::iterator it = m_textures.find(uuid);
+        if (it != m_textures.end()) {
+          m_liveBytes -= it->second;
+          m_textures.erase(it);
+        }
+      }
+
+      utils::Uuid
+      ProfilingEngineDecorator::createColoredFont(const std::string& name,
+                                                  const Palette& palette,
+                                                  int size)
+      {
+        return profile(Method::CreateColoredFont,
+          [&]() {
+            return EngineDecorator::createColoredFont(name, palette, size);
+          }
+        );
+      }
+
+      void
+      ProfilingEngineDecorator::destroyColoredFont(const utils::Uuid& uuid) {
+        profile(Method::DestroyColoredFont,
+          [&]() {
+            EngineDecorator::destroyColoredFont(uuid);
+          }
+        );
+      }
+
+      std::vector<EventShPtr>
+      ProfilingEngineDecorator::pollEvents() {
+        return profile(Method::PollEvents,
+          [&]() {
+            return EngineDecorator::pollEvents();
+          }
+        );
+      }
+
+      void
+      ProfilingEngineDecorator::pollEvents(std::vector<EventShPtr>& out) {
+        profile(Method::PollEvents,
+          [&]() {
+            EngineDecorator::pollEvents(out);
+          }
+        );
+      }
+
+      void
+      ProfilingEngineDecorator::record(const Method& method,
+                                       const Clock::time_point& start,
+                                       const Clock::time_point& end)
+      {
+        const std::uint64_t duration = static_cast<std::uint64_t>(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()
+        );
+
+        Counter& counter = m_counters[static_cast<unsigned>(method)];
+
+        counter.calls.fetch_add(1u, std::memory_order_relaxed);
+        counter.total.fetch_add(duration, std::memory_order_relaxed);
+
+        std::uint64_t max = counter.max.load(std::memory_order_relaxed);
+        while (duration > max && !counter.max.compare_exchange_weak(max, duration, std::memory_order_relaxed)) {}
+
+        if (!isTracing()) {
+          return;
+        }
+
+        const Span span{
+          method,
+          static_cast<std::uint32_t>(std::hash<std::thread::id>()(std::this_thread::get_id())),
+          static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(start - m_origin).count()),
+          duration
+        };
+
+        const std::lock_guard guard(m_traceLocker);
+
+        if (m_spans.size() >= sk_maxSpans) {
+          ++m_droppedSpans;
+          return;
+        }
+
+        m_spans.push_back(span);
+      }
+
+      utils::Uuid
+      ProfilingEngineDecorator::recordTexture(const utils::Uuid& uuid) {
+        if (!isEnabled()) {
+          return uuid;
+        }
+
+        ++m_createdTextures;
+
+        // The query is not accounted for as it is not made by the application.
+        std::uint64_t bytes = 0u;
+
+        withSafetyNet(
+          [&bytes, &uuid, this]() {
+            const utils::Sizef size = EngineDecorator::queryTexture(uuid);
+            bytes = 4u * static_cast<std::uint64_t>(size.w()) * static_cast<std::uint64_t>(size.h());
+          },
+          std::string("recordTexture")
+        );
+
+        m_createdBytes += bytes;
+        m_liveBytes += bytes;
+
+        const std::lock_guard guard(m_texturesLocker);
+        m_textures[uuid] = bytes;
+
+        return uuid;
+      }
+
+    }
+  }
+}
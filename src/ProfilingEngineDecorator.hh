@@ -0,0 +1,424 @@
+#ifndef    PROFILING_ENGINE_DECORATOR_HH
+# define   PROFILING_ENGINE_DECORATOR_HH
+
+# include <mutex>
+# include <array>
+# include <atomic>
+# include <chrono>
+# include <memory>
+# include <string>
+# include <vector>
+# include <cstdint>
+# include <unordered_map>
+# include "EngineDecorator.hh"
+
+namespace sdl {
+  namespace core {
+    namespace engine {
+
+      /**
+       * @brief - An engine decorator measuring the calls made to the wrapped
+       *          engine. For each method it counts the calls and records the
+       *          cumulative and maximum latency. It also tracks the number of
+       *          textures created and destroyed along with an estimation of the
+       *          memory they use.
+       *          When tracing is active, each call is also recorded as a span
+       *          which can be saved in the Chrome trace event format and loaded
+       *          in `chrome://tracing` or Perfetto.
+       *          When profiling is disabled the calls are forwarded with a single
+       *          check of an atomic flag.
+       *          The profiling can be enabled without modifying the application
+       *          through the environment:
+       *            - `SDL_ENGINE_PROFILING` enables the counters if it is set to
+       *              any value but `0`.
+       *            - `SDL_ENGINE_TRACE` enables the counters and the tracing: the
+       *              trace is written to the file it names when the decorator is
+       *              destroyed.
+       */
+      class ProfilingEngineDecorator: public EngineDecorator {
+        public:
+
+          /**
+           * @brief - The methods of the engine which are measured. Overloads of a
+           *          method are accounted together.
+           */
+          enum class Method {
+            CreateWindow,
+            SetWindowIcon,
+            ClearWindow,
+            RenderWindow,
+            UpdateViewport,
+            SetWindowRetained,
+            InvalidateWindow,
+            SetWindowFramePacing,
+            GetWindowFrameStats,
+            GetWindowDamageStats,
+            ReadWindowPixels,
+            DestroyWindow,
+            CreateTexture,
+            CreateTextureFromFile,
+            CreateTextureFromFileAsync,
+            CreateTextureFromText,
+            CreateTextureFromBrush,
+            FillTexture,
+            SetTextureAlpha,
+            GetTextureRole,
+            SetTextureRole,
+            DrawTexture,
+            QueryTexture,
+            GetTextSize,
+            DestroyTexture,
+            CreateColoredFont,
+            DestroyColoredFont,
+            PollEvents,
+            Count
+          };
+
+          /**
+           * @brief - The measurements for a method of the engine. Latencies are
+           *          expressed in milliseconds.
+           */
+          struct MethodStats {
+            std::string name;
+            std::uint64_t calls;
+            float total;
+            float max;
+          };
+
+          /**
+           * @brief - The textures created and destroyed through the engine. Sizes
+           *          are estimated from the dimensions of the textures assuming 4
+           *          bytes per pixel.
+           */
+          struct TextureStats {
+            std::uint64_t created;
+            std::uint64_t destroyed;
+            std::uint64_t createdBytes;
+            std::uint64_t liveBytes;
+          };
+
+          ProfilingEngineDecorator(EngineShPtr engine,
+                                   const std::string& name = std::string("profiling_engine"));
+
+          /**
+           * @brief - Writes the trace to the file specified in the environment if
+           *          any.
+           */
+          ~ProfilingEngineDecorator();
+
+          /**
+           * @brief - Retrieves a human-readable name for the input method.
+           * @param method - the method to convert to a string.
+           * @return - the name of the method.
+           */
+          static
+          std::string
+          getNameFromMethod(const Method& method) noexcept;
+
+          /**
+           * @brief - Wraps the input engine into a profiling decorator if it is
+           *          requested by the environment. Otherwise the engine is returned
+           *          as is so that no overhead is added.
+           * @param engine - the engine to wrap.
+           * @return - the engine to use.
+           */
+          static
+          EngineShPtr
+          fromEnvironment(EngineShPtr engine);
+
+          void
+          setEnabled(bool enabled) noexcept;
+
+          bool
+          isEnabled() const noexcept;
+
+          /**
+           * @brief - Defines whether the calls are recorded as spans in the trace.
+           *          Tracing only happens while the profiling is enabled.
+           * @param tracing - `true` to record the calls in the trace.
+           */
+          void
+          setTracing(bool tracing) noexcept;
+
+          bool
+          isTracing() const noexcept;
+
+          /**
+           * @brief - Returns the measurements for all the methods called at least
+           *          once since the last reset.
+           * @return - the measurements of the methods.
+           */
+          std::vector<MethodStats>
+          getMethodStats() const;
+
+          TextureStats
+          getTextureStats() const noexcept;
+
+          /**
+           * @brief - Discards all the measurements and the trace recorded so far.
+           */
+          void
+          reset();
+
+          /**
+           * @brief - Writes the spans recorded so far in the input file in the Chrome
+           *          trace event format.
+           * @param file - the path of the file to write.
+           * @return - `true` if the file could be written.
+           */
+          bool
+          writeTrace(const std::string& file) const;
+
+          utils::Uuid
+          createWindow(const utils::Sizei& size,
+                       const bool resizable = true,
+                       const std::string& title = std::string("Default SDL window")) override;
+
+          void
+          setWindowIcon(const utils::Uuid& uuid,
+                        const std::string& icon) override;
+
+          void
+          clearWindow(const utils::Uuid& uuid) override;
+
+          void
+          renderWindow(const utils::Uuid& uuid) override;
+
+          void
+          updateViewport(const utils::Uuid& uuid,
+                         const utils::Boxf& area) override;
+
+          void
+          setWindowRetained(const utils::Uuid& uuid,
+                            bool retained) override;
+
+          void
+          invalidateWindow(const utils::Uuid& uuid,
+                           const utils::Boxf* area = nullptr) override;
+
+          void
+          setWindowFramePacing(const utils::Uuid& uuid,
+                               float rate,
+                               bool vsync) override;
+
+          FrameStats
+          getWindowFrameStats(const utils::Uuid& uuid) override;
+
+          Window::DamageStats
+          getWindowDamageStats(const utils::Uuid& uuid) override;
+
+          SurfaceTexture::RawSurfaceDataShPtr
+          readWindowPixels(const utils::Uuid& uuid) override;
+
+          void
+          destroyWindow(const utils::Uuid& uuid) override;
+
+          utils::Uuid
+          createTexture(const utils::Uuid& win,
+                        const utils::Sizef& size,
+                        const Palette::ColorRole& role) override;
+
+          utils::Uuid
+          createTexture(const utils::Sizef& size,
+                        const Palette::ColorRole& role) override;
+
+          utils::Uuid
+          createTextureFromFile(const utils::Uuid& win,
+                                ImageShPtr img,
+                                const Palette::ColorRole& role) override;
+
+          utils::Uuid
+          createTextureFromFile(ImageShPtr img,
+                                const Palette::ColorRole& role) override;
+
+          utils::Uuid
+          createTextureFromFileAsync(const utils::Uuid& win,
+                                     ImageShPtr img,
+                                     const Palette::ColorRole& role) override;
+
+          utils::Uuid
+          createTextureFromText(const utils::Uuid& win,
+                                const std::string& text,
+                                const utils::Uuid& font,
+                                const Palette::ColorRole& role) override;
+
+          utils::Uuid
+          createTextureFromText(const std::string& text,
+                                const utils::Uuid& font,
+                                const Palette::ColorRole& role) override;
+
+          utils::Uuid
+          createTextureFromBrush(BrushShPtr brush) override;
+
+          utils::Uuid
+          createTextureFromBrush(const utils::Uuid& win,
+                                 BrushShPtr brush) override;
+
+          void
+          fillTexture(const utils::Uuid& uuid,
+                      const Palette& palette,
+                      const utils::Boxf* area = nullptr) override;
+
+          void
+          setTextureAlpha(const utils::Uuid& uuid,
+                          const Color& color) override;
+
+          Palette::ColorRole
+          getTextureRole(const utils::Uuid& uuid) override;
+
+          void
+          setTextureRole(const utils::Uuid& uuid,
+                         const Palette::ColorRole& role) override;
+
+          void
+          drawTexture(const utils::Uuid& tex,
+                      const utils::Boxf* from = nullptr,
+                      const utils::Uuid* on = nullptr,
+                      const utils::Boxf* where = nullptr) override;
+
+          utils::Sizef
+          queryTexture(const utils::Uuid& uuid) override;
+
+          utils::Sizef
+          getTextSize(const std::string& text,
+                      const utils::Uuid& font,
+                      bool exact) override;
+
+          void
+          destroyTexture(const utils::Uuid& uuid) override;
+
+          utils::Uuid
+          createColoredFont(const std::string& name,
+                            const Palette& palette,
+                            int size = 25) override;
+
+          void
+          destroyColoredFont(const utils::Uuid& uuid) override;
+
+          std::vector<EventShPtr>
+          pollEvents() override;
+
+          void
+          pollEvents(std::vector<EventShPtr>& out) override;
+
+        private:
+
+          using Clock = std::chrono::steady_clock;
+
+          /**
+           * @brief - The measurements of a single method. They are updated from any
+           *          thread calling the engine. Durations are in nanoseconds.
+           */
+          struct Counter {
+            std::atomic<std::uint64_t> calls;
+            std::atomic<std::uint64_t> total;
+            std::atomic<std::uint64_t> max;
+          };
+
+          /**
+           * @brief - A span of the trace. Times are in nanoseconds since the creation
+           *          of the decorator.
+           */
+          struct Span {
+            Method method;
+            std::uint32_t thread;
+            std::uint64_t start;
+            std::uint64_t duration;
+          };
+
+          /**
+           * @brief - Measures the duration of a call to the wrapped engine from its
+           *          creation to its destruction, so that calls raising an error are
+           *          also accounted for.
+           */
+          class Scope {
+            public:
+
+              Scope(ProfilingEngineDecorator& profiler,
+                    const Method& method) noexcept;
+
+              ~Scope();
+
+            private:
+
+              ProfilingEngineDecorator& m_profiler;
+              Method m_method;
+              Clock::time_point m_start;
+          };
+
+          /**
+           * @brief - The maximum number of spans kept in the trace. Spans recorded
+           *          after this limit is reached are dropped.
+           */
+          static constexpr std::size_t sk_maxSpans = 1u << 20u;
+
+          /**
+           * @brief - Calls the input function and measures it if the profiling is
+           *          enabled.
+           * @param method - the method of the engine called by the function.
+           * @param func - the function to call.
+           * @return - the value returned by the function.
+           */
+          template <typename Function>
+          auto
+          profile(const Method& method,
+                  Function&& func) -> decltype(func());
+
+          /**
+           * @brief - Records a call to a method of the engine.
+           * @param method - the method which was called.
+           * @param start - the time at which the call started.
+           * @param end - the time at which the call ended.
+           */
+          void
+          record(const Method& method,
+                 const Clock::time_point& start,
+                 const Clock::time_point& end);
+
+          /**
+           * @brief - Registers a newly created texture and estimates its size.
+           * @param uuid - the identifier of the texture.
+           * @return - the input identifier.
+           */
+          utils::Uuid
+          recordTexture(const utils::Uuid& uuid);
+
+        private:
+
+          std::atomic<bool> m_enabled;
+          std::atomic<bool> m_tracing;
+
+          /**
+           * @brief - The file into which the trace is written when the decorator is
+           *          destroyed. Empty if the trace should not be written.
+           */
+          std::string m_traceFile;
+
+          std::array<Counter, static_cast<std::size_t>(Method::Count)> m_counters;
+
+          std::atomic<std::uint64_t> m_createdTextures;
+          std::atomic<std::uint64_t> m_destroyedTextures;
+          std::atomic<std::uint64_t> m_createdBytes;
+          std::atomic<std::uint64_t> m_liveBytes;
+
+          /**
+           * @brief - The estimated size in bytes of each live texture.
+           */
+          std::mutex m_texturesLocker;
+          std::unordered_map<utils::Uuid, std::uint64_t> m_textures;
+
+          Clock::time_point m_origin;
+
+          mutable std::mutex m_traceLocker;
+          std::vector<Span> m_spans;
+          std::uint64_t m_droppedSpans;
+      };
+
+      using ProfilingEngineDecoratorShPtr = std::shared_ptr<ProfilingEngineDecorator>;
+    }
+  }
+}
+
+# include "ProfilingEngineDecorator.hxx"
+
+#endif    /* PROFILING_ENGINE_DECORATOR_HH */
@@ -0,0 +1,77 @@
+#ifndef    PROFILING_ENGINE_DECORATOR_HXX
+# define   PROFILING_ENGINE_DECORATOR_HXX
+
+# include "ProfilingEngineDecorator.hh"
+
+namespace sdl {
+  namespace core {
+    namespace engine {
+
+      inline
+      void
+      ProfilingEngineDecorator::setEnabled(bool enabled) noexcept {
+        m_enabled.store(enabled, std::memory_order_relaxed);
+      }
+
+      inline
+      bool
+      ProfilingEngineDecorator::isEnabled() const noexcept {
+        return m_enabled.load(std::memory_order_relaxed);
+      }
+
+      inline
+      void
+      ProfilingEngineDecorator::setTracing(bool tracing) noexcept {
+        m_tracing.store(tracing, std::memory_order_relaxed);
+      }
+
+      inline
+      bool
+      ProfilingEngineDecorator::isTracing() const noexcept {
+        return m_tracing.load(std::memory_order_relaxed);
+      }
+
+      inline
+      ProfilingEngineDecorator::TextureStats
+      ProfilingEngineDecorator::getTextureStats() const noexcept {
+        return TextureStats{
+          m_createdTextures.load(std::memory_order_relaxed),
+          m_destroyedTextures.load(std::memory_order_relaxed),
+          m_createdBytes.load(std::memory_order_relaxed),
+          m_liveBytes.load(std::memory_order_relaxed)
+        };
+      }
+
+      inline
+      ProfilingEngineDecorator::Scope::Scope(ProfilingEngineDecorator& profiler,
+                                             const Method& method) noexcept:
+        m_profiler(profiler),
+        m_method(method),
+        m_start(Clock::now())
+      {}
+
+      inline
+      ProfilingEngineDecorator::Scope::~Scope() {
+        m_profiler.record(m_method, m_start, Clock::now());
+      }
+
+      template <typename Function>
+      inline
+      auto
+      ProfilingEngineDecorator::profile(const Method& method,
+                                        Function&& func) -> decltype(func())
+      {
+        // This is the only cost paid when the profiling is disabled.
+        if (!isEnabled()) {
+          return func();
+        }
+
+        const Scope scope(*this, method);
+        return func();
+      }
+
+    }
+  }
+}
+
+#endif    /* PROFILING_ENGINE_DECORATOR_HXX */
@@ -0,0 +1,788 @@
+
+# include "RenderThreadEngine.hh"
+# include <core_utils/SafetyNet.hh>
+
+namespace sdl {
+  namespace core {
+    namespace engine {
+
+      RenderThreadEngine::RenderThreadEngine(EngineShPtr engine,
+                                             std::size_t capacity,
+                                             const std::string& name):
+        EngineDecorator(engine, name),
+
+        m_commands(capacity),
+        m_posted(0u),
+
+        m_running(true),
+
+        m_renderThread(),
+        m_destroyed(nullptr),
+
+        m_proxies(),
+        m_windows(),
+
+        m_mirrorLocker(),
+        m_mirror(),
+        m_windowsMirror(),
+
+        m_events(capacity),
+        m_polled(),
+        m_polling(false),
+
+        m_thread()
+      {
+        setService("render");
+
+        // The render thread uses the engine right away: it is only started
+        // once the engine is fully configured.
+        m_thread = std::thread(&RenderThreadEngine::loop, this);
+      }
+
+      RenderThreadEngine::~RenderThreadEngine() {
+        // The last reference to the engine might be released by a command
+        // executed on the render thread: it can't wait for itself. In this
+        // case the remaining commands are executed right away and the thread
+        // is told not to use the engine anymore once the current command is
+        // done.
+        if (isRenderThread()) {
+          Command command;
+          while (m_commands.pop(command)) {
+            execute(command);
+          }
+
+          *m_destroyed = true;
+          m_thread.detach();
+
+          return;
+        }
+
+        // The render thread stops once it reaches this command, which means
+        // that all the commands queued before are executed.
+        post(
+          [this]() {
+            m_running = false;
+          }
+        );
+
+        m_thread.join();
+      }
+
+      void
+      RenderThreadEngine::flush() {
+        call<bool>(
+          []() {
+            return true;
+          }
+        );
+      }
+
+      utils::Uuid
+      RenderThreadEngine::createWindow(const utils::Sizei& size,
+                                       const bool resizable,
+                                       const std::string& title)
+      {
+        const utils::Uuid proxy = utils::Uuid::create();
+
+        {
+          const std::lock_guard guard(m_mirrorLocker);
+          m_windowsMirror[proxy] = WindowInfo{
+            FrameStats{0u, 0u, 0.0f, 0.0f, 0.0f, 0.0f},
+            Window::DamageStats{0u, 0u, 0.0f}
+          };
+        }
+
+        // The proxy is registered before creating the window so that it is
+        // known to have failed if the creation raises an error.
+        post(
+          [this, proxy, size, resizable, title]() {
+            m_proxies[proxy] = utils::Uuid();
+
+            const utils::Uuid uuid = EngineDecorator::createWindow(size, resizable, title);
+            m_proxies[proxy] = uuid;
+            m_windows[uuid] = proxy;
+          }
+        );
+
+        return proxy;
+      }
+
+      void
+      RenderThreadEngine::setWindowIcon(const utils::Uuid& uuid,
+                                        const std::string& icon)
+      {
+        post(
+          [this, uuid, icon]() {
+            EngineDecorator::setWindowIcon(resolve(uuid), icon);
+          }
+        );
+      }
+
+      void
+      RenderThreadEngine::clearWindow(const utils::Uuid& uuid) {
+        post(
+          [this, uuid]() {
+            EngineDecorator::clearWindow(resolve(uuid));
+          }
+        );
+      }
+
+      void
+      RenderThreadEngine::renderWindow(const utils::Uuid& uuid) {
+        post(
+          [this, uuid]() {
+            const utils::Uuid real = resolve(uuid);
+
+            EngineDecorator::renderWindow(real);
+            updateWindowInfo(uuid, real);
+          }
+        );
+      }
+
+      void
+      RenderThreadEngine::updateViewport(const utils::Uuid& uuid,
+                                         const utils::Boxf& area)
+      {
+        post(
+          [this, uuid, area]() {
+            EngineDecorator::updateViewport(resolve(uuid), area);
+          }
+        );
+      }
+
+      void
+      RenderThreadEngine::setWindowRetained(const utils::Uuid& uuid,
+                                            bool retained)
+      {
+        post(
+          [this, uuid, retained]() {
+            EngineDecorator::setWindowRetained(resolve(uuid), retained);
+          }
+        );
+      }
+
+      void
+      RenderThreadEngine::invalidateWindow(const utils::Uuid& uuid,
+                                           const utils::Boxf* area)
+      {
+        const std::optional<utils::Boxf> damage = (area == nullptr ? std::nullopt : std::optional<utils::Boxf>(*area));
+
+        post(
+          [this, uuid, damage]() {
+            EngineDecorator::invalidateWindow(resolve(uuid), damage ? &*damage : nullptr);
+          }
+        );
+      }
+
+      void
+      RenderThreadEngine::setWindowFramePacing(const utils::Uuid& uuid,
+                                               float rate,
+                                               bool vsync)
+      {
+        post(
+          [this, uuid, rate, vsync]() {
+            EngineDecorator::setWindowFramePacing(resolve(uuid), rate, vsync);
+          }
+        );
+      }
+
+      FrameStats
+      RenderThreadEngine::getWindowFrameStats(const utils::Uuid& uuid) {
+        const std::lock_guard guard(m_mirrorLocker);
+
+        WindowsMirror::const_iterator it = m_windowsMirror.find(uuid);
+        if (it == m_windowsMirror.cend()) {
+          return FrameStats{0u, 0u, 0.0f, 0.0f, 0.0f, 0.0f};
+        }
+
+        return it->second.frames;
+      }
+
+      Window::DamageStats
+      RenderThreadEngine::getWindowDamageStats(const utils::Uuid& uuid) {
+        const std::lock_guard guard(m_mirrorLocker);
+
+        WindowsMirror::const_iterator it = m_windowsMirror.find(uuid);
+        if (it == m_windowsMirror.cend()) {
+          return Window::DamageStats{0u, 0u, 0.0f};
+        }
+
+        return it->second.damage;
+      }
+
+      SurfaceTexture::RawSurfaceDataShPtr
+      RenderThreadEngine::readWindowPixels(const utils::Uuid& uuid) {
+        // The pixels are only available once the frame is drawn: this is the
+        // only window query waiting for the render thread.
+        return call<SurfaceTexture::RawSurfaceDataShPtr>(
+          [this, uuid]() {
+            return EngineDecorator::readWindowPixels(resolve(uuid));
+          }
+        );
+      }
+
+      void
+      RenderThreadEngine::destroyWindow(const utils::Uuid& uuid) {
+        {
+          const std::lock_guard guard(m_mirrorLocker);
+          m_windowsMirror.erase(uuid);
+        }
+
+        post(
+          [this, uuid]() {
+            const utils::Uuid real = resolve(uuid);
+            m_proxies.erase(uuid);
+            m_windows.erase(real);
+
+            EngineDecorator::destroyWindow(real);
+          }
+        );
+      }
+
+      utils::Uuid
+      RenderThreadEngine::createTexture(const utils::Uuid& win,
+                                        const utils::Sizef& size,
+                                        const Palette::ColorRole& role)
+      {
+        const utils::Uuid proxy = createProxy(&role, &size);
+
+        post(
+          [this, proxy, win, size, role]() {
+            bind(
+              proxy,
+              [this, &win, &size, &role]() {
+                return EngineDecorator::createTexture(resolve(win), size, role);
+              },
+              false
+            );
+          }
+        );
+
+        return proxy;
+      }
+
+      utils::Uuid
+      RenderThreadEngine::createTexture(const utils::Sizef& size,
+                                        const Palette::ColorRole& role)
+      {
+        const utils::Uuid proxy = createProxy(&role, &size);
+
+        post(
+          [this, proxy, size, role]() {
+            bind(
+              proxy,
+              [this, &size, &role]() {
+                return EngineDecorator::createTexture(size, role);
+              },
+              false
+            );
+          }
+        );
+
+        return proxy;
+      }
+
+      utils::Uuid
+      RenderThreadEngine::createTextureFromFile(const utils::Uuid& win,
+                                                ImageShPtr img,
+                                                const Palette::ColorRole& role)
+      {
+        const utils::Uuid proxy = createProxy(&role, nullptr);
+
+        post(
+          [this, proxy, win, img, role]() {
+            bind(
+              proxy,
+              [this, &win, &img, &role]() {
+                return EngineDecorator::createTextureFromFile(resolve(win), img, role);
+              },
+              true
+            );
+          }
+        );
+
+        return proxy;
+      }
+
+      utils::Uuid
+      RenderThreadEngine::createTextureFromFile(ImageShPtr img,
+                                                const Palette::ColorRole& role)
+      {
+        const utils::Uuid proxy = createProxy(&role, nullptr);
+
+        post(
+          [this, proxy, img, role]() {
+            bind(
+              proxy,
+              [this, &img, &role]() {
+                return EngineDecorator::createTextureFromFile(img, role);
+              },
+              true
+            );
+          }
+        );
+
+        return proxy;
+      }
+
+      utils::Uuid
+      RenderThreadEngine::createTextureFromFileAsync(const utils::Uuid& win,
+                                                     ImageShPtr img,
+                                                     const Palette::ColorRole& role)
+      {
+        const utils::Uuid proxy = createProxy(&role, nullptr);
+
+        // The size of the texture changes once the image is decoded so it is
+        // not stored in the mirror.
+        post(
+          [this, proxy, win, img, role]() {
+            bind(
+              proxy,
+              [this, &win, &img, &role]() {
+                return EngineDecorator::createTextureFromFileAsync(resolve(win), img, role);
+              },
+              false
+            );
+          }
+        );
+
+        return proxy;
+      }
+
+      utils::Uuid
+      RenderThreadEngine::createTextureFromText(const utils::Uuid& win,
+                                                const std::string& text,
+                                                const utils::Uuid& font,
+                                                const Palette::ColorRole& role)
+      {
+        const utils::Uuid proxy = createProxy(&role, nullptr);
+
+        post(
+          [this, proxy, win, text, font, role]() {
+            bind(
+              proxy,
+              [this, &win, &text, &font, &role]() {
+                return EngineDecorator::createTextureFromText(resolve(win), text, font, role);
+              },
+              true
+            );
+          }
+        );
+
+        return proxy;
+      }
+
+      utils::Uuid
+      RenderThreadEngine::createTextureFromText(const std::string& text,
+                                                const utils::Uuid& font,
+                                                const Palette::ColorRole& role)
+      {
+        const utils::Uuid proxy = createProxy(&role, nullptr);
+
+        post(
+          [this, proxy, text, font, role]() {
+            bind(
+              proxy,
+              [this, &text, &font, &role]() {
+                return EngineDecorator::createTextureFromText(text, font, role);
+              },
+              true
+            );
+          }
+        );
+
+        return proxy;
+      }
+
+      utils::Uuid
+      RenderThreadEngine::createTextureFromBrush(BrushShPtr brush) {
+        // The brush is rendered later on by the render thread while the caller
+        // may keep drawing on it: use a copy of its current content instead.
+        BrushShPtr copy = (brush == nullptr ? nullptr : brush->snapshot());
+        const utils::Uuid proxy = createProxy(nullptr, nullptr);
+
+        post(
+          [this, proxy, copy]() {
+            bind(
+              proxy,
+              [this, &copy]() {
+                return EngineDecorator::createTextureFromBrush(copy);
+              },
+              true
+            );
+          }
+        );
+
+        return proxy;
+      }
+
+      utils::Uuid
+      RenderThreadEngine::createTextureFromBrush(const utils::Uuid& win,
+                                                 BrushShPtr brush)
+      {
+        // See the other overload.
+        BrushShPtr copy = (brush == nullptr ? nullptr : brush->snapshot());
+        const utils::Uuid proxy = createProxy(nullptr, nullptr);
+
+        post(
+          [this, proxy, win, copy]() {
+            bind(
+              proxy,
+              [this, &win, &copy]() {
+                return EngineDecorator::createTextureFromBrush(resolve(win), copy);
+              },
+              true
+            );
+          }
+        );
+
+        return proxy;
+      }
+
+      void
+      RenderThreadEngine::fillTexture(const utils::Uuid& uuid,
+                                      const Palette& palette,
+                                      const utils::Boxf* area)
+      {
+        const std::optional<utils::Boxf> dst = (area == nullptr ? std::nullopt : std::optional<utils::Boxf>(*area));
+
+        post(
+          [this, uuid, palette, dst]() {
+            EngineDecorator::fillTexture(resolve(uuid), palette, dst ? &*dst : nullptr);
+          }
+        );
+      }
+
+      void
+      RenderThreadEngine::setTextureAlpha(const utils::Uuid& uuid,
+                                          const Color& color)
+      {
+        post(
+          [this, uuid, color]() {
+            EngineDecorator::setTextureAlpha(resolve(uuid), color);
+          }
+        );
+      }
+
+      Palette::ColorRole
+      RenderThreadEngine::getTextureRole(const utils::Uuid& uuid) {
+        {
+          const std::lock_guard guard(m_mirrorLocker);
+
+          Mirror::const_iterator it = m_mirror.find(uuid);
+          if (it != m_mirror.cend() && it->second.role) {
+            return *it->second.role;
+          }
+        }
+
+        return call<Palette::ColorRole>(
+          [this, uuid]() {
+            return EngineDecorator::getTextureRole(resolve(uuid));
+          }
+        );
+      }
+
+      void
+      RenderThreadEngine::setTextureRole(const utils::Uuid& uuid,
+                                         const Palette::ColorRole& role)
+      {
+        {
+          const std::lock_guard guard(m_mirrorLocker);
+
+          Mirror::iterator it = m_mirror.find(uuid);
+          if (it != m_mirror.end()) {
+            it->second.role = role;
+          }
+        }
+
+        post(
+          [this, uuid, role]() {
+            EngineDecorator::setTextureRole(resolve(uuid), role);
+          }
+        );
+      }
+
+      void
+      RenderThreadEngine::drawTexture(const utils::Uuid& tex,
+                                      const utils::Boxf* from,
+                                      const utils::Uuid* on,
+                                      const utils::Boxf* where)
+      {
+        // The arguments are copied as they might not be alive anymore when
+        // the command is executed.
+        const std::optional<utils::Boxf> src = (from == nullptr ? std::nullopt : std::optional<utils::Boxf>(*from));
+        const std::optional<utils::Uuid> target = (on == nullptr ? std::nullopt : std::optional<utils::Uuid>(*on));
+        const std::optional<utils::Boxf> dst = (where == nullptr ? std::nullopt : std::optional<utils::Boxf>(*where));
+
+        post(
+          [this, tex, src, target, dst]() {
+            const std::optional<utils::Uuid> base = (target ? std::optional<utils::Uuid>(resolve(*target)) : std::nullopt);
+
+            EngineDecorator::drawTexture(
+              resolve(tex),
+              src ? &*src : nullptr,
+              base ? &*base : nullptr,
+              dst ? &*dst : nullptr
+            );
+          }
+        );
+      }
+
+      utils::Sizef
+      RenderThreadEngine::queryTexture(const utils::Uuid& uuid) {
+        {
+          const std::lock_guard guard(m_mirrorLocker);
+
+          Mirror::const_iterator it = m_mirror.find(uuid);
+          if (it != m_mirror.cend() && it->second.size) {
+            return *it->second.size;
+          }
+        }
+
+        return call<utils::Sizef>(
+          [this, uuid]() {
+            return EngineDecorator::queryTexture(resolve(uuid));
+          }
+        );
+      }
+
+      utils::Sizef
+      RenderThreadEngine::getTextSize(const std::string& text,
+                                      const utils::Uuid& font,
+                                      bool exact)
+      {
+        // Measuring text does not use any renderer.
+        return EngineDecorator::getTextSize(text, font, exact);
+      }
+
+      void
+      RenderThreadEngine::destroyTexture(const utils::Uuid& uuid) {
+        {
+          const std::lock_guard guard(m_mirrorLocker);
+          m_mirror.erase(uuid);
+        }
+
+        post(
+          [this, uuid]() {
+            const utils::Uuid real = resolve(uuid);
+            m_proxies.erase(uuid);
+
+            EngineDecorator::destroyTexture(real);
+          }
+        );
+      }
+
+      utils::Uuid
+      RenderThreadEngine::createColoredFont(const std::string& name,
+                                            const Palette& palette,
+                                            int size)
+      {
+        // Fonts do not use any renderer: they can be created right away.
+        return EngineDecorator::createColoredFont(name, palette, size);
+      }
+
+      void
+      RenderThreadEngine::destroyColoredFont(const utils::Uuid& uuid) {
+        // The commands already queued might still use the font.
+        post(
+          [this, uuid]() {
+            EngineDecorator::destroyColoredFont(uuid);
+          }
+        );
+      }
+
+      std::vector<EventShPtr>
+      RenderThreadEngine::pollEvents() {
+        std::vector<EventShPtr> events;
+        pollEvents(events);
+
+        return events;
+      }
+
+      void
+      RenderThreadEngine::pollEvents(std::vector<EventShPtr>& out) {
+        // Retrieve the events polled so far.
+        EventShPtr event;
+        while (m_events.pop(event)) {
+          out.push_back(event);
+        }
+
+        // Events have to be polled from the thread owning the windows: request
+        // a new poll unless one is already queued.
+        if (!m_polling.exchange(true, std::memory_order_acq_rel)) {
+          post(
+            [this]() {
+              fetchEvents();
+            }
+          );
+        }
+      }
+
+      void
+      RenderThreadEngine::post(Command command) {
+        if (isRenderThread()) {
+          execute(command);
+          return;
+        }
+
+        // Wait for the render thread to make some room if the queue is full.
+        while (!m_commands.push(std::move(command))) {
+          std::this_thread::yield();
+        }
+
+        m_posted.fetch_add(1u, std::memory_order_release);
+        m_posted.notify_one();
+      }
+
+      void
+      RenderThreadEngine::loop() {
+        // The engine might be destroyed by one of the commands: in this case
+        // this flag is raised and no member can be used anymore.
+        bool destroyed = false;
+        m_destroyed = &destroyed;
+
+        m_renderThread.store(std::this_thread::get_id(), std::memory_order_release);
+
+        Command command;
+
+        while (m_running) {
+          // Read the counter before trying to pop a command so that we can't
+          // miss a command posted in between.
+          const std::uint64_t posted = m_posted.load(std::memory_order_acquire);
+
+          if (!m_commands.pop(command)) {
+            m_posted.wait(posted, std::memory_order_acquire);
+            continue;
+          }
+
+          execute(command);
+          command = nullptr;
+
+          if (destroyed) {
+            return;
+          }
+        }
+
+        notice("Exiting render thread");
+      }
+
+      void
+      RenderThreadEngine::execute(Command& command) {
+        withSafetyNet(
+          [&command]() {
+            command();
+          },
+          std::string("execute")
+        );
+      }
+
+      utils::Uuid
+      RenderThreadEngine::createProxy(const Palette::ColorRole* role,
+                                      const utils::Sizef* size)
+      {
+        const utils::Uuid proxy = utils::Uuid::create();
+
+        TextureInfo info{std::nullopt, std::nullopt};
+        if (role != nullptr) {
+          info.role = *role;
+        }
+        if (size != nullptr) {
+          info.size = *size;
+        }
+
+        const std::lock_guard guard(m_mirrorLocker);
+        m_mirror[proxy] = info;
+
+        return proxy;
+      }
+
+      void
+      RenderThreadEngine::bind(const utils::Uuid& proxy,
+                               const std::function<utils::Uuid(void)>& factory,
+                               bool query)
+      {
+        // Register the proxy before creating the texture: if the creation
+        // fails, the proxy stays associated to an invalid identifier.
+        m_proxies[proxy] = utils::Uuid();
+
+        const utils::Uuid uuid = factory();
+        m_proxies[proxy] = uuid;
+
+        if (!query) {
+          return;
+        }
+
+        const utils::Sizef size = EngineDecorator::queryTexture(uuid);
+        const Palette::ColorRole role = EngineDecorator::getTextureRole(uuid);
+
+        const std::lock_guard guard(m_mirrorLocker);
+
+        Mirror::iterator it = m_mirror.find(proxy);
+        if (it != m_mirror.end()) {
+          it->second.size = size;
+          it->second.role = role;
+        }
+      }
+
+      utils::Uuid
+      RenderThreadEngine::resolve(const utils::Uuid& uuid) const {
+        Proxies::const_iterator it = m_proxies.find(uuid);
+        if (it == m_proxies.cend()) {
+          return uuid;
+        }
+
+        if (!it->second.valid()) {
+          error(
+            std::string("Could not resolve ") + uuid.toString(),
+            std::string("Creation failed")
+          );
+        }
+
+        return it->second;
+      }
+
+      void
+      RenderThreadEngine::updateWindowInfo(const utils::Uuid& proxy,
+                                           const utils::Uuid& uuid)
+      {
+        const WindowInfo info{
+          EngineDecorator::getWindowFrameStats(uuid),
+          EngineDecorator::getWindowDamageStats(uuid)
+        };
+
+        const std::lock_guard guard(m_mirrorLocker);
+
+        WindowsMirror::iterator it = m_windowsMirror.find(proxy);
+        if (it != m_windowsMirror.end()) {
+          it->second = info;
+        }
+      }
+
+      void
+      RenderThreadEngine::fetchEvents() {
+        // Allow new polls to be requested: events appearing from now on will
+        // be retrieved by the next one.
+        m_polling.store(false, std::memory_order_release);
+
+        const std::size_t first = m_polled.size();
+        EngineDecorator::pollEvents(m_polled);
+
+        // The caller only knows the proxies of the windows.
+        for (std::size_t id = first ; id < m_polled.size() ; ++id) {
+          Proxies::const_iterator win = m_windows.find(m_polled[id]->getWindID());
+          if (win != m_windows.cend()) {
+            m_polled[id]->setWindowID(win->second);
+          }
+        }
+
+        std::size_t pushed = 0u;
+        while (pushed < m_polled.size() && m_events.push(std::move(m_polled[pushed]))) {
+          ++pushed;
+        }
+
+        m_polled.erase(m_polled.begin(), m_polled.begin() + pushed);
+      }
+
+    }
+  }
+}
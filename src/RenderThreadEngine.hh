@@ -0,0 +1,406 @@
+#ifndef    RENDER_THREAD_ENGINE_HH
+# define   RENDER_THREAD_ENGINE_HH
+
+# include <mutex>
+# include <optional>
+# include <atomic>
+# include <memory>
+# include <string>
+# include <thread>
+# include <vector>
+# include <cstdint>
+# include <functional>
+# include <unordered_map>
+# include "EngineDecorator.hh"
+# include "RingBuffer.hh"
+
+namespace sdl {
+  namespace core {
+    namespace engine {
+
+      /**
+       * @brief - An engine executing all the calls to the wrapped engine on a
+       *          dedicated render thread, which thus owns all the renderers.
+       *          Calls which do not produce a result are turned into commands
+       *          appended to a lock-free queue and return right away: callers
+       *          never wait for the rendering to happen.
+       *          Windows and textures are identified by proxy identifiers
+       *          returned as soon as their creation is queued: they are
+       *          translated into the real identifiers by the render thread. The
+       *          role and the size of the textures and the statistics of the
+       *          windows are kept in a mirror as soon as they are known so that
+       *          they can be queried without waiting.
+       *          Events are polled by the render thread into a queue which the
+       *          caller drains: each call to `pollEvents` returns the events
+       *          polled since the previous call and requests a new poll.
+       *          Fonts don't use any renderer: they are created and measured
+       *          directly from the calling thread, which requires the wrapped
+       *          engine to be thread safe.
+       *          Only a few queries still wait for the render thread: reading
+       *          back the pixels of a window, flushing the commands and querying
+       *          a texture whose size or role can only be known once it is
+       *          created (e.g. the size of a text texture).
+       *          Errors raised while executing a command are logged by the
+       *          render thread while errors raised by a query are forwarded to
+       *          the caller. Commands using a texture or a window which could not
+       *          be created raise an error.
+       */
+      class RenderThreadEngine: public EngineDecorator {
+        public:
+
+          /**
+           * @brief - Creates the engine and starts its render thread.
+           * @param engine - the engine to which calls are forwarded.
+           * @param capacity - the number of commands which can be queued before
+           *                   callers have to wait for the render thread.
+           * @param name - the name of the engine.
+           */
+          RenderThreadEngine(EngineShPtr engine,
+                             std::size_t capacity = 4096u,
+                             const std::string& name = std::string("render_thread_engine"));
+
+          /**
+           * @brief - Executes the commands already queued and stops the render
+           *          thread. If the engine is destroyed by the render thread itself
+           *          the remaining commands are executed right away and the thread
+           *          exits on its own.
+           */
+          ~RenderThreadEngine();
+
+          /**
+           * @brief - Waits until all the commands queued so far are executed.
+           */
+          void
+          flush();
+
+          utils::Uuid
+          createWindow(const utils::Sizei& size,
+                       const bool resizable = true,
+                       const std::string& title = std::string("Default SDL window")) override;
+
+          void
+          setWindowIcon(const utils::Uuid& uuid,
+                        const std::string& icon) override;
+
+          void
+          clearWindow(const utils::Uuid& uuid) override;
+
+          void
+          renderWindow(const utils::Uuid& uuid) override;
+
+          void
+          updateViewport(const utils::Uuid& uuid,
+                         const utils::Boxf& area) override;
+
+          void
+          setWindowRetained(const utils::Uuid& uuid,
+                            bool retained) override;
+
+          void
+          invalidateWindow(const utils::Uuid& uuid,
+                           const utils::Boxf* area = nullptr) override;
+
+          void
+          setWindowFramePacing(const utils::Uuid& uuid,
+                               float rate,
+                               bool vsync) override;
+
+          FrameStats
+          getWindowFrameStats(const utils::Uuid& uuid) override;
+
+          Window::DamageStats
+          getWindowDamageStats(const utils::Uuid& uuid) override;
+
+          SurfaceTexture::RawSurfaceDataShPtr
+          readWindowPixels(const utils::Uuid& uuid) override;
+
+          void
+          destroyWindow(const utils::Uuid& uuid) override;
+
+          utils::Uuid
+          createTexture(const utils::Uuid& win,
+                        const utils::Sizef& size,
+                        const Palette::ColorRole& role) override;
+
+          utils::Uuid
+          createTexture(const utils::Sizef& size,
+                        const Palette::ColorRole& role) override;
+
+          utils::Uuid
+          createTextureFromFile(const utils::Uuid& win,
+                                ImageShPtr img,
+                                const Palette::ColorRole& role) override;
+
+          utils::Uuid
+          createTextureFromFile(ImageShPtr img,
+                                const Palette::ColorRole& role) override;
+
+          utils::Uuid
+          createTextureFromFileAsync(const utils::Uuid& win,
+                                     ImageShPtr img,
+                                     const Palette::ColorRole& role) override;
+
+          utils::Uuid
+          createTextureFromText(const utils::Uuid& win,
+                                const std::string& text,
+                                const utils::Uuid& font,
+                                const Palette::ColorRole& role) override;
+
+          utils::Uuid
+          createTextureFromText(const std::string& text,
+                                const utils::Uuid& font,
+                                const Palette::ColorRole& role) override;
+
+          /**
+           * @brief - Queues the creation of a texture from the brush. The brush is
+           *          rendered later on by the render thread: a snapshot of its
+           *          content is taken so that the caller can keep using it.
+           * @param brush - the brush from which the texture should be created.
+           * @return - the identifier of the texture.
+           */
+          utils::Uuid
+          createTextureFromBrush(BrushShPtr brush) override;
+
+          utils::Uuid
+          createTextureFromBrush(const utils::Uuid& win,
+                                 BrushShPtr brush) override;
+
+          void
+          fillTexture(const utils::Uuid& uuid,
+                      const Palette& palette,
+                      const utils::Boxf* area = nullptr) override;
+
+          void
+          setTextureAlpha(const utils::Uuid& uuid,
+                          const Color& color) override;
+
+          Palette::ColorRole
+          getTextureRole(const utils::Uuid& uuid) override;
+
+          void
+          setTextureRole(const utils::Uuid& uuid,
+                         const Palette::ColorRole& role) override;
+
+          void
+          drawTexture(const utils::Uuid& tex,
+                      const utils::Boxf* from = nullptr,
+                      const utils::Uuid* on = nullptr,
+                      const utils::Boxf* where = nullptr) override;
+
+          utils::Sizef
+          queryTexture(const utils::Uuid& uuid) override;
+
+          utils::Sizef
+          getTextSize(const std::string& text,
+                      const utils::Uuid& font,
+                      bool exact) override;
+
+          void
+          destroyTexture(const utils::Uuid& uuid) override;
+
+          utils::Uuid
+          createColoredFont(const std::string& name,
+                            const Palette& palette,
+                            int size = 25) override;
+
+          void
+          destroyColoredFont(const utils::Uuid& uuid) override;
+
+          std::vector<EventShPtr>
+          pollEvents() override;
+
+          /**
+           * @brief - Appends the events polled by the render thread since the last
+           *          call and requests a new poll. The events thus come with a delay
+           *          of one call but the caller never waits for the render thread.
+           *          This should always be called from the same thread.
+           * @param out - the vector to which the events are appended.
+           */
+          void
+          pollEvents(std::vector<EventShPtr>& out) override;
+
+        private:
+
+          using Command = std::function<void(void)>;
+
+          /**
+           * @brief - The information about a texture available without waiting for
+           *          the render thread. Each value is empty until it is known.
+           */
+          struct TextureInfo {
+            std::optional<Palette::ColorRole> role;
+            std::optional<utils::Sizef> size;
+          };
+
+          /**
+           * @brief - The statistics of a window as of the last frame rendered.
+           */
+          struct WindowInfo {
+            FrameStats frames;
+            Window::DamageStats damage;
+          };
+
+          using Proxies = std::unordered_map<utils::Uuid, utils::Uuid>;
+          using Mirror = std::unordered_map<utils::Uuid, TextureInfo>;
+          using WindowsMirror = std::unordered_map<utils::Uuid, WindowInfo>;
+
+          /**
+           * @brief - Whether the calling thread is the render thread.
+           * @return - `true` if called from the render thread.
+           */
+          bool
+          isRenderThread() const noexcept;
+
+          /**
+           * @brief - Queues a command for the render thread. If the queue is full
+           *          the caller waits for some room to be available. Commands posted
+           *          from the render thread are executed right away.
+           * @param command - the command to execute.
+           */
+          void
+          post(Command command);
+
+          /**
+           * @brief - Executes the input task on the render thread and waits for its
+           *          result. Any error raised by the task is forwarded to the caller.
+           * @param task - the task to execute.
+           * @return - the value produced by the task.
+           */
+          template <typename Result>
+          Result
+          call(std::function<Result(void)> task);
+
+          /**
+           * @brief - Executes the commands until the engine is stopped.
+           */
+          void
+          loop();
+
+          /**
+           * @brief - Executes a command, logging the errors it might raise.
+           * @param command - the command to execute.
+           */
+          void
+          execute(Command& command);
+
+          /**
+           * @brief - Creates a proxy identifier for a new texture and registers its
+           *          information in the mirror.
+           * @param role - the role of the texture if it is already known, `null`
+           *               otherwise.
+           * @param size - the size of the texture if it is already known, `null`
+           *               otherwise.
+           * @return - the proxy identifier of the texture.
+           */
+          utils::Uuid
+          createProxy(const Palette::ColorRole* role,
+                      const utils::Sizef* size);
+
+          /**
+           * @brief - Creates a texture in the wrapped engine and associates its proxy
+           *          to the real identifier. If the creation fails the proxy is marked
+           *          as such so that the commands using it raise an error. Must be
+           *          called from the render thread.
+           * @param proxy - the proxy identifier of the texture.
+           * @param factory - creates the texture and returns its identifier.
+           * @param query - `true` if the size and role of the texture should be
+           *                queried and stored in the mirror.
+           */
+          void
+          bind(const utils::Uuid& proxy,
+               const std::function<utils::Uuid(void)>& factory,
+               bool query);
+
+          /**
+           * @brief - Translates a proxy into the real identifier of the texture or
+           *          of the window. Any identifier which is not a proxy is returned
+           *          as is. An error is raised if the proxy refers to a texture or a
+           *          window which could not be created. Must be called from the
+           *          render thread.
+           * @param uuid - the identifier to translate.
+           * @return - the identifier to use with the wrapped engine.
+           */
+          utils::Uuid
+          resolve(const utils::Uuid& uuid) const;
+
+          /**
+           * @brief - Stores the statistics of the window in the mirror. Must be
+           *          called from the render thread.
+           * @param proxy - the proxy identifier of the window.
+           * @param uuid - the identifier of the window in the wrapped engine.
+           */
+          void
+          updateWindowInfo(const utils::Uuid& proxy,
+                           const utils::Uuid& uuid);
+
+          /**
+           * @brief - Polls the events of the wrapped engine and queues them for
+           *          the caller of `pollEvents`. The window identifiers are turned
+           *          into their proxies. Events which can't be queued are kept for
+           *          the next poll. Must be called from the render thread.
+           */
+          void
+          fetchEvents();
+
+        private:
+
+          RingBuffer<Command> m_commands;
+
+          /**
+           * @brief - Counts the commands posted so far: the render thread waits on
+           *          it when there are no commands to execute.
+           */
+          std::atomic<std::uint64_t> m_posted;
+
+          bool m_running;
+
+          /**
+           * @brief - The identifier of the render thread, set by the thread itself
+           *          when it starts.
+           */
+          std::atomic<std::thread::id> m_renderThread;
+
+          /**
+           * @brief - Raised when the engine is destroyed from the render thread, in
+           *          which case the thread should not use any member anymore. It
+           *          points to a variable owned by the render thread.
+           */
+          bool* m_destroyed;
+
+          /**
+           * @brief - The real identifiers of the textures and of the windows indexed
+           *          by their proxy, and the proxies of the windows indexed by their
+           *          real identifier. The real identifier is invalid if the creation
+           *          failed. Only accessed from the render thread.
+           */
+          Proxies m_proxies;
+          Proxies m_windows;
+
+          std::mutex m_mirrorLocker;
+          Mirror m_mirror;
+          WindowsMirror m_windowsMirror;
+
+          /**
+           * @brief - The events polled by the render thread and not yet retrieved
+           *          by the caller. Events which did not fit in the queue are kept
+           *          in the buffer until the next poll. The flag indicates whether
+           *          a poll is already requested.
+           */
+          RingBuffer<EventShPtr> m_events;
+          std::vector<EventShPtr> m_polled;
+          std::atomic<bool> m_polling;
+
+          /**
+           * @brief - The render thread. It is started once the engine is configured.
+           */
+          std::thread m_thread;
+      };
+
+      using RenderThreadEngineShPtr = std::shared_ptr<RenderThreadEngine>;
+    }
+  }
+}
+
+# include "RenderThreadEngine.hxx"
+
+#endif    /* RENDER_THREAD_ENGINE_HH */
@@ -0,0 +1,50 @@
+#ifndef    RENDER_THREAD_ENGINE_HXX
+# define   RENDER_THREAD_ENGINE_HXX
+
+# include "RenderThreadEngine.hh"
+# include <future>
+# include <exception>
+
+namespace sdl {
+  namespace core {
+    namespace engine {
+
+      inline
+      bool
+      RenderThreadEngine::isRenderThread() const noexcept {
+        return std::this_thread::get_id() == m_renderThread.load(std::memory_order_acquire);
+      }
+
+      template <typename Result>
+      inline
+      Result
+      RenderThreadEngine::call(std::function<Result(void)> task) {
+        // Executing the task right away avoids waiting for ourselves.
+        if (isRenderThread()) {
+          return task();
+        }
+
+        // The promise is shared with the command so that it stays alive until
+        // the command is done with it, even if the caller returned already.
+        std::shared_ptr<std::promise<Result>> promise = std::make_shared<std::promise<Result>>();
+        std::future<Result> result = promise->get_future();
+
+        post(
+          [promise, task]() {
+            try {
+              promise->set_value(task());
+            }
+            catch (...) {
+              promise->set_exception(std::current_exception());
+            }
+          }
+        );
+
+        return result.get();
+      }
+
+    }
+  }
+}
+
+#endif    /* RENDER_THREAD_ENGINE_HXX */
@@ -0,0 +1,92 @@
+#ifndef    RING_BUFFER_HH
+# define   RING_BUFFER_HH
+
+# include <atomic>
+# include <memory>
+# include <cstddef>
+
+namespace sdl {
+  namespace core {
+    namespace engine {
+
+      /**
+       * @brief - A bounded queue which can be filled by several threads and
+       *          consumed by a single one without any lock. Each slot holds a
+       *          sequence number indicating whether it is ready to be written
+       *          or read: producers reserve a slot by advancing the tail and
+       *          publish the value by updating the sequence of the slot.
+       *          When the queue is full, pushing fails and it is up to the
+       *          caller to decide what to do.
+       */
+      template <typename Value>
+      class RingBuffer {
+        public:
+
+          /**
+           * @brief - Creates a ring buffer able to hold at least the input count of
+           *          values. The capacity is rounded up to a power of two.
+           * @param capacity - the minimum number of values the buffer can hold.
+           */
+          explicit
+          RingBuffer(std::size_t capacity);
+
+          RingBuffer(const RingBuffer&) = delete;
+
+          RingBuffer&
+          operator=(const RingBuffer&) = delete;
+
+          /**
+           * @brief - Returns the number of values the buffer can hold.
+           * @return - the capacity of the buffer.
+           */
+          std::size_t
+          getCapacity() const noexcept;
+
+          /**
+           * @brief - Attempts to append a value at the end of the buffer. This can
+           *          be called concurrently by several threads. The value is left
+           *          untouched if the buffer is full.
+           * @param value - the value to append.
+           * @return - `true` if the value was appended, `false` if the buffer is full.
+           */
+          bool
+          push(Value&& value);
+
+          /**
+           * @brief - Attempts to remove the first value of the buffer. Only a single
+           *          thread should call this method.
+           * @param value - output argument receiving the value.
+           * @return - `true` if a value was retrieved, `false` if the buffer is empty.
+           */
+          bool
+          pop(Value& value);
+
+        private:
+
+          /**
+           * @brief - A slot of the buffer. Slots are aligned on cache lines to avoid
+           *          false sharing between producers writing consecutive slots.
+           */
+          struct alignas(64) Slot {
+            std::atomic<std::size_t> sequence;
+            Value value;
+          };
+
+          std::size_t m_mask;
+          std::unique_ptr<Slot[]> m_slots;
+
+          /**
+           * @brief - The position of the next slot to write, shared by producers, and
+           *          of the next slot to read, only used by the consumer.
+           */
+          alignas(64) std::atomic<std::size_t> m_tail;
+          alignas(64) std::size_t m_head;
+      };
+
+    }
+  }
+}
+
+# include "RingBuffer.hxx"
+
+#endif    /* RING_BUFFER_HH */
@@ -0,0 +1,96 @@
+#ifndef    RING_BUFFER_HXX
+# define   RING_BUFFER_HXX
+
+# include "RingBuffer.hh"
+# include <bit>
+# include <algorithm>
+# include <utility>
+
+namespace sdl {
+  namespace core {
+    namespace engine {
+
+      template <typename Value>
+      inline
+      RingBuffer<Value>::RingBuffer(std::size_t capacity):
+        m_mask(std::bit_ceil(std::max(capacity, std::size_t(2u))) - 1u),
+        m_slots(std::make_unique<Slot[]>(m_mask + 1u)),
+
+        m_tail(0u),
+        m_head(0u)
+      {
+        // Each slot is initially ready to be written for the first pass on
+        // the buffer.
+        for (std::size_t id = 0u ; id <= m_mask ; ++id) {
+          m_slots[id].sequence.store(id, std::memory_order_relaxed);
+        }
+      }
+
+      template <typename Value>
+      inline
+      std::size_t
+      RingBuffer<Value>::getCapacity() const noexcept {
+        return m_mask + 1u;
+      }
+
+      template <typename Value>
+      inline
+      bool
+      RingBuffer<Value>::push(Value&& value) {
+        std::size_t pos = m_tail.load(std::memory_order_relaxed);
+        Slot* slot = nullptr;
+
+        while (true) {
+          slot = &m_slots[pos & m_mask];
+
+          // The slot is ready to be written if its sequence matches the
+          // position: in this case we try to reserve it. If it is behind,
+          // the consumer did not read it yet and the buffer is full.
+          const std::size_t sequence = slot->sequence.load(std::memory_order_acquire);
+          const std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(sequence - pos);
+
+          if (diff == 0) {
+            if (m_tail.compare_exchange_weak(pos, pos + 1u, std::memory_order_relaxed)) {
+              break;
+            }
+          }
+          else if (diff < 0) {
+            return false;
+          }
+          else {
+            pos = m_tail.load(std::memory_order_relaxed);
+          }
+        }
+
+        slot->value = std::move(value);
+        slot->sequence.store(pos + 1u, std::memory_order_release);
+
+        return true;
+      }
+
+      template <typename Value>
+      inline
+      bool
+      RingBuffer<Value>::pop(Value& value) {
+        Slot& slot = m_slots[m_head & m_mask];
+
+        // The slot is readable once the producer published it.
+        if (slot.sequence.load(std::memory_order_acquire) != m_head + 1u) {
+          return false;
+        }
+
+        value = std::move(slot.value);
+        slot.value = Value();
+
+        // Make the slot available to producers for the next pass.
+        slot.sequence.store(m_head + m_mask + 1u, std::memory_order_release);
+        ++m_head;
+
+        return true;
+      }
+
+    }
+  }
+}
+
+#endif    /* RING_BUFFER_HXX */
@@ -1,5 +1,9 @@
 
 # include "SdlEngine.hh"
+# include <algorithm>
+# include <chrono>
+# include <thread>
+# include <core_utils/SafetyNet.hh>
 # include "EventFactory.hh"
 
 namespace sdl {
@@ -16,13 +20,16 @@ namespace sdl {
         const std::lock_guard guard(m_locker);
 
         // Attempt to create a window with the specified dimensions.
-        WindowShPtr window = std::make_shared<Window>(size, resizable, title);
+        WindowShPtr window = std::make_shared<Window>(size, resizable, title, m_backend);
 
-        // Register this window in the internal tables.
+        // Register this window in the internal tables. Offscreen windows don't
+        // receive any events so they don't need to be found from their SDL id.
         utils::Uuid uuid = utils::Uuid::create();
         m_windows[uuid] = window;
 
-        m_winIDToWindows[window->getSDLID()] = uuid;
+        if (m_backend != RenderBackend::Offscreen) {
+          m_winIDToWindows[window->getSDLID()] = uuid;
+        }
 
         return uuid;
       }
@@ -47,7 +54,9 @@ namespace sdl {
         // Retrieve the required window.
         WindowShPtr win = getWindowOrThrow(uuid);
 
-        // Clear its content.
+        // Clear its content: the areas damaged by paint events are cleared
+        // along with the rest.
+        applyPendingDamage(uuid, *win);
         win->clear();
       }
 
@@ -59,6 +68,7 @@ namespace sdl {
         WindowShPtr win = getWindowOrThrow(uuid);
 
         // Render its content.
+        applyPendingDamage(uuid, *win);
         win->render();
       }
 
@@ -75,6 +85,76 @@ namespace sdl {
         win->updateViewport(area);
       }
 
+      void
+      SdlEngine::setWindowRetained(const utils::Uuid& uuid,
+                                   bool retained)
+      {
+        const std::lock_guard guard(m_locker);
+
+        // Retrieve the required window.
+        WindowShPtr win = getWindowOrThrow(uuid);
+
+        // Update its rendering mode.
+        win->setRetained(retained);
+      }
+
+      void
+      SdlEngine::invalidateWindow(const utils::Uuid& uuid,
+                                  const utils::Boxf* area)
+      {
+        const std::lock_guard guard(m_locker);
+
+        // Retrieve the required window.
+        WindowShPtr win = getWindowOrThrow(uuid);
+
+        // Damage the input area.
+        win->invalidate(area);
+      }
+
+      void
+      SdlEngine::setWindowFramePacing(const utils::Uuid& uuid,
+                                      float rate,
+                                      bool vsync)
+      {
+        const std::lock_guard guard(m_locker);
+
+        // Retrieve the required window.
+        WindowShPtr win = getWindowOrThrow(uuid);
+
+        // Update its pacing.
+        win->setFramePacing(rate, vsync);
+      }
+
+      FrameStats
+      SdlEngine::getWindowFrameStats(const utils::Uuid& uuid) {
+        const std::lock_guard guard(m_locker);
+
+        // Retrieve the required window.
+        WindowShPtr win = getWindowOrThrow(uuid);
+
+        return win->getFrameStats();
+      }
+
+      SurfaceTexture::RawSurfaceDataShPtr
+      SdlEngine::readWindowPixels(const utils::Uuid& uuid) {
+        const std::lock_guard guard(m_locker);
+
+        // Retrieve the required window.
+        WindowShPtr win = getWindowOrThrow(uuid);
+
+        return win->readPixels();
+      }
+
+      Window::DamageStats
+      SdlEngine::getWindowDamageStats(const utils::Uuid& uuid) {
+        const std::lock_guard guard(m_locker);
+
+        // Retrieve the required window.
+        WindowShPtr win = getWindowOrThrow(uuid);
+
+        return win->getDamageStats();
+      }
+
       void
       SdlEngine::destroyWindow(const utils::Uuid& uuid) {
         const std::lock_guard guard(m_locker);
@@ -82,6 +162,11 @@ namespace sdl {
         // Erase the window from the internal map.
         const std::size_t erased = m_windows.erase(uuid);
 
+        {
+          const std::lock_guard damage(m_damageLocker);
+          m_pendingDamage.erase(uuid);
+        }
+
         // Warn the user if the window could not be removed.
         if (erased != 1) {
           warn("Could not erase inexisting window " + uuid.toString());
@@ -126,6 +211,54 @@ namespace sdl {
         return registerTextureForWindow(tex, win);
       }
 
+      utils::Uuid
+      SdlEngine::createTextureFromFileAsync(const utils::Uuid& win,
+                                            ImageShPtr img,
+                                            const Palette::ColorRole& role)
+      {
+        // Acquire the lock so that we do not create multiple textures at the
+        // same time.
+        const std::lock_guard guard(m_locker);
+
+        // Try to retrieve the desired window from which the texture should be created.
+        WindowShPtr parentWin = getWindowOrThrow(win);
+
+        // Create the desired texture: it will use a placeholder until the image
+        // is decoded.
+        utils::Uuid tex = parentWin->createTextureFromFileAsync(img, role);
+
+        // Schedule the decoding of the image if needed. The pool of threads is
+        // created the first time it is needed.
+        if (img != nullptr && !img->isReady()) {
+          if (m_decoder == nullptr) {
+            const unsigned workers = std::max(1u, std::thread::hardware_concurrency() / 2u);
+            m_decoder = std::make_shared<Executor>(workers, std::string("image_decoder"));
+          }
+
+          ++m_pendingDecodes;
+          const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+          m_decoder->post(
+            [this, img, start]() {
+              withSafetyNet(
+                [&img]() {
+                  img->preload();
+                },
+                std::string("decode")
+              );
+
+              const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+              m_decodeTime += std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+              ++m_decodedImages;
+              --m_pendingDecodes;
+            }
+          );
+        }
+
+        // Register it into the internal table and return it.
+        return registerTextureForWindow(tex, win);
+      }
+
       utils::Uuid
       SdlEngine::createTextureFromText(const utils::Uuid& win,
                                        const std::string& text,
@@ -140,6 +273,7 @@ namespace sdl {
         WindowShPtr parentWin = getWindowOrThrow(win);
 
         // Try to retrieve the font corresponding to the input uuid.
+        const std::lock_guard fonts(m_fontsLocker);
         ColoredFontShPtr coloredFont = getFontOrThrow(font);
 
         // Create the desired texture.
@@ -280,7 +414,7 @@ namespace sdl {
                              const utils::Uuid& font,
                              bool exact)
       {
-        const std::lock_guard guard(m_locker);
+        const std::lock_guard guard(m_fontsLocker);
 
         // Retrieve the font associated to the input identifier.
         ColoredFontShPtr fontImpl = getFontOrThrow(font);
@@ -315,7 +449,7 @@ namespace sdl {
                                    const Palette& palette,
                                    int size)
       {
-        const std::lock_guard guard(m_locker);
+        const std::lock_guard guard(m_fontsLocker);
 
         // Create the font using the internal factory.
         ColoredFontShPtr font = m_fontFactory->createColoredFont(name, palette, size);
@@ -329,7 +463,7 @@ namespace sdl {
 
       void
       SdlEngine::destroyColoredFont(const utils::Uuid& uuid) {
-        const std::lock_guard guard(m_locker);
+        const std::lock_guard guard(m_fontsLocker);
 
         // Erase the font from the internal map.
         const std::size_t erased = m_fonts.erase(uuid);
@@ -342,45 +476,47 @@ namespace sdl {
 
       std::vector<EventShPtr>
       SdlEngine::pollEvents() {
+        std::vector<EventShPtr> events;
+        pollEvents(events);
+
+        return events;
+      }
+
+      void
+      SdlEngine::pollEvents(std::vector<EventShPtr>& out) {
         // Poll all events available in the queue.
-        SDL_Event sdlEvent;
-        bool moreEvents = true;
+        fetchRawEvents();
+
+        for (std::vector<SDL_Event>::const_iterator sdlEvent = m_rawEvents.cbegin() ;
+             sdlEvent != m_rawEvents.cend() ;
+             ++sdlEvent)
+        {
+          // The content of an exposed window might have been lost: it should
+          // be presented again even if it did not change.
+          if (sdlEvent->type == SDL_WINDOWEVENT && sdlEvent->window.event == SDL_WINDOWEVENT_EXPOSED) {
+            invalidateExposedWindow(sdlEvent->window.windowID);
+          }
 
-        std::vector<EventShPtr> events;
+          // Create this event.
+          EventShPtr event = EventFactory::create(*sdlEvent);
 
-        while (moreEvents) {
-          // Poll the next event in the queue.
-          moreEvents = SDL_PollEvent(&sdlEvent);
-
-          // If an event is available store it in the return array.
-          if (moreEvents) {
-            // Create this event.
-            EventShPtr event = EventFactory::create(sdlEvent);
-
-            // Check whether the event could be created.
-            if (event != nullptr) {
-              // Populate additional data for this event if needed.
-              event->populateFromEngineData(*this);
-
-              events.push_back(event);
-
-              // Also in the case of a mouse event we want to update the
-              // internal mouse state.
-              if (event->isMouseEvent()) {
-                std::vector<EventShPtr> newEvents = m_mouseState.updateEvent(
-                  *std::dynamic_pointer_cast<MouseEvent>(event)
-                );
-
-                // Insert all produced events to the list of events fetched
-                // from the underlying `API`.
-                events.insert(events.end(), newEvents.cbegin(), newEvents.cend());
-              }
-            }
+          // Check whether the event could be created.
+          if (event == nullptr) {
+            continue;
           }
-        }
 
-        // Return the list of events accumulated from the underlying `API`.
-        return events;
+          // Populate additional data for this event if needed.
+          event->populateFromEngineData(*this);
+
+          out.push_back(event);
+
+          // Also in the case of a mouse event we want to update the internal
+          // mouse state: the events it might produce are directly appended to
+          // the output vector.
+          if (event->isMouseEvent()) {
+            m_mouseState.updateEvent(dynamic_cast<MouseEvent&>(*event), out);
+          }
+        }
       }
 
       void
@@ -497,7 +633,34 @@ namespace sdl {
       void
       SdlEngine::populateEvent(PaintEvent& event) {
         // Populate the window id.
-        populateWindowIDEvent(event);
+        const utils::Uuid winID = populateWindowIDEvent(event);
+
+        if (!winID.valid()) {
+          return;
+        }
+
+        // The update regions of the event are damaged areas for the window. We
+        // can't interpret regions expressed in a local frame so in this case the
+        // whole window is damaged. The engine lock might already be held by the
+        // caller so the damage is only recorded here: it is applied to the window
+        // when it is cleared or rendered.
+        const std::lock_guard guard(m_damageLocker);
+        PendingDamage& damage = m_pendingDamage[winID];
+
+        const std::vector<update::Region>& regions = event.getUpdateRegions();
+        if (regions.empty()) {
+          damage.whole = true;
+          return;
+        }
+
+        for (unsigned id = 0u ; id < regions.size() ; ++id) {
+          if (regions[id].frame != update::Frame::Global) {
+            damage.whole = true;
+          }
+          else if (!damage.whole) {
+            damage.areas.push_back(regions[id].area);
+          }
+        }
       }
 
       void
@@ -538,10 +701,49 @@ namespace sdl {
         m_mouseState.updateFromWindowEvent(event);
       }
 
+      void
+      SdlEngine::invalidateExposedWindow(std::uint32_t winID) {
+        const std::lock_guard guard(m_locker);
+
+        const utils::Uuid uuid = getWindowUuidFromSDLWinID(winID);
+        if (!uuid.valid()) {
+          return;
+        }
+
+        getWindowOrThrow(uuid)->invalidate();
+      }
+
+      void
+      SdlEngine::applyPendingDamage(const utils::Uuid& uuid,
+                                    Window& win)
+      {
+        const std::lock_guard guard(m_damageLocker);
+
+        PendingDamageMap::iterator damage = m_pendingDamage.find(uuid);
+        if (damage == m_pendingDamage.end()) {
+          return;
+        }
+
+        if (damage->second.whole) {
+          win.invalidate();
+        }
+        else {
+          for (unsigned id = 0u ; id < damage->second.areas.size() ; ++id) {
+            win.invalidate(&damage->second.areas[id]);
+          }
+        }
+
+        damage->second.whole = false;
+        damage->second.areas.clear();
+      }
+
       void
       SdlEngine::initializeSDLLib() {
-        // Initialize the SDL lib.
-        if (!SDL_WasInit(SDL_INIT_VIDEO) && SDL_Init(SDL_INIT_VIDEO) != 0) {
+        // Initialize the SDL lib. Offscreen rendering does not need the video
+        // subsystem but we still want to be able to process events.
+        const std::uint32_t flags = (m_backend == RenderBackend::Offscreen ? SDL_INIT_EVENTS : SDL_INIT_VIDEO);
+
+        if (!SDL_WasInit(flags) && SDL_Init(flags) != 0) {
           error(
             std::string("Caught error while initializing SDL lib"),
             SDL_GetError()
@@ -551,11 +753,54 @@ namespace sdl {
 
       void
       SdlEngine::releaseSDLLib() {
-        if (SDL_WasInit(SDL_INIT_VIDEO)) {
+        if (SDL_WasInit(SDL_INIT_VIDEO | SDL_INIT_EVENTS)) {
           SDL_Quit();
         }
       }
 
+      void
+      SdlEngine::fetchRawEvents() {
+        // Reuse the internal buffer: its capacity is kept from one frame to
+        // the next so that we don't need to allocate anything once enough
+        // events have been seen.
+        m_rawEvents.clear();
+
+        const bool compress = m_compressMotions.load();
+        unsigned collapsed = 0u;
+
+        SDL_Event sdlEvent;
+
+        while (SDL_PollEvent(&sdlEvent)) {
+          // In case the compression of motions is activated, we check whether
+          // the event directly preceding this one is a motion for the same
+          // window with the same buttons pressed. If this is the case, it gets
+          // replaced by the new one which accumulates the relative motion of
+          // both. Only merging with the last event guarantees that the events
+          // are never reordered, including motions of different windows.
+          if (compress && sdlEvent.type == SDL_MOUSEMOTION && !m_rawEvents.empty()) {
+            const SDL_Event& prev = m_rawEvents.back();
+
+            if (prev.type == SDL_MOUSEMOTION &&
+                prev.motion.windowID == sdlEvent.motion.windowID &&
+                prev.motion.which == sdlEvent.motion.which &&
+                prev.motion.state == sdlEvent.motion.state)
+            {
+              sdlEvent.motion.xrel += prev.motion.xrel;
+              sdlEvent.motion.yrel += prev.motion.yrel;
+
+              m_rawEvents.pop_back();
+              ++collapsed;
+            }
+          }
+
+          m_rawEvents.push_back(sdlEvent);
+        }
+
+        if (collapsed > 0u) {
+          m_collapsedMotions.fetch_add(collapsed, std::memory_order_relaxed);
+        }
+      }
+
       utils::Uuid
       SdlEngine::populateWindowIDEvent(Event& event) {
         // We need to assign the window uuid from the SDL window ID of the event.
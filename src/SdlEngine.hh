@@ -2,7 +2,9 @@
 # define   SDL_ENGINE_HH
 
 # include <mutex>
+# include <atomic>
 # include <memory>
+# include <vector>
 # include <cstdint>
 # include <unordered_map>
 # include <core_utils/CoreObject.hh>
@@ -13,6 +15,7 @@
 # include "Texture.hh"
 # include "FontFactory.hh"
 # include "MouseState.hh"
+# include "Executor.hh"
 
 namespace sdl {
   namespace core {
@@ -21,7 +24,14 @@ namespace sdl {
       class SdlEngine : public Engine, public utils::CoreObject {
         public:
 
-          SdlEngine();
+          /**
+           * @brief - Creates the engine and initializes the SDL library.
+           * @param backend - how the windows created by the engine are rendered.
+           *                  Offscreen windows don't need any display which is
+           *                  useful for benchmarks and tests on headless machines.
+           */
+          explicit
+          SdlEngine(const RenderBackend& backend = RenderBackend::Display);
 
           virtual ~SdlEngine();
 
@@ -44,6 +54,28 @@ namespace sdl {
           updateViewport(const utils::Uuid& uuid,
                          const utils::Boxf& area) override;
 
+          void
+          setWindowRetained(const utils::Uuid& uuid,
+                            bool retained) override;
+
+          void
+          invalidateWindow(const utils::Uuid& uuid,
+                           const utils::Boxf* area = nullptr) override;
+
+          void
+          setWindowFramePacing(const utils::Uuid& uuid,
+                               float rate,
+                               bool vsync) override;
+
+          FrameStats
+          getWindowFrameStats(const utils::Uuid& uuid) override;
+
+          Window::DamageStats
+          getWindowDamageStats(const utils::Uuid& uuid) override;
+
+          SurfaceTexture::RawSurfaceDataShPtr
+          readWindowPixels(const utils::Uuid& uuid) override;
+
           void
           destroyWindow(const utils::Uuid& uuid) override;
 
@@ -83,6 +115,21 @@ namespace sdl {
           createTextureFromFile(ImageShPtr img,
                                 const Palette::ColorRole& role) override;
 
+          /**
+           * @brief - Reimplementation of the base `Engine` method: the image is decoded
+           *          by a pool of threads and the texture is created with a placeholder.
+           *          The actual content of the image is uploaded the first time the
+           *          texture is used after the decoding completes.
+           * @param win - the window for which the texture should be created.
+           * @param img - the image from which the texture should be created.
+           * @param role - the role of the texture.
+           * @return - an identifier allowing to refer to the texture.
+           */
+          utils::Uuid
+          createTextureFromFileAsync(const utils::Uuid& win,
+                                     ImageShPtr img,
+                                     const Palette::ColorRole& role) override;
+
           utils::Uuid
           createTextureFromText(const utils::Uuid& win,
                                 const std::string& text,
@@ -157,6 +204,16 @@ namespace sdl {
           std::vector<EventShPtr>
           pollEvents() override;
 
+          /**
+           * @brief - Fetches the events from the `SDL` and appends them to the output
+           *          vector. Neither the internal buffers nor the output vector need to
+           *          be reallocated once they are large enough so polling events does
+           *          not allocate in the steady state, apart from the events themselves.
+           * @param out - the vector to which events are appended.
+           */
+          void
+          pollEvents(std::vector<EventShPtr>& out) override;
+
           void
           populateEvent(Event& event) override;
 
@@ -190,6 +247,44 @@ namespace sdl {
           void
           populateEvent(WindowEvent& event) override;
 
+          /**
+           * @brief - Used to activate or deactivate the compression of mouse motions
+           *          when polling events. When active, consecutive motion events for a
+           *          given window and a given set of pressed buttons are collapsed into
+           *          the most recent one, which accumulates the relative motion of all
+           *          of them. Motions are only collapsed when no other event lies in
+           *          between so the ordering of the events is preserved.
+           *          The compression is active by default.
+           * @param compress - `true` if the motions should be compressed.
+           */
+          void
+          setMotionCompression(bool compress) noexcept;
+
+          /**
+           * @brief - Returns the number of motion events which have been collapsed into
+           *          others since the creation of the engine.
+           * @return - the total number of collapsed motion events.
+           */
+          unsigned
+          getCollapsedMotionsCount() const noexcept;
+
+          /**
+           * @brief - Returns the number of images requested through the asynchronous
+           *          texture creation which are not yet decoded.
+           * @return - the number of images waiting to be decoded.
+           */
+          unsigned
+          getPendingDecodesCount() const noexcept override;
+
+          /**
+           * @brief - Returns the average time elapsed between the request to create
+           *          a texture asynchronously and the completion of the decoding of
+           *          its image. This includes the time spent waiting in the queue.
+           * @return - the average decode latency in milliseconds.
+           */
+          float
+          getDecodeLatency() const noexcept override;
+
         private:
 
           void
@@ -198,6 +293,34 @@ namespace sdl {
           void
           releaseSDLLib();
 
+          /**
+           * @brief - Fetches all the events available from the `SDL` and stores them
+           *          into the `m_rawEvents` buffer. Mouse motions are compressed if the
+           *          `m_compressMotions` flag is set.
+           */
+          void
+          fetchRawEvents();
+
+          /**
+           * @brief - Damages the whole content of the window described by the input
+           *          `SDL` identifier so that it is presented at the next frame.
+           *          Nothing happens if the window is not known.
+           * @param winID - the `SDL` identifier of the exposed window.
+           */
+          void
+          invalidateExposedWindow(std::uint32_t winID);
+
+          /**
+           * @brief - Damages the input window with the update regions of the paint
+           *          events populated for it since the last call. This should be
+           *          called with the engine lock held.
+           * @param uuid - the identifier of the window.
+           * @param win - the window to damage.
+           */
+          void
+          applyPendingDamage(const utils::Uuid& uuid,
+                             Window& win);
+
           /**
            * @brief - Used to populate the window's internal uuid from the
            *          window uuid provided by the SDL.
@@ -248,8 +371,29 @@ namespace sdl {
 
           using FontsMap = std::unordered_map<utils::Uuid, ColoredFontShPtr>;
 
+          /**
+           * @brief - The areas of a window damaged by paint events. Regions which
+           *          can't be interpreted in the window damage all of it.
+           */
+          struct PendingDamage {
+            bool whole;
+            std::vector<utils::Boxf> areas;
+          };
+
+          using PendingDamageMap = std::unordered_map<utils::Uuid, PendingDamage>;
+
+          RenderBackend m_backend;
+
           std::mutex m_locker;
 
+          /**
+           * @brief - Protects the fonts. It is distinct from the main lock, which
+           *          is held while rendering, so that text can be measured without
+           *          waiting for a frame to be presented. When both are needed the
+           *          main lock is acquired first.
+           */
+          std::mutex m_fontsLocker;
+
           FontFactoryShPtr m_fontFactory;
 
           WindowsMap m_windows;
@@ -264,6 +408,49 @@ namespace sdl {
            *          up-to-date relatively to the real state of the mouse.
            */
           MouseState m_mouseState;
+
+          /**
+           * @brief - Buffer used to store the raw events polled from the `SDL` before
+           *          converting them. It is kept from one frame to another to avoid
+           *          allocating memory each time events are polled.
+           */
+          std::vector<SDL_Event> m_rawEvents;
+
+          /**
+           * @brief - Whether consecutive motion events should be collapsed together.
+           */
+          std::atomic<bool> m_compressMotions;
+
+          /**
+           * @brief - The number of motion events collapsed since the creation of
+           *          the engine.
+           */
+          std::atomic<unsigned> m_collapsedMotions;
+
+          /**
+           * @brief - The damage produced by the paint events populated so far for
+           *          each window. Events may be populated while the engine lock is
+           *          held so the damage is protected by its own lock and merged in
+           *          the windows when they are cleared or rendered. Entries are
+           *          kept from one frame to the next to reuse their memory.
+           */
+          std::mutex m_damageLocker;
+          PendingDamageMap m_pendingDamage;
+
+          /**
+           * @brief - The pool of threads used to decode images in the background. It
+           *          is only created when a texture is first created asynchronously.
+           */
+          ExecutorShPtr m_decoder;
+
+          /**
+           * @brief - Statistics about the decoding of images: the number of images not
+           *          yet decoded, the number of decoded ones and the total time spent
+           *          to decode them in microseconds.
+           */
+          std::atomic<unsigned> m_pendingDecodes;
+          std::atomic<unsigned> m_decodedImages;
+          std::atomic<std::uint64_t> m_decodeTime;
       };
 
       using SdlEngineShPtr = std::shared_ptr<SdlEngine>;
@@ -9,11 +9,14 @@ namespace sdl {
     namespace engine {
 
       inline
-      SdlEngine::SdlEngine():
+      SdlEngine::SdlEngine(const RenderBackend& backend):
         Engine(),
         utils::CoreObject(std::string("sdl")),
 
+        m_backend(backend),
+
         m_locker(),
+        m_fontsLocker(),
 
         m_fontFactory(nullptr),
 
@@ -22,7 +25,19 @@ namespace sdl {
         m_textures(),
         m_fonts(),
 
-        m_mouseState()
+        m_mouseState(),
+
+        m_rawEvents(),
+        m_compressMotions(true),
+        m_collapsedMotions(0u),
+
+        m_damageLocker(),
+        m_pendingDamage(),
+
+        m_decoder(nullptr),
+        m_pendingDecodes(0u),
+        m_decodedImages(0u),
+        m_decodeTime(0u)
       {
         setService(std::string("engine"));
 
@@ -33,6 +48,9 @@ namespace sdl {
 
       inline
       SdlEngine::~SdlEngine() {
+        // Wait for the images being decoded: they might still use the `SDL`.
+        m_decoder.reset();
+
         // We need to clear the elements instantiated with the libraries before
         // unloading the libraries.
 
@@ -106,6 +124,35 @@ namespace sdl {
         return utils::Uuid();
       }
 
+      inline
+      void
+      SdlEngine::setMotionCompression(bool compress) noexcept {
+        m_compressMotions.store(compress);
+      }
+
+      inline
+      unsigned
+      SdlEngine::getCollapsedMotionsCount() const noexcept {
+        return m_collapsedMotions.load();
+      }
+
+      inline
+      unsigned
+      SdlEngine::getPendingDecodesCount() const noexcept {
+        return m_pendingDecodes.load();
+      }
+
+      inline
+      float
+      SdlEngine::getDecodeLatency() const noexcept {
+        const unsigned count = m_decodedImages.load();
+        if (count == 0u) {
+          return 0.0f;
+        }
+
+        return m_decodeTime.load() / (1000.0f * count);
+      }
+
       inline
       utils::Uuid
       SdlEngine::registerTextureForWindow(const utils::Uuid& tex,
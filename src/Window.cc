@@ -1,5 +1,6 @@
 
 # include "Window.hh"
+# include <algorithm>
 # include "TextureUtils.hxx"
 # include "RendererState.hh"
 # include "Image.hh"
@@ -10,6 +11,10 @@ namespace sdl {
 
       std::uint32_t
       Window::getSDLID() const {
+        if (m_backend == RenderBackend::Offscreen) {
+          return 0u;
+        }
+
         if (m_window == nullptr) {
           error(
             std::string("Cannot retrieve SDL window ID for"),
@@ -22,6 +27,10 @@ namespace sdl {
 
       utils::Sizef
       Window::getSize() const {
+        if (m_surface != nullptr) {
+          return utils::Sizef(m_surface->w, m_surface->h);
+        }
+
         if (m_window == nullptr) {
           error(
             std::string("Cannot retrieve dimensions of window"),
@@ -40,6 +49,11 @@ namespace sdl {
 
       void
       Window::setIcon(const std::string& icon) {
+        // Offscreen windows are not displayed.
+        if (m_window == nullptr) {
+          return;
+        }
+
         // Load this icon.
         Image iconData(icon);
 
@@ -81,6 +95,59 @@ namespace sdl {
         }
       }
 
+      utils::Uuid
+      Window::createTextureFromBrush(BrushShPtr brush) {
+        // Brushes which can't be shared are always rendered.
+        if (!brush->isCacheable()) {
+          return registerTexture(brush->render(m_renderer));
+        }
+
+        // Reuse the texture created for an identical brush if it is still
+        // alive. In this case the brush does not need to be rendered.
+        const std::uint64_t key = brush->getContentHash();
+
+        BrushTexturesMap::iterator it = m_brushTextures.find(key);
+        if (it != m_brushTextures.end() && brush->hasContent(it->second.content)) {
+          TextureShPtr tex = it->second.texture.lock();
+
+          if (tex != nullptr) {
+            brush->discard();
+
+            const utils::Uuid uuid = registerTexture(tex);
+            m_sharedTextures.insert(uuid);
+
+            return uuid;
+          }
+        }
+
+        // In case of a collision, the texture of the new brush replaces the
+        // existing one for future lookups.
+        const Brush::Content content = brush->getContent();
+        TextureShPtr tex = brush->render(m_renderer);
+        m_brushTextures[key] = BrushTexture{tex, content};
+
+        // Remove the textures which were released since the last time the
+        // map was cleaned up. The threshold grows with the number of live
+        // entries so that the cost of the cleanup stays amortized.
+        if (m_brushTextures.size() > m_brushTexturesSweep) {
+          for (it = m_brushTextures.begin() ; it != m_brushTextures.end() ; ) {
+            if (it->second.texture.expired()) {
+              it = m_brushTextures.erase(it);
+            }
+            else {
+              ++it;
+            }
+          }
+
+          m_brushTexturesSweep = std::max(std::size_t(64u), 2u * m_brushTextures.size());
+        }
+
+        const utils::Uuid uuid = registerTexture(tex);
+        m_sharedTextures.insert(uuid);
+
+        return uuid;
+      }
+
       void
       Window::drawTexture(const utils::Uuid& tex,
                           const utils::Boxf* from,
@@ -101,24 +168,313 @@ namespace sdl {
         // null, in which case we should set the renderer to perform
         // blit on default target.
         SDL_Texture* target = nullptr;
+        const SDL_Rect* clip = nullptr;
         if (on != nullptr) {
           // Try to retrieve the corresponding texture.
-          TextureShPtr base = getTextureOrThrow(*on);
+          TextureShPtr base = getMutableTextureOrThrow(*on);
 
           target = (*base)();
         }
+        else if (m_retained) {
+          // In retained mode the default target is the framebuffer. If the
+          // frame started with some damage only this area is redrawn, so the
+          // draw is clipped to it. Otherwise the area covered by the draw needs
+          // to be presented at the next frame.
+          target = getFramebuffer();
+          if (SDL_RectEmpty(&m_clip)) {
+            invalidate(where);
+          }
+          else {
+            clip = &m_clip;
+          }
+        }
 
         // Retrieve the texture to draw.
         TextureShPtr layer = getTextureOrThrow(tex);
 
         // Draw the layer on the base.
-        layer->draw(from, where, target);
+        layer->draw(from, where, target, clip);
+      }
+
+      void
+      Window::setRetained(bool retained) {
+        if (retained == m_retained) {
+          return;
+        }
+
+        m_retained = retained;
+
+        if (!m_retained) {
+          if (m_framebuffer != nullptr) {
+            SDL_DestroyTexture(m_framebuffer);
+            m_framebuffer = nullptr;
+          }
+
+          m_damage = SDL_Rect{0, 0, 0, 0};
+          m_clip = SDL_Rect{0, 0, 0, 0};
+
+          return;
+        }
+
+        // Create the framebuffer right away so that we can fall back to the
+        // immediate mode in case it fails.
+        if (getFramebuffer() == nullptr) {
+          warn("Could not create framebuffer for retained mode (err: " + std::string(SDL_GetError()) + ")");
+          m_retained = false;
+        }
+      }
+
+      void
+      Window::invalidate(const utils::Boxf* area) noexcept {
+        if (area == nullptr) {
+          int w = 0, h = 0;
+          SDL_GetRendererOutputSize(m_renderer, &w, &h);
+
+          addDamage(SDL_Rect{0, 0, w, h});
+        }
+        else {
+          addDamage(toSDLRect(*area));
+        }
+      }
+
+      void
+      Window::clear() noexcept {
+        SDL_Texture* framebuffer = (m_retained ? getFramebuffer() : nullptr);
+        if (framebuffer == nullptr) {
+          SDL_RenderClear(m_renderer);
+          return;
+        }
+
+        // Only the damaged area needs to be cleared: the rest of the framebuffer
+        // keeps the content of the previous frames. Note that clearing ignores
+        // the clip rectangle so we fill the area instead.
+        m_clip = m_damage;
+        if (SDL_RectEmpty(&m_damage)) {
+          return;
+        }
+
+        RendererState state(m_renderer);
+        SDL_SetRenderTarget(m_renderer, framebuffer);
+
+        SDL_BlendMode mode;
+        SDL_GetRenderDrawBlendMode(m_renderer, &mode);
+
+        SDL_SetRenderDrawBlendMode(m_renderer, SDL_BLENDMODE_NONE);
+        SDL_RenderFillRect(m_renderer, &m_damage);
+        SDL_SetRenderDrawBlendMode(m_renderer, mode);
+      }
+
+      void
+      Window::render() noexcept {
+        SDL_Texture* framebuffer = (m_retained ? getFramebuffer() : nullptr);
+
+        if (framebuffer == nullptr) {
+          SDL_RenderPresent(m_renderer);
+          recordFrame();
+
+          int w = 0, h = 0;
+          SDL_GetRendererOutputSize(m_renderer, &w, &h);
+
+          ++m_stats.presented;
+          m_stats.lastDamageArea = 1.0f * w * h;
+          m_damage = SDL_Rect{0, 0, 0, 0};
+
+          return;
+        }
+
+        // Nothing changed since the last frame: the window still displays the
+        // right content so there's no need to present anything.
+        m_clip = SDL_Rect{0, 0, 0, 0};
+        if (SDL_RectEmpty(&m_damage)) {
+          ++m_stats.skipped;
+          m_stats.lastDamageArea = 0.0f;
+
+          m_presented = false;
+
+          return;
+        }
+
+        // The content of the back buffer is undefined after presenting so we
+        // can't only copy the damaged area: the whole framebuffer is blitted,
+        // which is a single copy handled by the GPU.
+        {
+          RendererState state(m_renderer);
+          SDL_SetRenderTarget(m_renderer, nullptr);
+          SDL_RenderCopy(m_renderer, framebuffer, nullptr, nullptr);
+        }
+
+        SDL_RenderPresent(m_renderer);
+        recordFrame();
+
+        ++m_stats.presented;
+        m_stats.lastDamageArea = 1.0f * m_damage.w * m_damage.h;
+        m_damage = SDL_Rect{0, 0, 0, 0};
+      }
+
+      void
+      Window::setFramePacing(float rate,
+                             bool vsync)
+      {
+        m_frameBudget = (rate > 0.0f ? 1000.0f / rate : 0.0f);
+
+# if SDL_VERSION_ATLEAST(2, 0, 18)
+        if (SDL_RenderSetVSync(m_renderer, vsync ? 1 : 0) != 0) {
+          warn("Could not " + std::string(vsync ? "enable" : "disable") + " vsync (err: " + SDL_GetError() + ")");
+        }
+# else
+        if (vsync) {
+          warn("Could not enable vsync (err: not supported by this version of the SDL)");
+        }
+# endif
+
+        m_frames.reset();
+        m_presented = false;
+      }
+
+      SDL_Texture*
+      Window::getFramebuffer() noexcept {
+        int w = 0, h = 0;
+        if (SDL_GetRendererOutputSize(m_renderer, &w, &h) != 0) {
+          return nullptr;
+        }
+
+        if (m_framebuffer != nullptr) {
+          int fw = 0, fh = 0;
+          SDL_QueryTexture(m_framebuffer, nullptr, nullptr, &fw, &fh);
+
+          if (fw == w && fh == h) {
+            return m_framebuffer;
+          }
+
+          SDL_DestroyTexture(m_framebuffer);
+        }
+
+        m_framebuffer = SDL_CreateTexture(
+          m_renderer,
+          SDL_PIXELFORMAT_ARGB8888,
+          SDL_TEXTUREACCESS_TARGET,
+          w,
+          h
+        );
+
+        if (m_framebuffer == nullptr) {
+          return nullptr;
+        }
+
+        // The content of a new texture is undefined: clear it and consider
+        // that the whole window is damaged. Draws are not clipped anymore as
+        // they will all be presented.
+        m_clip = SDL_Rect{0, 0, 0, 0};
+        {
+          RendererState state(m_renderer);
+          SDL_SetRenderTarget(m_renderer, m_framebuffer);
+          SDL_RenderClear(m_renderer);
+        }
+
+        addDamage(SDL_Rect{0, 0, w, h});
+
+        return m_framebuffer;
+      }
+
+      void
+      Window::addDamage(const SDL_Rect& area) noexcept {
+        // Restrict the area to the window so that the damage reflects what is
+        // actually visible.
+        int w = 0, h = 0;
+        SDL_GetRendererOutputSize(m_renderer, &w, &h);
+
+        const SDL_Rect bounds{0, 0, w, h};
+        SDL_Rect visible;
+
+        if (!SDL_IntersectRect(&area, &bounds, &visible)) {
+          return;
+        }
+
+        if (SDL_RectEmpty(&m_damage)) {
+          m_damage = visible;
+        }
+        else {
+          SDL_UnionRect(&m_damage, &visible, &m_damage);
+        }
+      }
+
+      SurfaceTexture::RawSurfaceDataShPtr
+      Window::readPixels() {
+        SDL_Texture* framebuffer = (m_retained ? getFramebuffer() : nullptr);
+
+        RendererState state(m_renderer);
+        SDL_SetRenderTarget(m_renderer, framebuffer);
+
+        int w = 0, h = 0;
+        if (framebuffer != nullptr) {
+          SDL_QueryTexture(framebuffer, nullptr, nullptr, &w, &h);
+        }
+        else {
+          SDL_GetRendererOutputSize(m_renderer, &w, &h);
+        }
+
+        std::vector<std::uint32_t> pixels(static_cast<std::size_t>(w) * h);
+
+        if (SDL_RenderReadPixels(m_renderer, nullptr, SDL_PIXELFORMAT_ARGB8888, pixels.data(), static_cast<int>(w * sizeof(std::uint32_t))) != 0) {
+          error(
+            std::string("Could not read pixels of window"),
+            SDL_GetError()
+          );
+        }
+
+        std::vector<PackedColor> colors;
+        colors.reserve(pixels.size());
+
+        for (unsigned id = 0u ; id < pixels.size() ; ++id) {
+          colors.push_back(PackedColor(pixels[id]));
+        }
+
+        return SurfaceTexture::createFromData(utils::Sizei(w, h), colors);
+      }
+
+      void
+      Window::recordFrame() noexcept {
+        const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+        if (m_presented) {
+          const float duration = std::chrono::duration<float, std::milli>(now - m_lastPresent).count();
+          const bool missed = (m_frameBudget > 0.0f && duration > 1.5f * m_frameBudget);
+
+          m_frames.record(duration, missed);
+        }
+
+        m_presented = true;
+        m_lastPresent = now;
       }
 
       void
       Window::create(const utils::Sizei& size,
                      const bool resizable)
       {
+        // Offscreen windows are rendered by the software renderer directly in
+        // a surface: no window needs to be created.
+        if (m_backend == RenderBackend::Offscreen) {
+          m_surface = SDL_CreateRGBSurfaceWithFormat(0, size.w(), size.h(), 32, SDL_PIXELFORMAT_ARGB8888);
+
+          if (m_surface == nullptr) {
+            error(
+              std::string("Could not create surface for offscreen window"),
+              SDL_GetError()
+            );
+          }
+
+          m_renderer = SDL_CreateSoftwareRenderer(m_surface);
+
+          if (m_renderer == nullptr) {
+            error(
+              std::string("Could not create software renderer for offscreen window"),
+              SDL_GetError()
+            );
+          }
+
+          return;
+        }
+
         // Compute the flags from the input properties.
         std::uint32_t flags = SDL_WINDOW_SHOWN;
         if (resizable) {
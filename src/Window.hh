@@ -1,10 +1,12 @@
 #ifndef    WINDOW_HH
 # define   WINDOW_HH
 
+# include <chrono>
 # include <memory>
 # include <string>
 # include <cstdint>
 # include <unordered_map>
+# include <unordered_set>
 # include <SDL2/SDL.h>
 # include <core_utils/CoreObject.hh>
 # include <core_utils/Uuid.hh>
@@ -14,20 +16,50 @@
 # include "Palette.hh"
 # include "ColoredFont.hh"
 # include "Brush.hh"
+# include "FrameStats.hh"
+# include "SurfaceTexture.hh"
 
 namespace sdl {
   namespace core {
     namespace engine {
 
+      /**
+       * @brief - Describes how the content of the windows is rendered.
+       */
+      enum class RenderBackend {
+        Display,  //<! - Windows are displayed on screen and rendered with an
+                  //<!   accelerated renderer.
+        Offscreen //<! - Windows only exist in memory and are rendered by the
+                  //<!   software renderer. This does not require any display.
+      };
+
       class Window: public utils::CoreObject {
         public:
 
+          /**
+           * @brief - Statistics about the frames presented by a window. They
+           *          are mostly relevant in retained mode where frames with no
+           *          damage are not presented.
+           */
+          struct DamageStats {
+            unsigned presented;
+            unsigned skipped;
+            float lastDamageArea;
+          };
+
           Window(const utils::Sizei& size,
                  const bool resizable = true,
-                 const std::string& title = std::string("Default SDL window"));
+                 const std::string& title = std::string("Default SDL window"),
+                 const RenderBackend& backend = RenderBackend::Display);
 
           ~Window();
 
+          /**
+           * @brief - Retrieves the identifier of the underlying SDL window. Windows
+           *          rendered offscreen do not have one: in this case `0` is returned
+           *          which is never a valid identifier.
+           * @return - the SDL identifier of the window.
+           */
           std::uint32_t
           getSDLID() const;
 
@@ -66,11 +98,34 @@ namespace sdl {
           createTextureFromFile(ImageShPtr img,
                                 const Palette::ColorRole& role);
 
+          /**
+           * @brief - Similar to `createTextureFromFile` but the texture uses a placeholder
+           *          until the image is decoded. The decoding of the image is not handled
+           *          by this method.
+           * @param img - the image from which the texture should be created.
+           * @param role - the role of the texture.
+           * @return - the identifier of the created texture.
+           */
+          utils::Uuid
+          createTextureFromFileAsync(ImageShPtr img,
+                                     const Palette::ColorRole& role);
+
           utils::Uuid
           createTextureFromText(const std::string& text,
                                 ColoredFontShPtr font,
                                 const Palette::ColorRole& role);
 
+          /**
+           * @brief - Creates a texture from the content of the brush. If the brush can be
+           *          shared (see `Brush::setCacheable`) and a texture was already created
+           *          for an identical brush, this texture is reused and the brush is not
+           *          rendered at all. The texture is released when the last identifier
+           *          referencing it is destroyed.
+           *          Such textures can't be modified: filling them, changing their alpha
+           *          or role or drawing on them raises an error.
+           * @param brush - the brush from which the texture should be created.
+           * @return - the identifier of the created texture.
+           */
           utils::Uuid
           createTextureFromBrush(BrushShPtr brush);
 
@@ -110,16 +165,109 @@ namespace sdl {
           void
           destroyTexture(const utils::Uuid& uuid);
 
+          /**
+           * @brief - Defines whether this window uses a retained framebuffer. In
+           *          retained mode the draws onto the default target are made in
+           *          an offscreen texture which keeps its content from one frame
+           *          to the next: callers only need to redraw what changed. The
+           *          areas modified since the last frame are accumulated and the
+           *          frame is not presented at all if nothing changed.
+           *          Retained mode is disabled by default.
+           * @param retained - `true` to enable the retained mode.
+           */
+          void
+          setRetained(bool retained);
+
+          bool
+          isRetained() const noexcept;
+
+          /**
+           * @brief - Marks the input area of the window as damaged: it will be
+           *          presented at the next frame. Only relevant in retained mode.
+           * @param area - the area to invalidate, expressed in window coordinates.
+           *               If `null` the whole window is invalidated.
+           */
+          void
+          invalidate(const utils::Boxf* area = nullptr) noexcept;
+
+          /**
+           * @brief - Returns the statistics about the frames presented so far.
+           * @return - the damage statistics of this window.
+           */
+          DamageStats
+          getDamageStats() const noexcept;
+
+          /**
+           * @brief - Defines the rate at which frames are expected to be presented
+           *          and whether presenting waits for the vertical synchronization.
+           *          The rate is used to detect the frames presented late: a frame
+           *          is considered missed when it is presented more than half a
+           *          period after the expected time. The frame statistics are reset.
+           * @param rate - the expected number of frames per second. A value of `0`
+           *               means that no frame is ever considered missed.
+           * @param vsync - `true` if presenting should wait for the vertical sync.
+           */
+          void
+          setFramePacing(float rate,
+                         bool vsync);
+
+          /**
+           * @brief - Returns the statistics about the durations of the frames, i.e.
+           *          the time elapsed between two consecutive presents. Frames which
+           *          were not presented in retained mode interrupt the measurements.
+           * @return - the frame statistics of this window.
+           */
+          FrameStats
+          getFrameStats() const noexcept;
+
+          /**
+           * @brief - Clears the content of the window. In retained mode only the
+           *          damaged area of the framebuffer is cleared and the draws made
+           *          onto the window until the next `render` are clipped to it.
+           */
           void
           clear() noexcept;
 
+          /**
+           * @brief - Presents the content of the window. In retained mode nothing
+           *          is presented if no area was damaged since the last frame.
+           */
           void
           render() noexcept;
 
+          /**
+           * @brief - Reads back the pixels of the window. In retained mode this is
+           *          the content of the framebuffer, otherwise the content of the
+           *          current frame. Note that the content of a window displayed on
+           *          screen is undefined after it is presented so this should be
+           *          called before `render`. Offscreen windows keep their content.
+           *          An error is raised if the pixels can't be read.
+           * @return - the pixels of the window.
+           */
+          SurfaceTexture::RawSurfaceDataShPtr
+          readPixels();
+
         private:
 
           using TexturesMap = std::unordered_map<utils::Uuid, TextureShPtr>;
 
+          /**
+           * @brief - A texture created from a brush which can be shared, along with
+           *          the content of the brush: the hash of the content could collide
+           *          so the content is compared before reusing the texture.
+           */
+          struct BrushTexture {
+            std::weak_ptr<Texture> texture;
+            Brush::Content content;
+          };
+
+          /**
+           * @brief - The textures created from brushes which can be shared, indexed
+           *          by the hash of the content of the brush. The textures are only
+           *          referenced weakly so that they are released when not used.
+           */
+          using BrushTexturesMap = std::unordered_map<std::uint64_t, BrushTexture>;
+
           void
           create(const utils::Sizei& size,
                  const bool resizable);
@@ -127,18 +275,109 @@ namespace sdl {
           void
           clean();
 
+          /**
+           * @brief - Creates the framebuffer used in retained mode or recreates it
+           *          if the size of the window changed. In this case the whole
+           *          window is damaged.
+           * @return - the framebuffer or `null` if it could not be created.
+           */
+          SDL_Texture*
+          getFramebuffer() noexcept;
+
+          /**
+           * @brief - Extends the damage of the current frame with the input area.
+           * @param area - the damaged area, in pixels.
+           */
+          void
+          addDamage(const SDL_Rect& area) noexcept;
+
+          /**
+           * @brief - Records the duration of the frame which was just presented.
+           */
+          void
+          recordFrame() noexcept;
+
           utils::Uuid
           registerTexture(TextureShPtr tex);
 
           TextureShPtr
           getTextureOrThrow(const utils::Uuid& uuid) const;
 
+          /**
+           * @brief - Similar to `getTextureOrThrow` but also raises an error if the
+           *          texture is shared with other brushes: modifying it would change
+           *          the appearance of all of them.
+           * @param uuid - the identifier of the texture to modify.
+           * @return - the texture.
+           */
+          TextureShPtr
+          getMutableTextureOrThrow(const utils::Uuid& uuid) const;
+
         private:
 
+          RenderBackend m_backend;
+
           SDL_Window* m_window;
           SDL_Renderer* m_renderer;
 
+          /**
+           * @brief - The surface into which offscreen windows are rendered. It is
+           *          `null` for windows displayed on screen.
+           */
+          SDL_Surface* m_surface;
+
           TexturesMap m_textures;
+
+          BrushTexturesMap m_brushTextures;
+
+          /**
+           * @brief - The identifiers of the textures which can be shared between
+           *          several brushes. Such textures can't be modified.
+           */
+          std::unordered_set<utils::Uuid> m_sharedTextures;
+
+          /**
+           * @brief - The number of entries of the brush textures map above which the
+           *          expired entries are removed.
+           */
+          std::size_t m_brushTexturesSweep;
+
+          /**
+           * @brief - Whether the window uses a retained framebuffer and the
+           *          framebuffer itself. It is created lazily.
+           */
+          bool m_retained;
+          SDL_Texture* m_framebuffer;
+
+          /**
+           * @brief - The union of the areas damaged since the last frame which
+           *          was presented. Empty if nothing changed.
+           */
+          SDL_Rect m_damage;
+
+          /**
+           * @brief - The damaged area when the current frame was cleared. Draws
+           *          onto the framebuffer are clipped to it so that only what was
+           *          damaged is redrawn. Empty if the frame started without any
+           *          damage, in which case draws damage their destination area.
+           */
+          SDL_Rect m_clip;
+
+          DamageStats m_stats;
+
+          /**
+           * @brief - The durations of the frames presented so far and the expected
+           *          duration of a frame in milliseconds (`0` if there is none).
+           */
+          FrameHistogram m_frames;
+          float m_frameBudget;
+
+          /**
+           * @brief - The time of the last present, only relevant if the previous
+           *          frame was presented.
+           */
+          bool m_presented;
+          std::chrono::steady_clock::time_point m_lastPresent;
       };
 
       using WindowShPtr = std::shared_ptr<Window>;
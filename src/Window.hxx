@@ -4,6 +4,7 @@
 # include "Window.hh"
 # include "BasicTexture.hh"
 # include "FileTexture.hh"
+# include "AsyncFileTexture.hh"
 
 namespace sdl {
   namespace core {
@@ -12,11 +13,31 @@ namespace sdl {
       inline
       Window::Window(const utils::Sizei& size,
                      const bool resizable,
-                     const std::string& title):
+                     const std::string& title,
+                     const RenderBackend& backend):
         utils::CoreObject(title),
+        m_backend(backend),
         m_window(nullptr),
         m_renderer(nullptr),
-        m_textures()
+        m_surface(nullptr),
+        m_textures(),
+        m_brushTextures(),
+        m_sharedTextures(),
+        m_brushTexturesSweep(64u),
+
+        m_retained(false),
+        m_framebuffer(nullptr),
+
+        m_damage(SDL_Rect{0, 0, 0, 0}),
+        m_clip(SDL_Rect{0, 0, 0, 0}),
+
+        m_stats(DamageStats{0u, 0u, 0.0f}),
+
+        m_frames(),
+        m_frameBudget(0.0f),
+
+        m_presented(false),
+        m_lastPresent()
       {
         setService(std::string("window"));
 
@@ -27,6 +48,8 @@ namespace sdl {
       Window::~Window() {
         // Clear textures.
         m_textures.clear();
+        m_brushTextures.clear();
+        m_sharedTextures.clear();
 
         // Clear resoruces used by the renderer.
         clean();
@@ -58,12 +81,11 @@ namespace sdl {
 
       inline
       utils::Uuid
-      Window::createTextureFromText(const std::string& text,
-                                    ColoredFontShPtr font,
-                                    const Palette::ColorRole& role)
+      Window::createTextureFromFileAsync(ImageShPtr img,
+                                         const Palette::ColorRole& role)
       {
         // Create the texture.
-        TextureShPtr tex = font->render(text, m_renderer, role);
+        TextureShPtr tex = std::make_shared<AsyncFileTexture>(m_renderer, role, img);
 
         // Register and return it.
         return registerTexture(tex);
@@ -71,9 +93,12 @@ namespace sdl {
 
       inline
       utils::Uuid
-      Window::createTextureFromBrush(BrushShPtr brush) {
+      Window::createTextureFromText(const std::string& text,
+                                    ColoredFontShPtr font,
+                                    const Palette::ColorRole& role)
+      {
         // Create the texture.
-        TextureShPtr tex = brush->render(m_renderer);
+        TextureShPtr tex = font->render(text, m_renderer, role);
 
         // Register and return it.
         return registerTexture(tex);
@@ -86,7 +111,7 @@ namespace sdl {
                    const utils::Boxf* area)
       {
         // Try to retrieve the corresponding texture.
-        TextureShPtr tex = getTextureOrThrow(uuid);
+        TextureShPtr tex = getMutableTextureOrThrow(uuid);
 
         // Fill it using the internal renderer.
         tex->fill(palette, area);
@@ -98,7 +123,7 @@ namespace sdl {
                                const Color& color)
       {
         // Try to retrieve the corresponding texture.
-        TextureShPtr tex = getTextureOrThrow(uuid);
+        TextureShPtr tex = getMutableTextureOrThrow(uuid);
 
         // Set its alpha channel from the input color.
         tex->setAlpha(color);
@@ -120,7 +145,7 @@ namespace sdl {
                              const Palette::ColorRole& role)
       {
         // Try to retrieve the corresponding texture.
-        TextureShPtr tex = getTextureOrThrow(uuid);
+        TextureShPtr tex = getMutableTextureOrThrow(uuid);
 
         // Update the role from the input argument.
         tex->setRole(role);
@@ -141,6 +166,7 @@ namespace sdl {
       Window::destroyTexture(const utils::Uuid& uuid) {
         // Erase the texture from the internal map.
         const std::size_t erased = m_textures.erase(uuid);
+        m_sharedTextures.erase(uuid);
 
         // Warn the user if the texture could not be removed.
         if (erased != 1) {
@@ -149,20 +175,31 @@ namespace sdl {
       }
 
       inline
-      void
-      Window::Window::clear() noexcept {
-        SDL_RenderClear(m_renderer);
+      bool
+      Window::isRetained() const noexcept {
+        return m_retained;
       }
 
       inline
-      void
-      Window::render() noexcept {
-        SDL_RenderPresent(m_renderer);
+      Window::DamageStats
+      Window::getDamageStats() const noexcept {
+        return m_stats;
+      }
+
+      inline
+      FrameStats
+      Window::getFrameStats() const noexcept {
+        return m_frames.getStats();
       }
 
       inline
       void
       Window::clean() {
+        // Destroy the framebuffer used in retained mode.
+        if (m_framebuffer != nullptr) {
+          SDL_DestroyTexture(m_framebuffer);
+        }
+
         // Destrroy the renderer for this window.
         if (m_renderer != nullptr) {
           SDL_DestroyRenderer(m_renderer);
@@ -172,6 +209,11 @@ namespace sdl {
         if (m_window != nullptr) {
           SDL_DestroyWindow(m_window);
         }
+
+        // Destroy the surface used by offscreen windows.
+        if (m_surface != nullptr) {
+          SDL_FreeSurface(m_surface);
+        }
       }
 
       inline
@@ -207,6 +249,19 @@ namespace sdl {
         return tex->second;
       }
 
+      inline
+      TextureShPtr
+      Window::getMutableTextureOrThrow(const utils::Uuid& uuid) const {
+        if (m_sharedTextures.find(uuid) != m_sharedTextures.cend()) {
+          error(
+            std::string("Could not modify texture ") + uuid.toString() + " in window",
+            std::string("Texture is shared with other brushes")
+          );
+        }
+
+        return getTextureOrThrow(uuid);
+      }
+
     }
   }
 }
@@ -15,7 +15,17 @@ namespace sdl {
         m_eventsLocker(),
         m_events(),
 
-        m_handledTypes()
+        m_handledTypes(),
+
+        m_interestLocker(),
+        m_hasFilters(false),
+        m_ignoredTypes(),
+
+        m_hasMouseArea(false),
+        m_mouseWindow(),
+        m_mouseArea(),
+
+        m_domain(0u)
       {
         setService(std::string("object"));
       }
@@ -64,6 +74,19 @@ namespace sdl {
         // we insert the filter at the end of the vector it will
         // be applied first which is what we want.
         m_filters.push_back(filter);
+
+        // The filter might use events this object is not active for:
+        // make sure they are routed here.
+        bool changed = false;
+        {
+          const std::lock_guard guard(m_interestLocker);
+          changed = !m_hasFilters;
+          m_hasFilters = true;
+        }
+
+        if (changed && m_queue != nullptr) {
+          m_queue->updateListener(this);
+        }
       }
 
       void
@@ -135,56 +158,60 @@ namespace sdl {
         // So we have to determine which kind of events already exist in the internal
         // array before inserting the new one.
 
-        const std::lock_guard guard(m_eventsLocker);
+        {
+          const std::lock_guard guard(m_eventsLocker);
 
-        // Traverse the existing events and try to find a duplicate, i.e. an event
-        // which has same type as the input one.
-        bool unique = true;
-        Events::iterator event = m_events.begin();
+          // Traverse the existing events and try to find a duplicate, i.e. an event
+          // which has same type as the input one.
+          bool unique = true;
+          Events::iterator event = m_events.begin();
 
-        while (unique && event != m_events.end()) {
-          // An event is unique as long as it has either a) a different type or b) a
-          // different emitter.
-          unique = ((*event)->getType() != e->getType() || (*event)->getEmitter() != e->getEmitter());
-          if (unique) {
-            ++event;
+          while (unique && event != m_events.end()) {
+            // An event is unique as long as it has either a) a different type or b) a
+            // different emitter.
+            unique = ((*event)->getType() != e->getType() || (*event)->getEmitter() != e->getEmitter());
+            if (unique) {
+              ++event;
+            }
           }
-        }
 
-        // Check whether we could find an event identical to the input one.
-        // If this is the case we need to keep only one of the events based
-        // on their timestamp (so that we can keep the most recent one). If
-        // no identical events were found, we can safely proceed to insert
-        // the new input event to the internal array.
-        if (unique) {
-          // Proceed to the insertion of the input event into the internal
-          // array.
-          // notice("Queuing " + Event::getNameFromEvent(e));
-          m_events.push_back(e);
+          // Check whether we could find an event identical to the input one.
+          // If this is the case we need to keep only one of the events based
+          // on their timestamp (so that we can keep the most recent one). If
+          // no identical events were found, we can safely proceed to insert
+          // the new input event to the internal array.
+          if (unique) {
+            // Proceed to the insertion of the input event into the internal
+            // array.
+            // notice("Queuing " + Event::getNameFromEvent(e));
+            m_events.push_back(e);
+
+            // Sort these events so that we process the most basic ones first:
+            // this allows not to waste some processing time to handle a cycle
+            // like so:
+            // repaint -> geometry -> repaint (generated).
+            // The order in the input `events` array is only chronological with
+            // no consideration about the real meaning of events.
+            // This object is able to make sense of such events and thus speed up
+            // the processing by sorting them in importance order.
+            sortLocalEvents();
+          }
+          else {
+            // This event is not unique: use the dedicated merge function to
+            // merge both events into a single one. As we did not modify the
+            // order of the internal `m_events` array there's no need to sort
+            // the events again.
+            // notice("Merging " + Event::getNameFromEvent(e) + " with more recent event");
+            (*event)->merge(*e);
+          }
         }
-        else {
-          // This event is not unique: use the dedicated merge function to
-          // merge both events into a single one.
-          // notice("Merging " + Event::getNameFromEvent(e) + " with more recent event");
-
-          (*event)->merge(*e);
 
-          // The only remaining operation here is a sort so that events are
-          // only ordered with the most basic first: as we did not modify
-          // the order of the internal `m_events` array we can return right
-          // away.
-          return;
+        // Notify the queue that this object has some events to process. This
+        // is done once the events lock is released so that the queue is free
+        // to query the events of this object.
+        if (m_queue != nullptr) {
+          m_queue->markReady(this);
         }
-
-        // Sort these events so that we process the most basic ones first:
-        // this allows not to waste some processing time to handle a cycle
-        // like so:
-        // repaint -> geometry -> repaint (generated).
-        // The order in the input `events` array is only chronological with
-        // no consideration about the real meaning of events.
-        // This object is able to make sense of such events and thus speed up
-        // the processing by sorting them in importance order.
-        sortLocalEvents();
       }
 
       void
@@ -302,6 +329,64 @@ namespace sdl {
         } while (toProcess != nullptr);
       }
 
+      void
+      EngineObject::setInterestedIn(const Event::Type& type,
+                                    const bool interested)
+      {
+        // Update the internal set of ignored types and only notify the queue
+        // in case something actually changed. The lock is released before the
+        // queue reads the new values back.
+        bool changed = false;
+        {
+          const std::lock_guard guard(m_interestLocker);
+
+          changed = (
+            interested ?
+            m_ignoredTypes.erase(type) > 0u :
+            m_ignoredTypes.insert(type).second
+          );
+        }
+
+        if (changed && m_queue != nullptr) {
+          m_queue->updateListener(this);
+        }
+      }
+
+      void
+      EngineObject::setMouseArea(const utils::Uuid& window,
+                                 const utils::Boxf& area)
+      {
+        {
+          const std::lock_guard guard(m_interestLocker);
+
+          m_hasMouseArea = true;
+          m_mouseWindow = window;
+          m_mouseArea = area;
+        }
+
+        if (m_queue != nullptr) {
+          m_queue->updateListener(this);
+        }
+      }
+
+      void
+      EngineObject::clearMouseArea() {
+        {
+          const std::lock_guard guard(m_interestLocker);
+
+          // Nothing to do if no area is defined.
+          if (!m_hasMouseArea) {
+            return;
+          }
+
+          m_hasMouseArea = false;
+        }
+
+        if (m_queue != nullptr) {
+          m_queue->updateListener(this);
+        }
+      }
+
       void
       EngineObject::removeEvents(const Event::Type& type) noexcept {
         // Traverse the internal events list and remove the ones with
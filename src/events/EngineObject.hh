@@ -1,10 +1,13 @@
 #ifndef    ENGINE_OBJECT_HH
 # define   ENGINE_OBJECT_HH
 
+# include <atomic>
 # include <vector>
 # include <mutex>
 # include <unordered_set>
 # include <core_utils/CoreObject.hh>
+# include <core_utils/Uuid.hh>
+# include <maths_utils/Box.hh>
 # include "EventsUtils.hh"
 # include "Event.hh"
 # include "EventsQueue.hh"
@@ -104,6 +107,8 @@ namespace sdl {
            *          Upon inserting the event this method first checks that no other event
            *          of this type is registered in the internal queue and if this is the
            *          case it handles it correctly.
+           *          The events queue associated to this object (if any) is then notified
+           *          that this object has some events to process.
            * @param e - the event to insert in the internal array.
            */
           virtual void
@@ -122,6 +127,14 @@ namespace sdl {
           bool
           hasEvents(const EventProcessingPass& pass);
 
+          /**
+           * @brief - Returns true if this object contains internal events to process no
+           *          matter the processing pass they belong to.
+           * @return - true if this object has some events to process, false otherwise.
+           */
+          bool
+          hasEvents();
+
           /**
            * @brief - Performs a cleaning of all the internal events registered for this
            *          object.
@@ -154,6 +167,52 @@ namespace sdl {
           void
           processEvents(const EventProcessingPass& pass);
 
+          /**
+           * @brief - Used to determine whether this object is interested in receiving
+           *          broadcast events of the input type. Events queues can use this to
+           *          only route events to the objects which will use them. An object is
+           *          not interested in the types it ignores (see `setInterestedIn`) nor
+           *          in the types it is not active for, unless some filters are installed
+           *          as they might still use the events.
+           *          Note that this is different from the `isActive` method: an object
+           *          not interested in some type of events will not be notified at all
+           *          of broadcast events of this type, including by its filters.
+           * @param type - the type of events to check.
+           * @return - `true` if this object should receive broadcast events with the
+           *           input type.
+           */
+          bool
+          isInterestedIn(const Event::Type& type) const noexcept;
+
+          /**
+           * @brief - Used to retrieve the area of a window within which this object is
+           *          interested in mouse motions. If such an area is defined, the queue
+           *          can avoid notifying this object of motions happening elsewhere:
+           *          only motions entering, within or leaving the area are routed to
+           *          this object.
+           * @param window - output argument receiving the identifier of the window in
+           *                 which the area is defined.
+           * @param area - output argument receiving the area, expressed in the frame
+           *               of the window (same as the mouse events).
+           * @return - `true` if an area is defined, in which case the output values
+           *           are set, and `false` otherwise.
+           */
+          bool
+          getMouseArea(utils::Uuid& window,
+                       utils::Boxf& area) const noexcept;
+
+          /**
+           * @brief - Returns the affinity domain of this object. Objects belonging to
+           *          different domains might have their events processed concurrently
+           *          by the events queue if it is configured to do so. Objects in the
+           *          same domain are always processed sequentially, in the order they
+           *          were registered in the queue.
+           *          By default all the objects belong to the domain `0`.
+           * @return - the affinity domain of this object.
+           */
+          unsigned
+          getAffinityDomain() const noexcept;
+
         protected:
 
           /**
@@ -241,6 +300,52 @@ namespace sdl {
           virtual bool
           isActive(const Event::Type& type) const noexcept;
 
+          /**
+           * @brief - Used to declare whether this object is interested in receiving the
+           *          broadcast events of the input type. Declaring that an object is not
+           *          interested in some events allows the queue to skip it entirely when
+           *          dispatching such events.
+           *          Note that events directed towards this object are still received
+           *          no matter the interest declared here.
+           * @param type - the type of events to update.
+           * @param interested - `true` if this object should receive the events with
+           *                     this type and `false` otherwise.
+           */
+          void
+          setInterestedIn(const Event::Type& type,
+                          const bool interested);
+
+          /**
+           * @brief - Defines the area of the window within which this object wants to
+           *          receive mouse motions. Motions happening outside of this area will
+           *          not be routed to this object unless they leave the area.
+           *          The area should be expressed in the frame of the window, i.e. the
+           *          same frame as the one used by mouse events.
+           * @param window - the window in which the area is defined.
+           * @param area - the area of interest for mouse motions.
+           */
+          void
+          setMouseArea(const utils::Uuid& window,
+                       const utils::Boxf& area);
+
+          /**
+           * @brief - Removes any area defined by the `setMouseArea` method: this object
+           *          will receive all mouse motions again.
+           */
+          void
+          clearMouseArea();
+
+          /**
+           * @brief - Assigns a new affinity domain for this object. Objects of distinct
+           *          domains may be processed concurrently so one should make sure that
+           *          objects in different domains do not share any state except through
+           *          events. A common choice is to use a domain per window or per top
+           *          level widget.
+           * @param domain - the affinity domain of this object.
+           */
+          void
+          setAffinityDomain(unsigned domain) noexcept;
+
           /**
            * @brief - Used to register the input `other` object to the
            *          same events queue as this object.
@@ -417,10 +522,13 @@ namespace sdl {
            *          events directed to this object are discarded.
            *          Calling this method takes effect immediately (meaning for example that
            *          any remaining events of this type in the loop will be discarded).
+           *          As the activation changes the interests of this object, the caller
+           *          is responsible to notify the queue when this method returns `true`.
            * @param type - the type of events which should be updated.
            * @param active - the activation status for this widget regarding events.
+           * @return - `true` if the activation status of the type changed.
            */
-          void
+          bool
           setActive(const Event::Type& type,
                     const bool active) noexcept;
 
@@ -440,6 +548,43 @@ namespace sdl {
            */
           Event::Types m_handledTypes;
 
+          /**
+           * @brief - Protects the types of events this object is interested in, the
+           *          handled types and its mouse area: they are updated by the thread
+           *          owning the object but read by the events queue from its own thread.
+           */
+          mutable std::mutex m_interestLocker;
+
+          /**
+           * @brief - Whether some filters are installed on this object. Filters might
+           *          use events of any type, so this object stays interested in them
+           *          even if it does not handle them itself.
+           */
+          bool m_hasFilters;
+
+          /**
+           * @brief - Describes the types of broadcast events which this object is not
+           *          interested in. Events queues will not route such events to this
+           *          object at all. Empty by default so that the object receives all
+           *          the events.
+           */
+          Event::Types m_ignoredTypes;
+
+          /**
+           * @brief - Describes the area of interest for mouse motions, if any. The
+           *          `m_hasMouseArea` boolean indicates whether the other values are
+           *          meaningful.
+           */
+          bool m_hasMouseArea;
+          utils::Uuid m_mouseWindow;
+          utils::Boxf m_mouseArea;
+
+          /**
+           * @brief - The affinity domain of this object. This value is read by the
+           *          events queue from its own thread hence the atomic.
+           */
+          std::atomic<unsigned> m_domain;
+
       };
 
     }
@@ -19,6 +19,19 @@ namespace sdl {
       EngineObject::removeEventFilter(EngineObject* filter) {
         // Use the dedicated handler.
         removeFilter(findFilter(filter));
+
+        // Without filters, the types this object is not active for do not
+        // need to be routed here anymore.
+        bool changed = false;
+        {
+          const std::lock_guard guard(m_interestLocker);
+          changed = (m_hasFilters && m_filters.empty());
+          m_hasFilters = !m_filters.empty();
+        }
+
+        if (changed && m_queue != nullptr) {
+          m_queue->updateListener(this);
+        }
       }
 
       inline
@@ -64,6 +77,56 @@ namespace sdl {
         return false;
       }
 
+      inline
+      bool
+      EngineObject::isInterestedIn(const Event::Type& type) const noexcept {
+        const std::lock_guard guard(m_interestLocker);
+
+        if (m_ignoredTypes.find(type) != m_ignoredTypes.cend()) {
+          return false;
+        }
+
+        // Events of inactive types are discarded by this object: only the
+        // filters could use them.
+        return m_hasFilters || m_handledTypes.find(type) == m_handledTypes.cend();
+      }
+
+      inline
+      bool
+      EngineObject::getMouseArea(utils::Uuid& window,
+                                 utils::Boxf& area) const noexcept
+      {
+        const std::lock_guard guard(m_interestLocker);
+
+        if (!m_hasMouseArea) {
+          return false;
+        }
+
+        window = m_mouseWindow;
+        area = m_mouseArea;
+
+        return true;
+      }
+
+      inline
+      unsigned
+      EngineObject::getAffinityDomain() const noexcept {
+        return m_domain.load();
+      }
+
+      inline
+      void
+      EngineObject::setAffinityDomain(unsigned domain) noexcept {
+        m_domain.store(domain);
+      }
+
+      inline
+      bool
+      EngineObject::hasEvents() {
+        const std::lock_guard guard(m_eventsLocker);
+        return !m_events.empty();
+      }
+
       inline
       void
       EngineObject::unregisterFromQueue() noexcept {
@@ -79,11 +142,18 @@ namespace sdl {
       EngineObject::disableEventsProcessing() noexcept {
         // Loop on all valid event types and deactivate them if needed.
         Event::Types all = Event::getAllEvents();
+        bool changed = false;
         for (Event::Types::const_iterator it = all.cbegin() ;
              it != all.cend() ;
              ++it)
         {
-          setActive(*it, staysActiveWhileDisabled(*it));
+          changed = setActive(*it, staysActiveWhileDisabled(*it)) || changed;
+        }
+
+        // The queue does not need to route the deactivated types to us
+        // anymore: notify it once for all the types.
+        if (changed && m_queue != nullptr) {
+          m_queue->updateListener(this);
         }
       }
 
@@ -100,11 +170,16 @@ namespace sdl {
       EngineObject::activateEventsProcessing() noexcept {
         // Loop on all valid event types and activate them if needed.
         Event::Types all = Event::getAllEvents();
+        bool changed = false;
         for (Event::Types::const_iterator it = all.cbegin() ;
              it != all.cend() ;
              ++it)
         {
-          setActive(*it, !staysInactiveWhileEnabled(*it));
+          changed = setActive(*it, !staysInactiveWhileEnabled(*it)) || changed;
+        }
+
+        if (changed && m_queue != nullptr) {
+          m_queue->updateListener(this);
         }
       }
 
@@ -118,6 +193,7 @@ namespace sdl {
       inline
       bool
       EngineObject::isActive(const Event::Type& type) const noexcept {
+        const std::lock_guard guard(m_interestLocker);
         return m_handledTypes.find(type) == m_handledTypes.cend();
       }
 
@@ -371,10 +447,12 @@ namespace sdl {
       }
 
       inline
-      void
+      bool
       EngineObject::setActive(const Event::Type& type,
                               const bool active) noexcept
       {
+        const std::lock_guard guard(m_interestLocker);
+
         // Check whether this type is meant to be activated or deactivated.
         if (active) {
           // We should try to remove the input `type` from the internal
@@ -382,7 +460,7 @@ namespace sdl {
           Event::Types::iterator it = m_handledTypes.find(type);
 
           if (it == m_handledTypes.end()) {
-            return;
+            return false;
           }
 
           m_handledTypes.erase(it);
@@ -392,11 +470,13 @@ namespace sdl {
           Event::Types::iterator it = m_handledTypes.find(type);
 
           if (it != m_handledTypes.end()) {
-            return;
+            return false;
           }
 
           m_handledTypes.insert(type);
         }
+
+        return true;
       }
 
     }
@@ -1,5 +1,6 @@
 
 # include "EventsDispatcher.hh"
+# include <exception>
 # include <core_utils/SafetyNet.hh>
 # include "KeyEvent.hh"
 # include "QuitEvent.hh"
@@ -29,9 +30,13 @@ namespace sdl {
         m_broadcastEvents(),
 
         m_pass(EventProcessingPass::Visibility),
+        m_executor(nullptr),
 
         m_listenersLocker(),
-        m_listeners()
+        m_router(),
+        m_added(),
+        m_removals(0u),
+        m_ready()
       {
         setService("events");
 
@@ -51,6 +56,13 @@ namespace sdl {
         m_eventsRunning = true;
         m_executionLocker.unlock();
 
+        // Frames are paced using absolute deadlines: this avoids accumulating
+        // the rounding errors of sleeping for a number of milliseconds.
+        const std::chrono::steady_clock::duration period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+          std::chrono::duration<float, std::milli>(m_frameDuration)
+        );
+        std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now();
+
         bool stillRunning = true;
         while (stillRunning) {
           stillRunning = isRunning();
@@ -59,11 +71,14 @@ namespace sdl {
             break;
           }
 
+          deadline += period;
+
           // Process events in queue.
           int processingDuration = dispatchEventsFromQueue();
 
           // Check whether the rendering time is compatible with the desired framerate.
-          if (1.0f * processingDuration > m_frameDuration) {
+          const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+          if (now >= deadline) {
             // Log this problem.
             warn(
               std::string("Event handling took ") + std::to_string(processingDuration) + "ms " +
@@ -71,15 +86,13 @@ namespace sdl {
               " authorized to maintain " + std::to_string(m_framerate) + "fps"
             );
 
-            // Move on to the next frame.
+            // Move on to the next frame without trying to catch up.
+            deadline = now;
             continue;
           }
 
-          // Sleep for the remaining time to complete a frame if there's enough time left.
-          const unsigned int remainingDuration = m_frameDuration - processingDuration;
-          if (remainingDuration > 3u) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(remainingDuration));
-          }
+          // Sleep for the remaining time to complete a frame.
+          std::this_thread::sleep_until(deadline);
         }
 
         notice("Exiting events thread");
@@ -141,21 +154,24 @@ namespace sdl {
       EventsDispatcher::dispatchDirectedEvents() {
         // Now handle the `directed` events: as each listener is able to
         // handle directly the events which are directed towards it, we
-        // in fact need to loop through all listeners and trigger the
+        // in fact need to loop through the listeners and trigger the
         // processing of events with the internal method.
+        // In order not to poll each and every listener, the listeners
+        // register themselves in the `m_ready` set whenever they get
+        // some events to process: we only need to consider these ones.
         // As listeners may generate new events during this processing,
         // we need to keep looping as long as all events have not been
-        // consumed.
-        // We can determine whether some listeners still need to process
-        // some events with the dedicated `hasEvents` method.
+        // consumed. Such events will register new listeners in the set
+        // of ready listeners.
         // In addition to that, events might generate new listeners to
-        // register in this dispatcher, which will modify the `m_listeners`
-        // lists. We have to copy the listeners in order to allow them to
-        // be added.
+        // register in this dispatcher: such listeners are handled in
+        // the same way when they receive their first events.
         // The ordering is the following: when processing an event, we
         // need to pass it to all the listeners created by this event.
         // And when processing an event, we need to continue processing
-        // as long as some events have been generated.
+        // as long as some events have been generated. The ready set is
+        // sorted by registration order so the ordering of listeners is
+        // preserved.
         // We noted that most of the time the visibility events are the
         // ones which generate the most trouble as they can both create
         // some new listeners but also some new events. We thus want to
@@ -171,8 +187,8 @@ namespace sdl {
         // Process as long as some events have been added or some listener
         // created.
         do {
-          // Loop over the listeners and trigger the processing method
-          // for each one of them.
+          // Loop over the ready listeners and trigger the processing
+          // method for each one of them.
           // In a first approach we assume that we're done. If this is
           // not the case and a listener still has events to process
           // we will change our minds.
@@ -188,66 +204,142 @@ namespace sdl {
           // Reset `allDone` flag.
           allDone = true;
 
-          unsigned offset = 0u;
-          bool someListenersAdded = true;
+          // Retrieve the ready listeners: the set is emptied so that any
+          // listener receiving events from now on will be scheduled again.
+          Ready ready;
+          unsigned long removals = 0u;
+          {
+            const std::lock_guard guard(m_listenersLocker);
+            ready.swap(m_ready);
+            removals = m_removals.load();
+          }
+
+          // Retrieve the current processing pass: this will serve as a flag to indicate whenever
+          // the processing of an event changes the processing pass: in this case it means that we
+          // should go back to the anterior pass.
+          EventProcessingPass pass = getCurrentProcessingPass();
 
-          do {
+          // Process events for the listeners.
+          if (processReadyListeners(ready, removals, pass)) {
+            allDone = false;
+          }
 
-            // Retrieve existing listeners.
-            Listeners existingListeners;
+          // Reset the `allDone` status.
+          if (pass != getCurrentProcessingPass()) {
+            allDone = false;
+          }
+
+          // Some of the listeners might still have events to process: either
+          // because they belong to another pass or because the processing of
+          // the listeners was interrupted by a change of pass. We need to put
+          // them back in the ready set.
+          {
+            const std::lock_guard guard(m_listenersLocker);
+
+            for (Ready::const_iterator it = ready.cbegin() ;
+                 it != ready.cend() ;
+                 ++it)
             {
-              existingListeners.clear();
-              const std::lock_guard guard(m_listenersLocker);
-              existingListeners.swap(m_listeners);
+              // Make sure that the listener is still the one registered with
+              // this order: it might have been removed in the meantime.
+              unsigned long order = 0u;
+              if (m_router.getOrder(it->second, order) && order == it->first && it->second->hasEvents()) {
+                m_ready.insert(*it);
+              }
             }
+          }
 
-            // Retrieve the current processing pass: this will serve as a flag to indicate whenever
-            // the processing of an event changes the processing pass: in this case it means that we
-            // should go back to the anterior pass.
-            EventProcessingPass pass = getCurrentProcessingPass();
-
-            // Process events for the listeners.
-            for (unsigned id = offset ; id < existingListeners.size() && pass == getCurrentProcessingPass() ; ++id) {
-              if (existingListeners[id]->hasEvents(pass)) {
-                EngineObject* listener = existingListeners[id];
-
-                withSafetyNet(
-                  [&listener, &pass]() {
-                    listener->processEvents(pass);
-                  },
-                  std::string("processEvents")
-                );
-                allDone = false;
-              }
+        } while (!allDone || getCurrentProcessingPass() != EventProcessingPass::Rest);
+      }
+
+      bool
+      EventsDispatcher::processReadyListeners(const Ready& ready,
+                                              unsigned long removals,
+                                              const EventProcessingPass& pass)
+      {
+        // Group the listeners by affinity domain: we preserve the order of the
+        // listeners within each domain.
+        std::map<unsigned, Listeners> domains;
+
+        if (m_executor != nullptr) {
+          for (Ready::const_iterator it = ready.cbegin() ; it != ready.cend() ; ++it) {
+            if (isRegistered(it->second, removals)) {
+              domains[it->second->getAffinityDomain()].push_back(it->second);
             }
+          }
+        }
 
-            // Reset the `allDone` status.
-            if (pass != getCurrentProcessingPass()) {
-              allDone = false;
+        // In case there's a single domain (or no executor at all) process the
+        // listeners sequentially on this thread.
+        if (domains.size() <= 1u) {
+          bool processed = false;
+
+          for (Ready::const_iterator it = ready.cbegin() ;
+               it != ready.cend() && pass == getCurrentProcessingPass() ;
+               ++it)
+          {
+            // Discard listeners removed while processing events.
+            if (!isRegistered(it->second, removals)) {
+              continue;
             }
 
-            // Check whether some listeners were added.
-            {
-              const std::lock_guard guard(m_listenersLocker);
-              someListenersAdded = !m_listeners.empty();
-
-              // If some listeners were added, merge them with the
-              // existing list and then swap it to the internal array
-              // so that they can be notified of events.
-              if (someListenersAdded) {
-                debug("Added " + std::to_string(m_listeners.size()) + " listener(s), starting at " + std::to_string(existingListeners.size()) + " for next iteration");
-                offset = existingListeners.size();
-                existingListeners.insert(existingListeners.cend(), m_listeners.cbegin(), m_listeners.cend());
-              }
+            if (processListener(it->second, pass)) {
+              processed = true;
+            }
+          }
 
-              // Restore internal listeners with existing list to
-              // which newly registered have been added.
-              m_listeners.swap(existingListeners);
+          return processed;
+        }
+
+        // Create a task for each domain: each task processes the listeners of
+        // the domain in order and stops as soon as the pass changes, just like
+        // the sequential processing would do.
+        std::atomic<bool> processed(false);
+        std::vector<Executor::Task> tasks;
+        tasks.reserve(domains.size());
+
+        for (std::map<unsigned, Listeners>::const_iterator domain = domains.cbegin() ;
+             domain != domains.cend() ;
+             ++domain)
+        {
+          const Listeners& listeners = domain->second;
+
+          tasks.push_back(
+            [this, &listeners, &processed, removals, pass]() {
+              for (unsigned id = 0u ; id < listeners.size() && pass == getCurrentProcessingPass() ; ++id) {
+                if (!isRegistered(listeners[id], removals)) {
+                  continue;
+                }
+
+                if (processListener(listeners[id], pass)) {
+                  processed.store(true);
+                }
+              }
             }
+          );
+        }
 
-          } while (someListenersAdded);
+        m_executor->run(tasks);
 
-        } while (!allDone || getCurrentProcessingPass() != EventProcessingPass::Rest);
+        return processed.load();
+      }
+
+      bool
+      EventsDispatcher::processListener(EngineObject* listener,
+                                        const EventProcessingPass& pass)
+      {
+        if (!listener->hasEvents(pass)) {
+          return false;
+        }
+
+        withSafetyNet(
+          [&listener, &pass]() {
+            listener->processEvents(pass);
+          },
+          std::string("processEvents")
+        );
+
+        return true;
       }
 
       void
@@ -302,56 +394,73 @@ namespace sdl {
           return;
         }
 
-        // Broadcast the event to all the registered listeners. As we want to allow
-        // listeners to be added while processing the listeners array, we cannot
-        // just iterate as the iterators will most likely be invalidated if some new
-        // listeners are added. Instead we first copy the existing listeners so that
-        // each round only transmits the input `event` to the new listeners.
-        unsigned offset = 0u;
-        bool someListenersAdded = true;
+        // Broadcast the event to the registered listeners which are interested in it.
+        // As we want to allow listeners to be added while processing the listeners,
+        // we cannot just iterate on the internal list as the iterators will most
+        // likely be invalidated if some new listeners are added. Instead we first
+        // copy the interested listeners so that each round only transmits the input
+        // `event` to the new listeners.
+        Listeners listeners;
+        unsigned long removals = 0u;
+        {
+          const std::lock_guard guard(m_listenersLocker);
+          m_router.collect(*event, listeners);
+          m_added.clear();
+          removals = m_removals.load();
+        }
 
-        do {
-          // Retrieve existing listeners.
-          Listeners existingListeners;
+        while (!listeners.empty()) {
+          for (Listeners::const_iterator it = listeners.cbegin() ;
+               it != listeners.cend() ;
+               ++it)
           {
-            existingListeners.clear();
-            const std::lock_guard guard(m_listenersLocker);
-            existingListeners.swap(m_listeners);
-          }
+            EngineObject* lis = *it;
 
-          // Dispatch the event to the existing listeners. We use the `offset` so that
-          // only the listeners which have not yet processed the input `event` receive
-          // it in this round.
-          for (unsigned id = offset ; id < existingListeners.size() ; ++id) {
-            EngineObject* lis = existingListeners[id];
-            withSafetyNet(
-              [&event, lis]() {
-                lis->event(event);
-              },
-              lis->getName() + "::event(" + Event::getNameFromEvent(event) + ")"
-            );
+            // Discard listeners removed by the processing of the event.
+            if (!isRegistered(lis, removals)) {
+              continue;
+            }
+
+            // The name of the listener is only needed to report errors: it
+            // is not built unless the processing fails.
+            try {
+              lis->event(event);
+            }
+            catch (...) {
+              const std::exception_ptr err = std::current_exception();
+
+              withSafetyNet(
+                [&err]() {
+                  std::rethrow_exception(err);
+                },
+                lis->getName() + "::event(" + Event::getNameFromEvent(event) + ")"
+              );
+            }
           }
 
-          // Check whether some listeners were added.
+          // Check whether some listeners were added: only the ones which
+          // would have been routed the event should receive it.
           {
             const std::lock_guard guard(m_listenersLocker);
-            someListenersAdded = !m_listeners.empty();
-
-            // If some listeners were added, merge them with the
-            // existing list and then swap it to the internal array
-            // so that they can be notified of events.
-            if (someListenersAdded) {
-              debug("Added " + std::to_string(m_listeners.size()) + " listener(s), starting at " + std::to_string(existingListeners.size()) + " for next iteration");
-              offset = existingListeners.size();
-              existingListeners.insert(existingListeners.cend(), m_listeners.cbegin(), m_listeners.cend());
+            listeners.clear();
+
+            for (Listeners::const_iterator it = m_added.cbegin() ;
+                 it != m_added.cend() ;
+                 ++it)
+            {
+              if (m_router.accepts(*it, *event)) {
+                listeners.push_back(*it);
+              }
             }
 
-            // Restore internal listeners with existing list to
-            // which newly registered have been added.
-            m_listeners.swap(existingListeners);
+            m_added.clear();
+            removals = m_removals.load();
           }
 
-        } while (someListenersAdded);
+          if (!listeners.empty()) {
+            debug("Added " + std::to_string(listeners.size()) + " listener(s) for next iteration");
+          }
+        }
       }
 
     }
@@ -2,13 +2,17 @@
 # define   EVENTS_DISPATCHER_HH
 
 # include <memory>
+# include <map>
 # include <vector>
 # include <thread>
 # include <mutex>
+# include <atomic>
 # include <core_utils/CoreObject.hh>
 # include "Engine.hh"
 # include "EngineObject.hh"
 # include "EventsQueue.hh"
+# include "EventsRouter.hh"
+# include "Executor.hh"
 
 namespace sdl {
   namespace core {
@@ -34,6 +38,22 @@ namespace sdl {
           bool
           isRunning();
 
+          /**
+           * @brief - Used to define the number of threads which can be used to process the
+           *          directed events. By default all the events are processed on the events
+           *          thread. When more threads are requested, the listeners are grouped by
+           *          their affinity domain and the domains are processed concurrently by a
+           *          work stealing executor. The events of a single listener and of all the
+           *          listeners in a domain are still processed sequentially and the passes
+           *          are still processed in order.
+           *          Note that this method should be called before starting the dispatcher
+           *          otherwise an error is raised.
+           * @param count - the number of threads to use to process events. A value of `0`
+           *                or `1` processes all events on the events thread.
+           */
+          void
+          setProcessingThreads(unsigned count);
+
           /**
            * @brief - Used to update the internal list of events by appending the input list.
            *          These events are assumed to be a new batch of system events to process.
@@ -71,10 +91,37 @@ namespace sdl {
           void
           removeListener(EngineObject* listener) override;
 
+          /**
+           * @brief - Refreshes the routing information kept for the input listener. This
+           *          is called by listeners whenever the events they are interested in
+           *          change. An error is raised if the listener is not valid.
+           * @param listener - the listener which interests changed.
+           */
+          void
+          updateListener(EngineObject* listener) override;
+
+          /**
+           * @brief - Registers the input listener in the set of listeners which have some
+           *          events to process. Only such listeners are considered when processing
+           *          directed events. Listeners which are not registered in this queue are
+           *          ignored.
+           * @param listener - the listener which has some events to process.
+           */
+          void
+          markReady(EngineObject* listener) override;
+
         private:
 
           using Events = std::vector<EventShPtr>;
-          using Listeners = std::vector<EngineObject*>;
+          using Listeners = EventsRouter::Listeners;
+
+          /**
+           * @brief - Convenience define to describe the listeners which have some events
+           *          to process. The listeners are indexed by their registration order in
+           *          the router so that iterating on the set processes them in the order
+           *          they were registered.
+           */
+          using Ready = std::map<unsigned long, EngineObject*>;
 
           /**
            * @brief - Threadable method which is launched whenever the `run` method is called
@@ -115,14 +162,42 @@ namespace sdl {
           /**
            * @brief - Convenience method which allows to dispatch the events directed to specific
            *          listeners. As these events are stored directly in the private queue of the
-           *          listeners, we have to iterate over the registered listeners and call the
-           *          dedicated method for each one of them.
+           *          listeners, we have to iterate over the listeners which signaled that they
+           *          have some events and call the dedicated method for each one of them.
            *          Some events might be generated during the process so we continue until we
            *          complete a full round with no new event generated.
            */
           void
           dispatchDirectedEvents();
 
+          /**
+           * @brief - Performs the processing of the events belonging to the input pass for all
+           *          the listeners of the ready set. The processing stops as soon as the pass
+           *          changes (i.e. when an event of a higher priority pass is posted).
+           *          Depending on whether an executor is available, the listeners are either
+           *          processed sequentially or grouped by affinity domains processed in
+           *          parallel.
+           * @param ready - the listeners to process.
+           * @param removals - the number of removed listeners when the ready set was fetched.
+           * @param pass - the pass to process.
+           * @return - `true` if at least one listener had some events to process.
+           */
+          bool
+          processReadyListeners(const Ready& ready,
+                                unsigned long removals,
+                                const EventProcessingPass& pass);
+
+          /**
+           * @brief - Processes the events of the input listener belonging to the pass if it
+           *          has any. This method is protected against errors.
+           * @param listener - the listener which events should be processed.
+           * @param pass - the pass to process.
+           * @return - `true` if the listener had some events to process.
+           */
+          bool
+          processListener(EngineObject* listener,
+                          const EventProcessingPass& pass);
+
           /**
            * @brief - Iterates through the input array of events and send each one to all the
            *          listeners registered in this object using the `dispatchEvent` method. It
@@ -163,6 +238,23 @@ namespace sdl {
           bool
           interceptEscapeKey(const EventShPtr event);
 
+          /**
+           * @brief - Used to determine whether the input listener is still registered in
+           *          this dispatcher. This is used when iterating over a copy of the list
+           *          of listeners to not notify listeners removed in the meantime.
+           *          In order to avoid locking the listeners for each check, the caller
+           *          provides the number of removals which happened when the copy was
+           *          made: if no removal occurred since then the listener is known to be
+           *          valid.
+           * @param listener - the listener to check.
+           * @param removals - the number of removals when the list of listeners has been
+           *                   copied.
+           * @return - `true` if the listener is still registered.
+           */
+          bool
+          isRegistered(EngineObject* listener,
+                       unsigned long removals);
+
           /**
            * @brief - Used to retrieve the current value of the `m_pass` attribute. The mutex
            *          related to it is locked (so we assume it is not already locked beforehand)
@@ -170,7 +262,7 @@ namespace sdl {
            *          long.
            * @return - the value of the `m_pass` internal attribute upon entering this method.
            */
-          const EventProcessingPass&
+          EventProcessingPass
           getCurrentProcessingPass() const noexcept;
 
           /**
@@ -207,18 +299,26 @@ namespace sdl {
            *          It also serves WHILE processing the events to detect when some events processing
            *          triggers the creation of an event in an anterior pass: we should then go back to
            *          the pass in order to process the highest priority events first.
+           *          As listeners may be processed concurrently this value is atomic.
+           */
+          std::atomic<EventProcessingPass> m_pass;
+
+          /**
+           * @brief - The executor used to process the events of distinct affinity domains in
+           *          parallel. Null if the events are processed on the events thread only.
            */
-          EventProcessingPass m_pass;
+          ExecutorShPtr m_executor;
 
           /**
-           * @brief - This mutex is meant to protect the access to the `m_listeners` array.
+           * @brief - This mutex is meant to protect the access to the `m_router` and to the list
+           *          of listeners recently added.
            */
           std::mutex m_listenersLocker;
 
           /**
-           * @brief - Holds all the registered listeners of this dispatcher. Note that the fact that
-           *          this is implemented using a vector actually allows to provide some sort of
-           *          orederings in events.
+           * @brief - Holds all the registered listeners of this dispatcher along with the events
+           *          they are interested in. Note that the router keeps the listeners in order
+           *          of registration which allows to provide some sort of orderings in events.
            *          Let's consider the following situation: a widget and its layout. The widget will
            *          presumably be created before the layout. So when the widget will be assigned an
            *          events queue, it will be registered as a listener of the queue. It will then
@@ -234,8 +334,34 @@ namespace sdl {
            *          will process its geometry event, and do so with an invalid size because the
            *          event responsible for providing a valid size to the widget has not yet been
            *          processed.
+           *          Broadcast events are only transmitted to the listeners which declared some
+           *          interest for them through the router: this avoids to notify thousands of
+           *          objects of each mouse motion when only a handful of them care about it.
+           */
+          EventsRouter m_router;
+
+          /**
+           * @brief - The listeners added since the last time the dispatcher started a round of
+           *          notifications. These listeners were not part of the copy of the listeners
+           *          used for the round and should be notified as well.
+           */
+          Listeners m_added;
+
+          /**
+           * @brief - Counts the number of listeners removed since the creation of the object.
+           *          It is used to detect whether some listeners disappeared while iterating
+           *          on a copy of the listeners.
+           */
+          std::atomic<unsigned long> m_removals;
+
+          /**
+           * @brief - The set of listeners which have some local events to process. Listeners
+           *          register themselves in this set when they receive an event so that the
+           *          processing of directed events only needs to consider the objects which
+           *          have some work to do instead of polling all the listeners.
+           *          This set is protected by the `m_listenersLocker`.
            */
-          Listeners m_listeners;
+          Ready m_ready;
       };
 
       using EventsDispatcherShPtr = std::shared_ptr<EventsDispatcher>;
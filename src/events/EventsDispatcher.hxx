@@ -1,6 +1,7 @@
 #ifndef    EVENTS_DISPATCHER_HXX
 # define   EVENTS_DISPATCHER_HXX
 
+# include <algorithm>
 # include "EventsDispatcher.hh"
 
 namespace sdl {
@@ -49,6 +50,25 @@ namespace sdl {
         return m_eventsRunning;
       }
 
+      inline
+      void
+      EventsDispatcher::setProcessingThreads(unsigned count) {
+        const std::lock_guard guard(m_threadLocker);
+        if (m_executionThread != nullptr) {
+          error(
+            std::string("Cannot set events processing threads to ") + std::to_string(count),
+            std::string("Process already running")
+          );
+        }
+
+        // The events thread takes part in the processing so we only need to
+        // create the additional threads.
+        m_executor.reset();
+        if (count > 1u) {
+          m_executor = std::make_shared<Executor>(count - 1u, getName() + "_executor");
+        }
+      }
+
       inline
       void
       EventsDispatcher::pumpEvents(std::vector<EventShPtr>& events) {
@@ -113,22 +133,25 @@ namespace sdl {
 
         const std::lock_guard guard(m_listenersLocker);
 
-        // Loop through existing listeners to detect whether this `listener`
-        // is already registered for this queue.
-        for (Listeners::const_iterator existing = m_listeners.cbegin() ;
-             existing != m_listeners.cend() ;
-             ++existing)
-        {
-          if (*existing == listener) {
-            error(
-              std::string("Cannot add event listener \"" + listener->getName() + "\""),
-              std::string("Listener already registered")
-            );
-          }
+        // Insert it into the internal list of listeners: the router takes care
+        // of detecting duplicated listeners.
+        if (!m_router.add(listener)) {
+          error(
+            std::string("Cannot add event listener \"" + listener->getName() + "\""),
+            std::string("Listener already registered")
+          );
         }
 
-        // Insert it into the internal list of listeners.
-        m_listeners.push_back(listener);
+        // Keep track of the listener so that the rounds of notifications in
+        // progress also consider it.
+        m_added.push_back(listener);
+
+        // The listener might have received some events before being assigned
+        // to this queue: in this case we need to schedule it for processing.
+        unsigned long order = 0u;
+        if (listener->hasEvents() && m_router.getOrder(listener, order)) {
+          m_ready.emplace(order, listener);
+        }
       }
 
       inline
@@ -143,18 +166,14 @@ namespace sdl {
 
         const std::lock_guard guard(m_listenersLocker);
 
-        Listeners::iterator toRemove = std::remove_if(
-          m_listeners.begin(),
-          m_listeners.end(),
-          [listener](EngineObject* internalListener) {
-            return &(*listener) == &(*internalListener);
-          }
-        );
+        unsigned long order = 0u;
+        if (m_router.getOrder(listener, order)) {
+          m_ready.erase(order);
+        }
 
-        // The `remove_if` method actually moves all elements to be
-        // removed (at most one in our case) to the end. So we should
-        // perform the removal of the elements right now.
-        m_listeners.erase(toRemove, m_listeners.end());
+        m_router.remove(listener);
+        m_added.erase(std::remove(m_added.begin(), m_added.end(), listener), m_added.end());
+        ++m_removals;
 
         // We also need to remove all the events associated to this
         // listener: it is done by directly calling the appropriate
@@ -165,13 +184,28 @@ namespace sdl {
         // and check whether some events pending processing are linked
         // to the listener which have just been removed, for example
         // events emitted by it.
-        std::for_each(m_listeners.begin(), m_listeners.end(),
+        const Listeners& listeners = m_router.getListeners();
+        std::for_each(listeners.cbegin(), listeners.cend(),
           [listener](EngineObject* internalListener) {
             internalListener->removeEventsFrom(listener);
           }
         );
       }
 
+      inline
+      void
+      EventsDispatcher::updateListener(EngineObject* listener) {
+        if (listener == nullptr) {
+          error(
+            std::string("Cannot update event listener"),
+            std::string("Invalid null listener")
+          );
+        }
+
+        const std::lock_guard guard(m_listenersLocker);
+        m_router.update(listener);
+      }
+
       inline
       bool
       EventsDispatcher::interceptEscapeKey(const EventShPtr event) {
@@ -199,15 +233,47 @@ namespace sdl {
       }
 
       inline
-      const EventProcessingPass&
+      void
+      EventsDispatcher::markReady(EngineObject* listener) {
+        if (listener == nullptr) {
+          return;
+        }
+
+        const std::lock_guard guard(m_listenersLocker);
+
+        // Listeners which are not registered yet will be scheduled when they
+        // are added to this queue.
+        unsigned long order = 0u;
+        if (m_router.getOrder(listener, order)) {
+          m_ready.emplace(order, listener);
+        }
+      }
+
+      inline
+      bool
+      EventsDispatcher::isRegistered(EngineObject* listener,
+                                     unsigned long removals)
+      {
+        // In case no listener has been removed since the list was copied,
+        // the listener is still valid.
+        if (m_removals.load() == removals) {
+          return true;
+        }
+
+        const std::lock_guard guard(m_listenersLocker);
+        return m_router.contains(listener);
+      }
+
+      inline
+      EventProcessingPass
       EventsDispatcher::getCurrentProcessingPass() const noexcept {
-        return m_pass;
+        return m_pass.load();
       }
 
       inline
       void
       EventsDispatcher::setCurrentProcessingPass(const EventProcessingPass& pass) noexcept {
-        m_pass = pass;
+        m_pass.store(pass);
       }
 
     }
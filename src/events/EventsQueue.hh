@@ -22,6 +22,24 @@ namespace sdl {
           virtual void
           removeListener(EngineObject* listener) = 0;
 
+          /**
+           * @brief - Used by a listener to notify the queue that the description of
+           *          the events it is interested in changed. This allows the queue to
+           *          refresh any routing information it keeps about the listener.
+           * @param listener - the listener which interests changed.
+           */
+          virtual void
+          updateListener(EngineObject* listener) = 0;
+
+          /**
+           * @brief - Used by a listener to notify the queue that it received some local
+           *          events which need to be processed. This allows the queue to only
+           *          schedule the listeners which actually have some work to do.
+           * @param listener - the listener which has some events to process.
+           */
+          virtual void
+          markReady(EngineObject* listener) = 0;
+
       };
 
     }
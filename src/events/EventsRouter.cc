@@ -0,0 +1,480 @@
+
+# include "EventsRouter.hh"
+# include <cmath>
+# include <algorithm>
+# include "EngineObject.hh"
+# include "MouseEvent.hh"
+
+namespace {
+
+  /**
+   * @brief - Computes the range of cells spanned by the input interval along
+   *          a single axis.
+   * @param min - the lower bound of the interval.
+   * @param max - the upper bound of the interval.
+   * @param size - the size of a cell.
+   * @return - the index of the first and last cell spanned by the interval.
+   */
+  std::pair<std::int32_t, std::int32_t>
+  cellsRange(float min,
+             float max,
+             float size) noexcept
+  {
+    return std::make_pair(
+      static_cast<std::int32_t>(std::floor(min / size)),
+      static_cast<std::int32_t>(std::floor(max / size))
+    );
+  }
+
+  /**
+   * @brief - Packs both coordinates of a cell in a single integer: this is
+   *          enough as no window will ever be large enough to overflow 32
+   *          bits worth of cells.
+   * @param cx - the abscissa of the cell.
+   * @param cy - the ordinate of the cell.
+   * @return - the key of the cell.
+   */
+  std::int64_t
+  packCell(std::int32_t cx,
+           std::int32_t cy) noexcept
+  {
+    return (static_cast<std::int64_t>(cx) << 32) | static_cast<std::uint32_t>(cy);
+  }
+
+}
+
+namespace sdl {
+  namespace core {
+    namespace engine {
+
+      EventsRouter::EventsRouter(const std::string& name):
+        utils::CoreObject(name),
+
+        m_nextOrder(0u),
+        m_listeners(),
+        m_descs(),
+
+        m_routes(),
+
+        m_grids(),
+        m_lastPositions()
+      {
+        setService("events");
+      }
+
+      bool
+      EventsRouter::add(EngineObject* listener) {
+        // Discard listeners which are already registered.
+        if (contains(listener)) {
+          return false;
+        }
+
+        // Build the description of this listener: it receives the next order
+        // so it will be sorted after all the existing listeners.
+        Description desc;
+        desc.order = m_nextOrder;
+        ++m_nextOrder;
+        desc.bound = listener->getMouseArea(desc.window, desc.area) && isIndexable(desc.area);
+
+        m_descs[listener] = desc;
+        m_listeners.push_back(listener);
+
+        // Update the existing routes: as the listener has the highest order so
+        // far we can directly append it without breaking the ordering.
+        for (std::unordered_map<Event::Type, Entries>::iterator route = m_routes.begin() ;
+             route != m_routes.end() ;
+             ++route)
+        {
+          if (belongsToRoute(listener, desc, route->first)) {
+            route->second.push_back(Entry{desc.order, listener});
+          }
+        }
+
+        // Register in the spatial index if needed.
+        if (desc.bound && listener->isInterestedIn(Event::Type::MouseMove)) {
+          indexArea(listener, desc);
+        }
+
+        return true;
+      }
+
+      bool
+      EventsRouter::remove(EngineObject* listener) {
+        std::unordered_map<EngineObject*, Description>::iterator it = m_descs.find(listener);
+        if (it == m_descs.end()) {
+          return false;
+        }
+
+        const Description desc = it->second;
+        m_descs.erase(it);
+
+        m_listeners.erase(
+          std::remove(m_listeners.begin(), m_listeners.end(), listener),
+          m_listeners.end()
+        );
+
+        for (std::unordered_map<Event::Type, Entries>::iterator route = m_routes.begin() ;
+             route != m_routes.end() ;
+             ++route)
+        {
+          erase(route->second, desc.order);
+        }
+
+        if (desc.bound) {
+          unindexArea(desc);
+        }
+
+        return true;
+      }
+
+      void
+      EventsRouter::update(EngineObject* listener) {
+        std::unordered_map<EngineObject*, Description>::iterator it = m_descs.find(listener);
+        if (it == m_descs.end()) {
+          warn("Cannot update routes for unknown listener \"" + listener->getName() + "\"");
+          return;
+        }
+
+        // Remove the listener from the spatial index: it is easier to just
+        // insert it back afterwards than to compute the difference between
+        // the old and new areas.
+        if (it->second.bound) {
+          unindexArea(it->second);
+        }
+
+        Description& desc = it->second;
+        desc.bound = listener->getMouseArea(desc.window, desc.area) && isIndexable(desc.area);
+
+        // Refresh each route based on the new interests of the listener.
+        for (std::unordered_map<Event::Type, Entries>::iterator route = m_routes.begin() ;
+             route != m_routes.end() ;
+             ++route)
+        {
+          if (belongsToRoute(listener, desc, route->first)) {
+            insert(route->second, Entry{desc.order, listener});
+          }
+          else {
+            erase(route->second, desc.order);
+          }
+        }
+
+        if (desc.bound && listener->isInterestedIn(Event::Type::MouseMove)) {
+          indexArea(listener, desc);
+        }
+      }
+
+      void
+      EventsRouter::collect(const Event& event,
+                            Listeners& out)
+      {
+        out.clear();
+
+        const Event::Type type = event.getType();
+
+        // Mouse motions are routed using the spatial index if at least one of
+        // the listeners declared a mouse area. We need the window of the event
+        // to be valid though.
+        if (type == Event::Type::MouseMove && !m_grids.empty()) {
+          const MouseEvent* me = dynamic_cast<const MouseEvent*>(&event);
+
+          if (me != nullptr && event.getWindID().valid()) {
+            collectMotion(me->getMousePosition(), event.getWindID(), out);
+            return;
+          }
+
+          // We can't use the spatial index: fall back to all the listeners
+          // interested in the event no matter their area.
+          for (Listeners::const_iterator lis = m_listeners.cbegin() ;
+               lis != m_listeners.cend() ;
+               ++lis)
+          {
+            if ((*lis)->isInterestedIn(type)) {
+              out.push_back(*lis);
+            }
+          }
+
+          return;
+        }
+
+        // Regular route.
+        const Entries& route = getOrCreateRoute(type);
+
+        out.reserve(route.size());
+        for (Entries::const_iterator entry = route.cbegin() ;
+             entry != route.cend() ;
+             ++entry)
+        {
+          out.push_back(entry->listener);
+        }
+      }
+
+      bool
+      EventsRouter::accepts(EngineObject* listener,
+                            const Event& event) const
+      {
+        std::unordered_map<EngineObject*, Description>::const_iterator it = m_descs.find(listener);
+        if (it == m_descs.cend()) {
+          return false;
+        }
+
+        const Event::Type type = event.getType();
+        if (!listener->isInterestedIn(type)) {
+          return false;
+        }
+
+        // Only motions are filtered based on the area of the listener.
+        if (type != Event::Type::MouseMove || !it->second.bound) {
+          return true;
+        }
+
+        // Just like `collect`, without a window we can't use the area.
+        const MouseEvent* me = dynamic_cast<const MouseEvent*>(&event);
+        if (me == nullptr || !event.getWindID().valid()) {
+          return true;
+        }
+
+        return it->second.window == event.getWindID() && contains(it->second.area, me->getMousePosition());
+      }
+
+      EventsRouter::Entries&
+      EventsRouter::getOrCreateRoute(const Event::Type& type) {
+        std::unordered_map<Event::Type, Entries>::iterator route = m_routes.find(type);
+        if (route != m_routes.end()) {
+          return route->second;
+        }
+
+        // Build the route from the registered listeners: as they are stored in
+        // registration order the route is sorted as well.
+        Entries& created = m_routes[type];
+
+        for (Listeners::const_iterator lis = m_listeners.cbegin() ;
+             lis != m_listeners.cend() ;
+             ++lis)
+        {
+          const Description& desc = m_descs[*lis];
+
+          if (belongsToRoute(*lis, desc, type)) {
+            created.push_back(Entry{desc.order, *lis});
+          }
+        }
+
+        return created;
+      }
+
+      bool
+      EventsRouter::belongsToRoute(EngineObject* listener,
+                                   const Description& desc,
+                                   const Event::Type& type) const noexcept
+      {
+        // Bound listeners are routed through the spatial index for motions.
+        if (type == Event::Type::MouseMove && desc.bound) {
+          return false;
+        }
+
+        return listener->isInterestedIn(type);
+      }
+
+      void
+      EventsRouter::insert(Entries& route,
+                           const Entry& entry)
+      {
+        Entries::iterator it = std::lower_bound(
+          route.begin(),
+          route.end(),
+          entry.order,
+          [](const Entry& lhs, unsigned long order) {
+            return lhs.order < order;
+          }
+        );
+
+        if (it != route.end() && it->order == entry.order) {
+          return;
+        }
+
+        route.insert(it, entry);
+      }
+
+      void
+      EventsRouter::erase(Entries& route,
+                          unsigned long order)
+      {
+        Entries::iterator it = std::lower_bound(
+          route.begin(),
+          route.end(),
+          order,
+          [](const Entry& lhs, unsigned long order) {
+            return lhs.order < order;
+          }
+        );
+
+        if (it != route.end() && it->order == order) {
+          route.erase(it);
+        }
+      }
+
+      void
+      EventsRouter::indexArea(EngineObject* listener,
+                              const Description& desc)
+      {
+        Cells& grid = m_grids[desc.window];
+
+        std::pair<std::int32_t, std::int32_t> xs = cellsRange(desc.area.getLeftBound(), desc.area.getRightBound(), sk_cellSize);
+        std::pair<std::int32_t, std::int32_t> ys = cellsRange(desc.area.getBottomBound(), desc.area.getTopBound(), sk_cellSize);
+
+        for (std::int32_t cy = ys.first ; cy <= ys.second ; ++cy) {
+          for (std::int32_t cx = xs.first ; cx <= xs.second ; ++cx) {
+            insert(grid[packCell(cx, cy)], Entry{desc.order, listener});
+          }
+        }
+      }
+
+      void
+      EventsRouter::unindexArea(const Description& desc) {
+        std::unordered_map<utils::Uuid, Cells>::iterator grid = m_grids.find(desc.window);
+        if (grid == m_grids.end()) {
+          return;
+        }
+
+        std::pair<std::int32_t, std::int32_t> xs = cellsRange(desc.area.getLeftBound(), desc.area.getRightBound(), sk_cellSize);
+        std::pair<std::int32_t, std::int32_t> ys = cellsRange(desc.area.getBottomBound(), desc.area.getTopBound(), sk_cellSize);
+
+        for (std::int32_t cy = ys.first ; cy <= ys.second ; ++cy) {
+          for (std::int32_t cx = xs.first ; cx <= xs.second ; ++cx) {
+            Cells::iterator cell = grid->second.find(packCell(cx, cy));
+            if (cell == grid->second.end()) {
+              continue;
+            }
+
+            erase(cell->second, desc.order);
+
+            if (cell->second.empty()) {
+              grid->second.erase(cell);
+            }
+          }
+        }
+
+        // Get rid of the index for this window if it is now empty.
+        if (grid->second.empty()) {
+          m_grids.erase(grid);
+          m_lastPositions.erase(desc.window);
+        }
+      }
+
+      bool
+      EventsRouter::isIndexable(const utils::Boxf& area) noexcept {
+        std::pair<std::int32_t, std::int32_t> xs = cellsRange(area.getLeftBound(), area.getRightBound(), sk_cellSize);
+        std::pair<std::int32_t, std::int32_t> ys = cellsRange(area.getBottomBound(), area.getTopBound(), sk_cellSize);
+
+        const long count = (1l + xs.second - xs.first) * (1l + ys.second - ys.first);
+        return count > 0l && count <= static_cast<long>(sk_maxIndexedCells);
+      }
+
+      std::int64_t
+      EventsRouter::cellKey(float x,
+                            float y) noexcept
+      {
+        return packCell(
+          static_cast<std::int32_t>(std::floor(x / sk_cellSize)),
+          static_cast<std::int32_t>(std::floor(y / sk_cellSize))
+        );
+      }
+
+      void
+      EventsRouter::collectHovered(const utils::Uuid& window,
+                                   const utils::Vector2f& position,
+                                   const utils::Vector2f& last,
+                                   Entries& out) const
+      {
+        std::unordered_map<utils::Uuid, Cells>::const_iterator grid = m_grids.find(window);
+        if (grid == m_grids.cend()) {
+          return;
+        }
+
+        const std::int64_t keys[2] = {
+          cellKey(position.x(), position.y()),
+          cellKey(last.x(), last.y())
+        };
+        const unsigned count = (keys[0] == keys[1] ? 1u : 2u);
+
+        for (unsigned id = 0u ; id < count ; ++id) {
+          Cells::const_iterator cell = grid->second.find(keys[id]);
+          if (cell == grid->second.cend()) {
+            continue;
+          }
+
+          for (Entries::const_iterator entry = cell->second.cbegin() ;
+               entry != cell->second.cend() ;
+               ++entry)
+          {
+            const Description& desc = m_descs.at(entry->listener);
+
+            if (contains(desc.area, position) || contains(desc.area, last)) {
+              out.push_back(*entry);
+            }
+          }
+        }
+      }
+
+      void
+      EventsRouter::collectMotion(const utils::Vector2f& position,
+                                  const utils::Uuid& window,
+                                  Listeners& out)
+      {
+        // Start with the listeners which do not declare any area: they are
+        // interested in all the motions.
+        Entries candidates = getOrCreateRoute(Event::Type::MouseMove);
+
+        // Retrieve the previous position of the mouse in this window: this
+        // allows to notify the listeners that the mouse just left so that
+        // they can update their state. If the mouse was last seen in another
+        // window, the listeners it was hovering there are notified as well
+        // as they will not receive any other motion.
+        utils::Vector2f last = position;
+
+        for (std::unordered_map<utils::Uuid, utils::Vector2f>::const_iterator prev = m_lastPositions.cbegin() ;
+             prev != m_lastPositions.cend() ;
+             ++prev)
+        {
+          if (prev->first == window) {
+            last = prev->second;
+          }
+          else {
+            collectHovered(prev->first, prev->second, prev->second, candidates);
+          }
+        }
+
+        collectHovered(window, position, last, candidates);
+
+        m_lastPositions.clear();
+        m_lastPositions[window] = position;
+
+        // Restore the registration order and remove duplicates (a listener
+        // might be reached through both cells).
+        std::sort(
+          candidates.begin(),
+          candidates.end(),
+          [](const Entry& lhs, const Entry& rhs) {
+            return lhs.order < rhs.order;
+          }
+        );
+
+        Entries::iterator end = std::unique(
+          candidates.begin(),
+          candidates.end(),
+          [](const Entry& lhs, const Entry& rhs) {
+            return lhs.order == rhs.order;
+          }
+        );
+
+        out.reserve(std::distance(candidates.begin(), end));
+        for (Entries::const_iterator entry = candidates.cbegin() ;
+             entry != end ;
+             ++entry)
+        {
+          out.push_back(entry->listener);
+        }
+      }
+
+    }
+  }
+}
@@ -0,0 +1,347 @@
+#ifndef    EVENTS_ROUTER_HH
+# define   EVENTS_ROUTER_HH
+
+# include <vector>
+# include <cstdint>
+# include <unordered_map>
+# include <core_utils/CoreObject.hh>
+# include <core_utils/Uuid.hh>
+# include <maths_utils/Box.hh>
+# include <maths_utils/Vector2.hh>
+# include "Event.hh"
+
+namespace sdl {
+  namespace core {
+    namespace engine {
+
+      class EngineObject;
+
+      /**
+       * @brief - Keeps track of the listeners registered in an events queue and of
+       *          the events they declared some interest for. This allows to route a
+       *          broadcast event only to the listeners which will actually do some
+       *          work with it instead of calling each and every registered object.
+       *          Two levels of routing are provided:
+       *            - a per event type list of listeners, built lazily the first time
+       *              an event of a given type is routed and maintained afterwards.
+       *            - an optional spatial index for mouse motion events: listeners
+       *              which declared a mouse area are only notified of the motions
+       *              happening within (or leaving) this area.
+       *          The registration order of listeners is preserved in all cases as
+       *          it is used by the events processing to order the processing.
+       *          Note that this object is not thread safe: it is meant to be owned
+       *          by an events queue which protects its accesses.
+       */
+      class EventsRouter: public utils::CoreObject {
+        public:
+
+          using Listeners = std::vector<EngineObject*>;
+
+          EventsRouter(const std::string& name = std::string("events_router"));
+
+          ~EventsRouter() = default;
+
+          /**
+           * @brief - Registers the input listener in this router. The listener is
+           *          appended at the end of the existing listeners and its events
+           *          interests are fetched to update the routes.
+           *          Nothing happens if the listener is already registered in which
+           *          case the return value is `false`.
+           * @param listener - the listener to register.
+           * @return - `true` if the listener was registered and `false` if it was
+           *           already known.
+           */
+          bool
+          add(EngineObject* listener);
+
+          /**
+           * @brief - Removes the input listener from this router. Nothing happens
+           *          if the listener is not registered.
+           * @param listener - the listener to remove.
+           * @return - `true` if the listener was removed and `false` otherwise.
+           */
+          bool
+          remove(EngineObject* listener);
+
+          /**
+           * @brief - Refreshes the routes associated to the input listener based on
+           *          the events interests and mouse area it currently declares. This
+           *          should be called whenever one of those changes.
+           * @param listener - the listener which routes should be refreshed.
+           */
+          void
+          update(EngineObject* listener);
+
+          /**
+           * @brief - Returns `true` if the input listener is registered in this router.
+           * @param listener - the listener to search for.
+           * @return - `true` if the listener is registered, `false` otherwise.
+           */
+          bool
+          contains(EngineObject* listener) const noexcept;
+
+          /**
+           * @brief - Retrieves the registration order of the input listener. This
+           *          is a strictly increasing value which can be used to sort the
+           *          listeners in the order they were registered.
+           * @param listener - the listener for which the order should be fetched.
+           * @param order - output argument receiving the order of the listener.
+           * @return - `true` if the listener is registered (in which case `order`
+           *           is set) and `false` otherwise.
+           */
+          bool
+          getOrder(EngineObject* listener,
+                   unsigned long& order) const noexcept;
+
+          /**
+           * @brief - Returns the list of all the registered listeners in the order
+           *          they have been registered.
+           * @return - all the listeners registered in this router.
+           */
+          const Listeners&
+          getListeners() const noexcept;
+
+          /**
+           * @brief - Populates the output vector with the listeners which should be
+           *          notified of the input broadcast event. The listeners are sorted
+           *          using their registration order.
+           *          Note that the output vector is cleared by this method.
+           * @param event - the event to route.
+           * @param out - output vector which will contain the listeners interested
+           *              in the event.
+           */
+          void
+          collect(const Event& event,
+                  Listeners& out);
+
+          /**
+           * @brief - Determines whether the input listener should be notified of the
+           *          broadcast event, using the same rules as `collect`. This is meant
+           *          to check listeners registered while an event is being dispatched:
+           *          such listeners were not hovered by the mouse before, so a motion
+           *          is only routed to them if it happens within their area.
+           * @param listener - the listener to check.
+           * @param event - the event to route.
+           * @return - `true` if the listener should receive the event.
+           */
+          bool
+          accepts(EngineObject* listener,
+                  const Event& event) const;
+
+        private:
+
+          /**
+           * @brief - Convenience structure describing a listener along with its
+           *          registration order so that we can sort routes efficiently.
+           */
+          struct Entry {
+            unsigned long order;
+            EngineObject* listener;
+          };
+
+          using Entries = std::vector<Entry>;
+
+          /**
+           * @brief - Describes the routing information attached to a listener.
+           *          The mouse area is expressed in the same coordinate frame as
+           *          the mouse events (i.e. the window's frame).
+           */
+          struct Description {
+            unsigned long order;
+            bool bound;
+            utils::Uuid window;
+            utils::Boxf area;
+          };
+
+          using Cells = std::unordered_map<std::int64_t, Entries>;
+
+          /**
+           * @brief - Used to fetch the list of listeners interested in the input
+           *          event type. The list is built from scratch if no route exists
+           *          yet for this type.
+           * @param type - the type of events for which the route is needed.
+           * @return - the route for this event type.
+           */
+          Entries&
+          getOrCreateRoute(const Event::Type& type);
+
+          /**
+           * @brief - Used to determine whether the input listener with its desc
+           *          should belong to the route of events of the input type. Note
+           *          that bound listeners do not belong to the regular route for
+           *          mouse motion events as they are handled by the spatial index.
+           * @param listener - the listener to check.
+           * @param desc - the description of the listener.
+           * @param type - the type of events.
+           * @return - `true` if the listener should be part of the route.
+           */
+          bool
+          belongsToRoute(EngineObject* listener,
+                         const Description& desc,
+                         const Event::Type& type) const noexcept;
+
+          /**
+           * @brief - Inserts the input entry in the route, keeping the entries in
+           *          the registration order. Nothing happens if the entry already
+           *          exists.
+           * @param route - the route to update.
+           * @param entry - the entry to insert.
+           */
+          static
+          void
+          insert(Entries& route,
+                 const Entry& entry);
+
+          /**
+           * @brief - Removes the entry with the specified order from the route.
+           *          Nothing happens if no such entry exists.
+           * @param route - the route to update.
+           * @param order - the order of the entry to remove.
+           */
+          static
+          void
+          erase(Entries& route,
+                unsigned long order);
+
+          /**
+           * @brief - Registers the input listener in the spatial index for its
+           *          window, using the area described in `desc`.
+           * @param listener - the listener to register.
+           * @param desc - its description including the area.
+           */
+          void
+          indexArea(EngineObject* listener,
+                    const Description& desc);
+
+          /**
+           * @brief - Removes the input description from the spatial index.
+           * @param desc - the description which should be removed.
+           */
+          void
+          unindexArea(const Description& desc);
+
+          /**
+           * @brief - Determines whether the input area is small enough to be put
+           *          in the spatial index. Large areas would span too many cells
+           *          for the index to be useful.
+           * @param area - the area to check.
+           * @return - `true` if the area can be indexed.
+           */
+          static
+          bool
+          isIndexable(const utils::Boxf& area) noexcept;
+
+          /**
+           * @brief - Computes the key of the cell containing the input position.
+           * @param x - the abscissa of the position.
+           * @param y - the ordinate of the position.
+           * @return - a key identifying the cell.
+           */
+          static
+          std::int64_t
+          cellKey(float x,
+                  float y) noexcept;
+
+          /**
+           * @brief - Determines whether the input box contains the position.
+           * @param box - the box to check.
+           * @param p - the position to check.
+           * @return - `true` if the position lies within the box.
+           */
+          static
+          bool
+          contains(const utils::Boxf& box,
+                   const utils::Vector2f& p) noexcept;
+
+          /**
+           * @brief - Appends to the output list the listeners indexed for the input
+           *          window which area contains either of the input positions.
+           * @param window - the window which spatial index should be searched.
+           * @param position - the current position of the mouse.
+           * @param last - the previous position of the mouse.
+           * @param out - output list of entries to which listeners are appended.
+           */
+          void
+          collectHovered(const utils::Uuid& window,
+                         const utils::Vector2f& position,
+                         const utils::Vector2f& last,
+                         Entries& out) const;
+
+          /**
+           * @brief - Specialization of the `collect` method to handle a mouse motion
+           *          event. This uses the spatial index of the window associated to
+           *          the event to only select the listeners which area contains the
+           *          current or the previous position of the mouse. When the mouse
+           *          comes from another window, the listeners it was hovering in
+           *          there are selected as well so that they can detect the leave.
+           * @param position - the position of the mouse.
+           * @param window - the window into which the motion occurred.
+           * @param out - output vector which will contain the listeners to notify.
+           */
+          void
+          collectMotion(const utils::Vector2f& position,
+                        const utils::Uuid& window,
+                        Listeners& out);
+
+        private:
+
+          /**
+           * @brief - Size of a cell of the spatial index in pixels. The spatial
+           *          index is a uniform grid which is good enough for the UI use
+           *          case where most of the listeners have small areas.
+           */
+          static constexpr float sk_cellSize = 64.0f;
+
+          /**
+           * @brief - Maximum number of cells a mouse area can span before we decide
+           *          that it is not worth indexing it. Such listeners are treated as
+           *          if they did not declare any area (so they receive all motions).
+           */
+          static constexpr unsigned sk_maxIndexedCells = 1024u;
+
+          /**
+           * @brief - The registration counter: each listener is assigned the value
+           *          of this counter when it is registered which is then increased.
+           */
+          unsigned long m_nextOrder;
+
+          /**
+           * @brief - All the listeners registered in this router, in the order they
+           *          have been registered. See the `EventsDispatcher` for why this
+           *          order matters.
+           */
+          Listeners m_listeners;
+
+          /**
+           * @brief - The routing information of each listener.
+           */
+          std::unordered_map<EngineObject*, Description> m_descs;
+
+          /**
+           * @brief - Per event type list of listeners interested by this event type.
+           *          The routes are created lazily when an event of a given type is
+           *          first routed and then maintained as listeners are added.
+           */
+          std::unordered_map<Event::Type, Entries> m_routes;
+
+          /**
+           * @brief - The spatial index of listeners declaring a mouse area, for each
+           *          window.
+           */
+          std::unordered_map<utils::Uuid, Cells> m_grids;
+
+          /**
+           * @brief - The last position of the mouse, associated to the window into
+           *          which it occurred. Allows to route a motion event to the listener
+           *          the mouse just left. Contains at most one entry.
+           */
+          std::unordered_map<utils::Uuid, utils::Vector2f> m_lastPositions;
+      };
+
+    }
+  }
+}
+
+# include "EventsRouter.hxx"
+
+#endif    /* EVENTS_ROUTER_HH */
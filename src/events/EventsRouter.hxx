@@ -0,0 +1,51 @@
+#ifndef    EVENTS_ROUTER_HXX
+# define   EVENTS_ROUTER_HXX
+
+# include "EventsRouter.hh"
+
+namespace sdl {
+  namespace core {
+    namespace engine {
+
+      inline
+      bool
+      EventsRouter::contains(EngineObject* listener) const noexcept {
+        return m_descs.find(listener) != m_descs.cend();
+      }
+
+      inline
+      bool
+      EventsRouter::getOrder(EngineObject* listener,
+                             unsigned long& order) const noexcept
+      {
+        std::unordered_map<EngineObject*, Description>::const_iterator it = m_descs.find(listener);
+        if (it == m_descs.cend()) {
+          return false;
+        }
+
+        order = it->second.order;
+        return true;
+      }
+
+      inline
+      const EventsRouter::Listeners&
+      EventsRouter::getListeners() const noexcept {
+        return m_listeners;
+      }
+
+      inline
+      bool
+      EventsRouter::contains(const utils::Boxf& box,
+                             const utils::Vector2f& p) noexcept
+      {
+        return
+          p.x() >= box.getLeftBound() && p.x() <= box.getRightBound() &&
+          p.y() >= box.getBottomBound() && p.y() <= box.getTopBound()
+        ;
+      }
+
+    }
+  }
+}
+
+#endif    /* EVENTS_ROUTER_HXX */
@@ -5,72 +5,12 @@
 # include <vector>
 # include <maths_utils/Box.hh>
 # include "Event.hh"
+# include "RegionSet.hh"
 
 namespace sdl {
   namespace core {
     namespace engine {
 
-      namespace update {
-
-        /**
-         * @brief - Describes a coordinate frame for an update region.
-         */
-        enum class Frame {
-          Local, //<! - This value indicates that the area associated to the update
-                 //<!   region is expressed in local coordinate frame.
-          Global //<! - This value indicates that the area associated to the update
-                 //<!   region is expressed in global coordinate frame.
-        };
-
-        /**
-         * @brief - Used to describe an update region associated to a paint event. The typical
-         *          update region is composed of a area representing the actual extent of the
-         *          region to update, and also a value indicating the coordinate frame that it
-         *          is expressed into so that the user knows how to interpret it.
-         */
-        struct Region {
-          utils::Boxf area;
-          Frame frame;
-
-          /**
-           * @brief - Reuses the namespace method to print this region to a string.
-           * @return - a string representing this region as a human-readable data.
-           */
-          std::string
-          toString() const noexcept;
-
-          /**
-           * @brief - Determines whether `this` and `rhs` are equals. In order for
-           *          two regions to be equal they should have the same coordinate
-           *          frame and the same extent.
-           * @param rhs - the element to compare with `this`.
-           * @return - `true` if `rhs` is equal to `this` and `false` otherwise.
-           */
-          bool
-          operator==(const Region& rhs) const noexcept;
-
-          /**
-           * @brief - Determines whether `this` and `rhs` are different. In order for
-           *          two regions to be different they should either have a different
-           *          coordinate frame or a different extent.
-           * @param rhs - the element to compare with `this`.
-           * @return - `true` if `rhs` is different from `this` and `false` otherwise.
-           */
-          bool
-          operator!=(const Region& rhs) const noexcept;
-        };
-
-        /**
-         * @brief - Retrieves a human-readable string for the input frame.
-         * @param frame - the coordinate frame to convert to a string.
-         * @return - a string representing a name for the input coordinate frame or "unknown"
-         *           if the coordinate frame is unknown.
-         */
-        std::string
-        getNameFromFrame(const Frame& frame) noexcept;
-
-      }
-
       class PaintEvent: public Event {
         public:
 
@@ -121,8 +61,8 @@ namespace sdl {
 
           /**
            * @brief - Add the input region as a region to update for this event. Note that
-           *          the standard process is used to clean duplicated region and to merge
-           *          potentially overlapping regions.
+           *          regions already covered are ignored and that overlapping regions are
+           *          merged into their bounding box.
            *          Also the user should specify whether the input area is expressed in
            *          local or global coordinate frame.
            * @param area - the region to add as a region to update for this event.
@@ -136,8 +76,6 @@ namespace sdl {
           /**
            * @brief - Similar method to the `addUpdateRegion` with an area and a frame. This
            *          method is actually used by the above one.
-           *          Note that a sanitization is performed in order to keep a consistent
-           *          paint event.
            * @param region - the update region to add to this event.
            * @return - `true` if the region was added, `false` otherwise.
            */
@@ -146,8 +84,8 @@ namespace sdl {
 
           /**
            * @brief - Used to copy the update regions of the input paint event `e` into the
-           *          internal list of regions. A sanitize operation is called at the end of
-           *          the function so that we keep only relevant areas.
+           *          internal list of regions. Overlapping regions are merged so that we
+           *          keep only relevant areas.
            *          Note that none of the other parameters of the input paint event `e`
            *          are copied.
            * @param e - the event from which update regions should be copied.
@@ -203,46 +141,15 @@ namespace sdl {
           bool
           mergePrivate(const Event& other) noexcept override;
 
-        private:
-
-          /**
-           * @brief - Used to determine whether the input `area` already exists in the
-           *          internal `m_updateRegions` array. The term `exists` covers both
-           *          the fact that an exactly equal region might be present in the
-           *          internal array but also the case where a region containing the
-           *          input `area` exists in the array.
-           *          If none of this scenarii occurs, the method returns true.
-           *          The internal array is searched up until the `max` index is reached
-           *          or up until the end if `max` is negative.
-           *          This allows to dynamically insert elements in the `m_updateRegions`
-           *          without researching the already inserted elements (for example in
-           *          the `meregPrivate` method).
-           * @param region - the area which should be checked for uniqueness.
-           * @return - true if the `area` is not already part of the internal areas,
-           *           false ig this ara either exists or is covered by another one.
-           */
-          bool
-          isUnique(const update::Region& region,
-                   int max = -1) const noexcept;
-
-          /**
-           * @brief - Should be used after any insertion operation of an element inside
-           *          the internal `m_updateRegions` array.
-           *          This method will check that no area is contained in another one
-           *          so that we keep only the minimum amount of elements in the update
-           *          regions.
-           */
-          void
-          sanitize();
-
         private:
 
           /**
            * @brief - Contains all the regions to update when processing this event.
            *          Note that the region are expressed through both their extent
            *          but also the coordinate frame into which the area is expressed.
+           *          Overlapping regions are merged as they are added.
            */
-          std::vector<update::Region> m_updateRegions;
+          update::RegionSet m_updateRegions;
 
       };
 
@@ -7,49 +7,6 @@ namespace sdl {
   namespace core {
     namespace engine {
 
-      namespace update {
-
-        inline
-        std::string
-        getNameFromFrame(const Frame& frame) noexcept {
-          switch (frame) {
-            case Frame::Local:
-              return "local";
-            case Frame::Global:
-              return "global";
-            default:
-              return "unknown";
-          }
-        }
-
-        inline
-        std::string
-        Region::toString() const noexcept {
-          std::string out("[");
-
-          out += area.toString();
-          out += ", ";
-          out += getNameFromFrame(frame);
-
-          out += "]";
-
-          return out;
-        }
-
-        inline
-        bool
-        Region::operator==(const Region& rhs) const noexcept {
-          return frame == rhs.frame && area == rhs.area;
-        }
-
-        inline
-        bool
-        Region::operator!=(const Region& rhs) const noexcept {
-          return !operator==(rhs);
-        }
-
-      }
-
       inline
       PaintEvent::PaintEvent(EngineObject* receiver):
         Event(Event::Type::Repaint,
@@ -67,8 +24,10 @@ namespace sdl {
               receiver,
               std::string("paint_event")),
 
-        m_updateRegions(1u, update::Region{updateRegion, frame})
-      {}
+        m_updateRegions()
+      {
+        m_updateRegions.add(update::Region{updateRegion, frame});
+      }
 
       inline
       PaintEvent::~PaintEvent() {}
@@ -82,7 +41,7 @@ namespace sdl {
       inline
       const std::vector<update::Region>&
       PaintEvent::getUpdateRegions() const noexcept {
-        return m_updateRegions;
+        return m_updateRegions.getRegions();
       }
 
       inline
@@ -93,6 +52,18 @@ namespace sdl {
         return addUpdateRegion(update::Region{area, frame});
       }
 
+      inline
+      bool
+      PaintEvent::addUpdateRegion(const update::Region& region) noexcept {
+        return m_updateRegions.add(region);
+      }
+
+      inline
+      void
+      PaintEvent::copyUpdateRegions(const PaintEvent& e) noexcept {
+        m_updateRegions.merge(e.m_updateRegions);
+      }
+
     }
   }
 }
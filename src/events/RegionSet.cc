@@ -0,0 +1,116 @@
+
+# include "RegionSet.hh"
+
+namespace sdl {
+  namespace core {
+    namespace engine {
+
+      namespace update {
+
+        bool
+        RegionSet::add(const Region& region) noexcept {
+          // Nothing to do if the region is already covered.
+          for (unsigned id = 0u ; id < m_regions.size() ; ++id) {
+            if (m_regions[id].frame == region.frame && m_regions[id].area.contains(region.area)) {
+              return false;
+            }
+          }
+
+          // Absorb the regions overlapping the new one: they are replaced by
+          // their bounding box. As it is larger than the initial region it may
+          // overlap other regions so we repeat until it does not grow anymore.
+          // Each pass removes at least one region so this terminates quickly.
+          utils::Boxf area = region.area;
+          bool absorbed = true;
+
+          while (absorbed) {
+            absorbed = false;
+
+            unsigned id = 0u;
+            while (id < m_regions.size()) {
+              if (m_regions[id].frame != region.frame || !overlap(m_regions[id].area, area)) {
+                ++id;
+                continue;
+              }
+
+              area = unite(area, m_regions[id].area);
+
+              m_regions[id] = m_regions.back();
+              m_regions.pop_back();
+
+              absorbed = true;
+            }
+          }
+
+          m_regions.push_back(Region{area, region.frame});
+
+          // Collapse the regions of this frame if there are too many of them.
+          const unsigned count = std::count_if(
+            m_regions.cbegin(),
+            m_regions.cend(),
+            [&region](const Region& r) {
+              return r.frame == region.frame;
+            }
+          );
+
+          if (count > m_capacity) {
+            collapse(region.frame);
+          }
+
+          return true;
+        }
+
+        void
+        RegionSet::merge(const RegionSet& other) noexcept {
+          for (unsigned id = 0u ; id < other.m_regions.size() ; ++id) {
+            add(other.m_regions[id]);
+          }
+        }
+
+        bool
+        RegionSet::operator==(const RegionSet& rhs) const noexcept {
+          if (m_regions.size() != rhs.m_regions.size()) {
+            return false;
+          }
+
+          // Regions of a set are all distinct so it is enough to check that
+          // each of them is also part of the other set.
+          for (unsigned id = 0u ; id < m_regions.size() ; ++id) {
+            if (std::find(rhs.m_regions.cbegin(), rhs.m_regions.cend(), m_regions[id]) == rhs.m_regions.cend()) {
+              return false;
+            }
+          }
+
+          return true;
+        }
+
+        void
+        RegionSet::collapse(const Frame& frame) noexcept {
+          // Move the regions of the frame at the end of the set and replace
+          // them with their bounding box.
+          std::vector<Region>::iterator first = std::partition(
+            m_regions.begin(),
+            m_regions.end(),
+            [&frame](const Region& r) {
+              return r.frame != frame;
+            }
+          );
+
+          if (first == m_regions.end()) {
+            return;
+          }
+
+          utils::Boxf bounds = first->area;
+          for (std::vector<Region>::const_iterator it = first + 1 ; it != m_regions.end() ; ++it) {
+            bounds = unite(bounds, it->area);
+          }
+
+          m_regions.erase(first, m_regions.end());
+          m_regions.push_back(Region{bounds, frame});
+        }
+
+      }
+
+    }
+  }
+}
@@ -0,0 +1,190 @@
+#ifndef    REGION_SET_HH
+# define   REGION_SET_HH
+
+# include <string>
+# include <vector>
+# include <maths_utils/Box.hh>
+
+namespace sdl {
+  namespace core {
+    namespace engine {
+
+      namespace update {
+
+        /**
+         * @brief - Describes a coordinate frame for an update region.
+         */
+        enum class Frame {
+          Local, //<! - This value indicates that the area associated to the update
+                 //<!   region is expressed in local coordinate frame.
+          Global //<! - This value indicates that the area associated to the update
+                 //<!   region is expressed in global coordinate frame.
+        };
+
+        /**
+         * @brief - Used to describe an update region associated to a paint event. The typical
+         *          update region is composed of a area representing the actual extent of the
+         *          region to update, and also a value indicating the coordinate frame that it
+         *          is expressed into so that the user knows how to interpret it.
+         */
+        struct Region {
+          utils::Boxf area;
+          Frame frame;
+
+          /**
+           * @brief - Reuses the namespace method to print this region to a string.
+           * @return - a string representing this region as a human-readable data.
+           */
+          std::string
+          toString() const noexcept;
+
+          /**
+           * @brief - Determines whether `this` and `rhs` are equals. In order for
+           *          two regions to be equal they should have the same coordinate
+           *          frame and the same extent.
+           * @param rhs - the element to compare with `this`.
+           * @return - `true` if `rhs` is equal to `this` and `false` otherwise.
+           */
+          bool
+          operator==(const Region& rhs) const noexcept;
+
+          /**
+           * @brief - Determines whether `this` and `rhs` are different. In order for
+           *          two regions to be different they should either have a different
+           *          coordinate frame or a different extent.
+           * @param rhs - the element to compare with `this`.
+           * @return - `true` if `rhs` is different from `this` and `false` otherwise.
+           */
+          bool
+          operator!=(const Region& rhs) const noexcept;
+        };
+
+        /**
+         * @brief - Retrieves a human-readable string for the input frame.
+         * @param frame - the coordinate frame to convert to a string.
+         * @return - a string representing a name for the input coordinate frame or "unknown"
+         *           if the coordinate frame is unknown.
+         */
+        std::string
+        getNameFromFrame(const Frame& frame) noexcept;
+
+        /**
+         * @brief - A set of update regions where no two regions of the same frame
+         *          overlap: adding a region overlapping existing ones replaces all
+         *          of them with their bounding box, and regions contained in an
+         *          existing one are ignored. This over-approximates the area to
+         *          repaint a bit but keeps the set small.
+         *          The number of regions per frame is also capped: when the cap is
+         *          exceeded the regions of the frame are replaced by their bounding
+         *          box. Thanks to this the cost of an insertion is bounded by the cap
+         *          and merging sets is linear in the number of regions.
+         */
+        class RegionSet {
+          public:
+
+            /**
+             * @brief - Creates an empty set of regions.
+             * @param capacity - the maximum number of regions kept for a single
+             *                   coordinate frame before they are collapsed into a
+             *                   single one.
+             */
+            explicit
+            RegionSet(unsigned capacity = sk_defaultCapacity) noexcept;
+
+            /**
+             * @brief - Whether this set contains at least one region.
+             * @return - `true` if this set is empty.
+             */
+            bool
+            empty() const noexcept;
+
+            /**
+             * @brief - Retrieves the regions of this set. Their order is not
+             *          specified.
+             * @return - the regions of this set.
+             */
+            const std::vector<Region>&
+            getRegions() const noexcept;
+
+            /**
+             * @brief - Adds the input region to this set. Nothing happens if the
+             *          region is already covered by a region of the set.
+             * @param region - the region to add.
+             * @return - `true` if the set was modified.
+             */
+            bool
+            add(const Region& region) noexcept;
+
+            /**
+             * @brief - Adds all the regions of the input set to this one.
+             * @param other - the set to merge into `this`.
+             */
+            void
+            merge(const RegionSet& other) noexcept;
+
+            /**
+             * @brief - Determines whether both sets contain the same regions, no
+             *          matter the order in which they are stored.
+             * @param rhs - the set to compare with `this`.
+             * @return - `true` if both sets are equal.
+             */
+            bool
+            operator==(const RegionSet& rhs) const noexcept;
+
+            bool
+            operator!=(const RegionSet& rhs) const noexcept;
+
+          private:
+
+            /**
+             * @brief - The default maximum number of regions per coordinate frame.
+             */
+            static constexpr unsigned sk_defaultCapacity = 32u;
+
+            /**
+             * @brief - Whether the input boxes share some area. Boxes which only
+             *          touch each other do not overlap.
+             * @param lhs - the first box.
+             * @param rhs - the second box.
+             * @return - `true` if the boxes overlap.
+             */
+            static
+            bool
+            overlap(const utils::Boxf& lhs,
+                    const utils::Boxf& rhs) noexcept;
+
+            /**
+             * @brief - Computes the bounding box of both input boxes.
+             * @param lhs - the first box.
+             * @param rhs - the second box.
+             * @return - the smallest box containing both inputs.
+             */
+            static
+            utils::Boxf
+            unite(const utils::Boxf& lhs,
+                  const utils::Boxf& rhs) noexcept;
+
+            /**
+             * @brief - Replaces all the regions of the input frame by their bounding
+             *          box.
+             * @param frame - the frame of the regions to collapse.
+             */
+            void
+            collapse(const Frame& frame) noexcept;
+
+          private:
+
+            std::vector<Region> m_regions;
+
+            unsigned m_capacity;
+        };
+
+      }
+
+    }
+  }
+}
+
+# include "RegionSet.hxx"
+
+#endif    /* REGION_SET_HH */
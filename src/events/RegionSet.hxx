@@ -0,0 +1,112 @@
+#ifndef    REGION_SET_HXX
+# define   REGION_SET_HXX
+
+# include "RegionSet.hh"
+# include <algorithm>
+
+namespace sdl {
+  namespace core {
+    namespace engine {
+
+      namespace update {
+
+        inline
+        std::string
+        getNameFromFrame(const Frame& frame) noexcept {
+          switch (frame) {
+            case Frame::Local:
+              return "local";
+            case Frame::Global:
+              return "global";
+            default:
+              return "unknown";
+          }
+        }
+
+        inline
+        std::string
+        Region::toString() const noexcept {
+          std::string out("[");
+
+          out += area.toString();
+          out += ", ";
+          out += getNameFromFrame(frame);
+
+          out += "]";
+
+          return out;
+        }
+
+        inline
+        bool
+        Region::operator==(const Region& rhs) const noexcept {
+          return frame == rhs.frame && area == rhs.area;
+        }
+
+        inline
+        bool
+        Region::operator!=(const Region& rhs) const noexcept {
+          return !operator==(rhs);
+        }
+
+        inline
+        RegionSet::RegionSet(unsigned capacity) noexcept:
+          m_regions(),
+
+          m_capacity(std::max(1u, capacity))
+        {}
+
+        inline
+        bool
+        RegionSet::empty() const noexcept {
+          return m_regions.empty();
+        }
+
+        inline
+        const std::vector<Region>&
+        RegionSet::getRegions() const noexcept {
+          return m_regions;
+        }
+
+        inline
+        bool
+        RegionSet::operator!=(const RegionSet& rhs) const noexcept {
+          return !operator==(rhs);
+        }
+
+        inline
+        bool
+        RegionSet::overlap(const utils::Boxf& lhs,
+                           const utils::Boxf& rhs) noexcept
+        {
+          return
+            std::min(lhs.getRightBound(), rhs.getRightBound()) > std::max(lhs.getLeftBound(), rhs.getLeftBound()) &&
+            std::min(lhs.getTopBound(), rhs.getTopBound()) > std::max(lhs.getBottomBound(), rhs.getBottomBound())
+          ;
+        }
+
+        inline
+        utils::Boxf
+        RegionSet::unite(const utils::Boxf& lhs,
+                         const utils::Boxf& rhs) noexcept
+        {
+          const float left = std::min(lhs.getLeftBound(), rhs.getLeftBound());
+          const float right = std::max(lhs.getRightBound(), rhs.getRightBound());
+          const float bottom = std::min(lhs.getBottomBound(), rhs.getBottomBound());
+          const float top = std::max(lhs.getTopBound(), rhs.getTopBound());
+
+          return utils::Boxf(
+            (left + right) / 2.0f,
+            (bottom + top) / 2.0f,
+            right - left,
+            top - bottom
+          );
+        }
+
+      }
+
+    }
+  }
+}
+
+#endif    /* REGION_SET_HXX */
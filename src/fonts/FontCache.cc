@@ -151,21 +151,21 @@ namespace sdl {
       FontCache::renderGlyph(char c,
                              const Color& color)
       {
-        std::string key = makeKey(c, color);
+        // Glyphs are rendered with 8 bits colors so the packed color identifies
+        // the rendered glyph exactly.
+        const PackedColor packed(color);
+        const std::uint64_t key = makeKey(c, packed);
 
         // Check whether the input character has already been loaded in the cache.
         Glyphs::const_iterator it = m_glyphs.find(key);
 
         if (it != m_glyphs.cend()) {
-          if (color != it->second.c) {
-            warn("Using glyph with color " + color.toString() + " while cached glyph has color " + it->second.c.toString());
-          }
           // Return the cached version of the glyph.
           return it->second.tex;
         }
 
         // The glyph does not exist yet, create it and register it to the cache.
-        SDL_Surface* glyph = TTF_RenderGlyph_Blended(m_font, c, color.toSDLColor());
+        SDL_Surface* glyph = TTF_RenderGlyph_Blended(m_font, c, packed.toSDLColor());
         if (glyph == nullptr) {
           error(
             std::string("Could not render glyph \"") + std::to_string(static_cast<int>(c)) + "\"",
@@ -173,7 +173,7 @@ namespace sdl {
           );
         }
 
-        m_glyphs[key] = GlyphData{glyph, color};
+        m_glyphs[key] = GlyphData{glyph, packed};
 
         return glyph;
       }
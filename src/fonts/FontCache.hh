@@ -2,11 +2,13 @@
 # define   FONT_CACHE_HH
 
 # include <memory>
+# include <cstdint>
 # include <unordered_map>
 # include <SDL2/SDL_ttf.h>
 # include <core_utils/CoreObject.hh>
 # include <maths_utils/Size.hh>
 # include "Color.hh"
+# include "PackedColor.hh"
 
 namespace sdl {
   namespace core {
@@ -84,7 +86,7 @@ namespace sdl {
            */
           struct GlyphData {
             GlyphPtr tex;
-            Color c;
+            PackedColor c;
           };
 
           /**
@@ -171,12 +173,12 @@ namespace sdl {
            *          array.
            * @param c - the character to use to create the key.
            * @param color - the color to use to create the key.
-           * @return - a string representing the key built from the character and color.
+           * @return - a key built from the character and the packed color.
            */
           static
-          std::string
+          std::uint64_t
           makeKey(char c,
-                  const Color& color) noexcept;
+                  const PackedColor& color) noexcept;
 
         private:
 
@@ -184,7 +186,7 @@ namespace sdl {
            * @brief - Describes a glyph tables used to register all the glyphs loaded so far
            *          for a font.
            */
-          using Glyphs = std::unordered_map<std::string, GlyphData>;
+          using Glyphs = std::unordered_map<std::uint64_t, GlyphData>;
 
           /**
            * @brief - The font associated to this cache. Represents the underlying `API`
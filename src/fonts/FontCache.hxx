@@ -83,17 +83,11 @@ namespace sdl {
       }
 
       inline
-      std::string
+      std::uint64_t
       FontCache::makeKey(char c,
-                         const Color& color) noexcept
+                         const PackedColor& color) noexcept
       {
-        return std::string() +
-          c +
-          std::to_string(color.r()) +
-          std::to_string(color.g()) +
-          std::to_string(color.b()) +
-          std::to_string(color.a())
-        ;
+        return (static_cast<std::uint64_t>(static_cast<unsigned char>(c)) << 32) | color.value();
       }
 
     }
@@ -0,0 +1,72 @@
+
+# include "AsyncFileTexture.hh"
+# include "RendererState.hh"
+
+namespace sdl {
+  namespace core {
+    namespace engine {
+
+      SDL_Texture*
+      AsyncFileTexture::create() {
+        // Use a placeholder if the image is not yet decoded.
+        if (!m_img->isReady() && !m_img->hasFailed()) {
+          return createPlaceholder();
+        }
+
+        // Transform the surface into a valid texture. If the image could not
+        // be decoded, this raises the same error as for a `FileTexture`.
+        SDL_Texture* tex = SDL_CreateTextureFromSurface(getRenderer(), m_img->getSurface());
+
+        // Check whether the texture could successfully be created from the surface.
+        if (tex == nullptr) {
+          error(
+            std::string("Unable to create texture from file \"") + m_img->getFileName() + "\"",
+            SDL_GetError()
+          );
+        }
+
+        m_placeholder = false;
+
+        return tex;
+      }
+
+      SDL_Texture*
+      AsyncFileTexture::createPlaceholder() {
+        // The placeholder is a single pixel: it is stretched to the area where
+        // the texture is drawn. It is a rendering target so that it can be
+        // filled with the color of the role of the texture.
+        SDL_Texture* tex = SDL_CreateTexture(
+          getRenderer(),
+          SDL_PIXELFORMAT_RGBA8888,
+          SDL_TEXTUREACCESS_TARGET,
+          1,
+          1
+        );
+
+        if (tex == nullptr) {
+          error(
+            std::string("Unable to create placeholder for file \"") + m_img->getFileName() + "\"",
+            SDL_GetError()
+          );
+        }
+
+        // Clear the placeholder so that it does not display garbage: it stays
+        // transparent unless it is explicitly filled.
+        SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND);
+
+        {
+          RendererState state(getRenderer());
+
+          SDL_SetRenderTarget(getRenderer(), tex);
+          SDL_SetRenderDrawColor(getRenderer(), 0u, 0u, 0u, SDL_ALPHA_TRANSPARENT);
+          SDL_RenderClear(getRenderer());
+        }
+
+        m_placeholder = true;
+
+        return tex;
+      }
+
+    }
+  }
+}
@@ -0,0 +1,92 @@
+#ifndef    ASYNC_FILE_TEXTURE_HH
+# define   ASYNC_FILE_TEXTURE_HH
+
+# include <memory>
+# include <string>
+# include "Texture.hh"
+# include "Image.hh"
+
+namespace sdl {
+  namespace core {
+    namespace engine {
+
+      /**
+       * @brief - A texture created from an image which is decoded in the background.
+       *          Until the image is available a small placeholder texture is used: it
+       *          can be filled and drawn like any other texture. As soon as the image
+       *          is decoded the placeholder is replaced by the actual content of the
+       *          image the next time the texture is used.
+       *          If the image can't be decoded, using the texture raises the same error
+       *          as a `FileTexture` would.
+       *          Note that this class does not trigger the decoding of the image: it
+       *          is up to the creator to schedule it.
+       */
+      class AsyncFileTexture: public Texture {
+        public:
+
+          AsyncFileTexture(SDL_Renderer* renderer,
+                           const Palette::ColorRole& role,
+                           ImageShPtr img);
+
+          ~AsyncFileTexture();
+
+          /**
+           * @brief - Reimplementation of the base `Texture` method. Returns the size of
+           *          the image if it is already decoded and the size read from the header
+           *          of the file otherwise: this method never waits for the image to be
+           *          decoded. The size of the placeholder is only returned if the header
+           *          could not be read.
+           * @return - the size of the texture.
+           */
+          utils::Sizef
+          query() override;
+
+        protected:
+
+          SDL_Texture*
+          create() override;
+
+          /**
+           * @brief - Reimplementation of the base `Texture` method to request the creation
+           *          of the texture again when the placeholder is used and the image has
+           *          been decoded, or could not be decoded: in this case the creation of
+           *          the texture raises an error.
+           * @return - `true` if the texture should be recreated.
+           */
+          bool
+          outdated() const noexcept override;
+
+        private:
+
+          /**
+           * @brief - Creates the placeholder texture used while the image is decoded.
+           * @return - the placeholder texture.
+           */
+          SDL_Texture*
+          createPlaceholder();
+
+        private:
+
+          ImageShPtr m_img;
+
+          /**
+           * @brief - The dimensions of the image as read from the header of the file
+           *          when the texture is created. Only relevant if `m_hasSize` is set.
+           */
+          utils::Sizef m_size;
+          bool m_hasSize;
+
+          /**
+           * @brief - Whether the current texture is the placeholder.
+           */
+          bool m_placeholder;
+      };
+
+      using AsyncFileTextureShPtr = std::shared_ptr<AsyncFileTexture>;
+    }
+  }
+}
+
+# include "AsyncFileTexture.hxx"
+
+#endif    /* ASYNC_FILE_TEXTURE_HH */
@@ -0,0 +1,65 @@
+#ifndef    ASYNC_FILE_TEXTURE_HXX
+# define   ASYNC_FILE_TEXTURE_HXX
+
+# include "AsyncFileTexture.hh"
+# include "BitmapLoader.hh"
+
+namespace sdl {
+  namespace core {
+    namespace engine {
+
+      inline
+      AsyncFileTexture::AsyncFileTexture(SDL_Renderer* renderer,
+                                         const Palette::ColorRole& role,
+                                         ImageShPtr img):
+        Texture(renderer, role, Type::Image),
+        m_img(img),
+        m_size(),
+        m_hasSize(false),
+        m_placeholder(false)
+      {
+        // Check whether the provided image is valid.
+        if (img == nullptr) {
+          error(
+            std::string("Could not create texture from image"),
+            std::string("Invalid null image")
+          );
+        }
+
+        // Read the dimensions of the image right away so that the texture can be
+        // laid out with its final size while the image is decoded.
+        utils::Sizei size;
+        if (readBitmapSize(m_img->getFileName(), size)) {
+          m_size = utils::Sizef(1.0f * size.w(), 1.0f * size.h());
+          m_hasSize = true;
+        }
+      }
+
+      inline
+      AsyncFileTexture::~AsyncFileTexture() {}
+
+      inline
+      utils::Sizef
+      AsyncFileTexture::query() {
+        if (m_img->isReady()) {
+          return m_img->getSize();
+        }
+
+        if (m_hasSize) {
+          return m_size;
+        }
+
+        return Texture::query();
+      }
+
+      inline
+      bool
+      AsyncFileTexture::outdated() const noexcept {
+        return m_placeholder && (m_img->isReady() || m_img->hasFailed());
+      }
+
+    }
+  }
+}
+
+#endif    /* ASYNC_FILE_TEXTURE_HXX */
@@ -0,0 +1,370 @@
+
+# include "BitmapLoader.hh"
+# include <limits>
+# include <cstring>
+# include <fcntl.h>
+# include <unistd.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+
+namespace {
+
+  /**
+   * @brief - Size of the file header of a bitmap image.
+   */
+  constexpr std::size_t sk_fileHeaderSize = 14u;
+
+  /**
+   * @brief - Size of the smallest info header we can handle (`BITMAPINFOHEADER`).
+   */
+  constexpr std::size_t sk_infoHeaderSize = 40u;
+
+  /**
+   * @brief - Compression modes of bitmap images which we can map directly.
+   */
+  constexpr std::uint32_t sk_compressionRGB = 0u;
+  constexpr std::uint32_t sk_compressionBitfields = 3u;
+
+  /**
+   * @brief - Reads a little endian integer from the input buffer.
+   * @param data - the buffer to read from.
+   * @return - the integer read from the buffer.
+   */
+  std::uint32_t
+  readU32(const std::uint8_t* data) noexcept {
+    return
+      static_cast<std::uint32_t>(data[0]) |
+      (static_cast<std::uint32_t>(data[1]) << 8) |
+      (static_cast<std::uint32_t>(data[2]) << 16) |
+      (static_cast<std::uint32_t>(data[3]) << 24)
+    ;
+  }
+
+  /**
+   * @brief - Reads a little endian short integer from the input buffer.
+   * @param data - the buffer to read from.
+   * @return - the integer read from the buffer.
+   */
+  std::uint16_t
+  readU16(const std::uint8_t* data) noexcept {
+    return static_cast<std::uint16_t>(data[0] | (data[1] << 8));
+  }
+
+  /**
+   * @brief - Describes the layout of the pixels of a bitmap image which can be
+   *          mapped directly.
+   */
+  struct Layout {
+    int w;
+    int h;
+    bool bottomUp;
+    int pitch;
+    std::uint32_t format;
+    std::size_t offset;
+    bool checkAlpha;
+  };
+
+  /**
+   * @brief - Analyzes the headers of the bitmap image to determine whether the
+   *          pixels can be used directly.
+   * @param data - the content of the file.
+   * @param size - the size of the file in bytes.
+   * @param layout - output argument describing the layout of the pixels.
+   * @return - `true` if the image can be mapped and `false` otherwise.
+   */
+  bool
+  analyze(const std::uint8_t* data,
+          std::size_t size,
+          Layout& layout) noexcept
+  {
+    if (size < sk_fileHeaderSize + sk_infoHeaderSize || data[0] != 'B' || data[1] != 'M') {
+      return false;
+    }
+
+    const std::uint8_t* info = data + sk_fileHeaderSize;
+    layout.checkAlpha = false;
+
+    const std::uint32_t headerSize = readU32(info);
+    const std::int32_t w = static_cast<std::int32_t>(readU32(info + 4u));
+    const std::int32_t h = static_cast<std::int32_t>(readU32(info + 8u));
+    const std::uint16_t bpp = readU16(info + 14u);
+    const std::uint32_t compression = readU32(info + 16u);
+
+    if (headerSize < sk_infoHeaderSize || w <= 0 || h == 0 || h == std::numeric_limits<std::int32_t>::min()) {
+      return false;
+    }
+
+    // Only handle true color images: 24 bits are stored as `BGR` triplets
+    // while 32 bits are stored as `BGRX` or `BGRA` based on the masks.
+    if (bpp == 24u && compression == sk_compressionRGB) {
+      layout.format = SDL_PIXELFORMAT_BGR24;
+    }
+    else if (bpp == 32u && compression == sk_compressionRGB) {
+      // Like `SDL_LoadBMP` we consider that the fourth byte is the alpha
+      // channel unless it is zero for all the pixels.
+      layout.format = SDL_PIXELFORMAT_ARGB8888;
+      layout.checkAlpha = true;
+    }
+    else if (bpp == 32u && compression == sk_compressionBitfields) {
+      // The masks are stored right after the info header (or in the header
+      // itself for more recent versions): we only handle the usual layout.
+      // The alpha mask is only available with a `BITMAPV3INFOHEADER` or any
+      // more recent header.
+      const bool hasAlpha = (headerSize >= 56u);
+      if (size < sk_fileHeaderSize + sk_infoHeaderSize + (hasAlpha ? 16u : 12u)) {
+        return false;
+      }
+
+      const std::uint8_t* masks = info + sk_infoHeaderSize;
+      const std::uint32_t alpha = (hasAlpha ? readU32(masks + 12u) : 0u);
+
+      if (readU32(masks) != 0x00FF0000u || readU32(masks + 4u) != 0x0000FF00u || readU32(masks + 8u) != 0x000000FFu) {
+        return false;
+      }
+
+      if (alpha == 0xFF000000u) {
+        layout.format = SDL_PIXELFORMAT_ARGB8888;
+      }
+      else if (alpha == 0u) {
+        layout.format = SDL_PIXELFORMAT_RGB888;
+      }
+      else {
+        return false;
+      }
+    }
+    else {
+      return false;
+    }
+
+    layout.w = w;
+    layout.h = (h < 0 ? -h : h);
+    layout.bottomUp = (h > 0);
+
+    // Rows are padded to a multiple of 4 bytes.
+    layout.pitch = ((w * (bpp / 8) + 3) / 4) * 4;
+    layout.offset = readU32(data + 10u);
+
+    // Make sure that the pixels are entirely contained in the file.
+    const std::size_t bytes = static_cast<std::size_t>(layout.pitch) * static_cast<std::size_t>(layout.h);
+
+    return layout.offset <= size && bytes <= size - layout.offset;
+  }
+
+  /**
+   * @brief - Determines whether the alpha channel of all the pixels of the input
+   *          image is zero. Assumes that the image uses 4 bytes per pixel with
+   *          the alpha channel in the last one.
+   * @param pixels - the pixels of the image.
+   * @param layout - the layout of the pixels.
+   * @return - `true` if all the pixels have a zero alpha.
+   */
+  bool
+  isAlphaCleared(const std::uint8_t* pixels,
+                 const Layout& layout) noexcept
+  {
+    for (int y = 0 ; y < layout.h ; ++y) {
+      const std::uint8_t* row = pixels + static_cast<std::size_t>(y) * layout.pitch;
+
+      for (int x = 0 ; x < layout.w ; ++x) {
+        if (row[4 * x + 3] != 0u) {
+          return false;
+        }
+      }
+    }
+
+    return true;
+  }
+
+  /**
+   * @brief - Creates a surface holding a copy of the input pixels stored from the
+   *          bottom row to the top one, in the usual top to bottom order.
+   * @param pixels - the pixels to copy.
+   * @param layout - the layout of the pixels.
+   * @return - the surface or `null` if it can't be created.
+   */
+  sdl::core::engine::SurfaceShPtr
+  copyBottomUp(const std::uint8_t* pixels,
+               const Layout& layout)
+  {
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(
+      0,
+      layout.w,
+      layout.h,
+      SDL_BITSPERPIXEL(layout.format),
+      layout.format
+    );
+
+    if (surface == nullptr) {
+      return nullptr;
+    }
+
+    const std::size_t bytes = static_cast<std::size_t>(layout.w) * SDL_BYTESPERPIXEL(layout.format);
+    std::uint8_t* out = static_cast<std::uint8_t*>(surface->pixels);
+
+    for (int y = 0 ; y < layout.h ; ++y) {
+      std::memcpy(
+        out + static_cast<std::size_t>(y) * surface->pitch,
+        pixels + static_cast<std::size_t>(layout.h - 1 - y) * layout.pitch,
+        bytes
+      );
+    }
+
+    return sdl::core::engine::SurfaceShPtr(surface, SDL_FreeSurface);
+  }
+
+  /**
+   * @brief - Attempts to map the input file and create a surface over it.
+   * @param file - the file to map.
+   * @return - the surface or `null` if the file can't be mapped.
+   */
+  sdl::core::engine::SurfaceShPtr
+  map(const std::string& file) {
+    const int fd = open(file.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      return nullptr;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+      close(fd);
+      return nullptr;
+    }
+
+    // The mapping stays valid once the descriptor is closed. The pixels are
+    // only read unless the surface is created over them, see below.
+    const std::size_t size = static_cast<std::size_t>(info.st_size);
+    void* addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (addr == MAP_FAILED) {
+      return nullptr;
+    }
+
+    const std::uint8_t* data = static_cast<const std::uint8_t*>(addr);
+
+    Layout layout;
+    if (!analyze(data, size, layout)) {
+      munmap(addr, size);
+      return nullptr;
+    }
+
+    const std::uint8_t* pixels = data + layout.offset;
+
+    if (layout.checkAlpha && isAlphaCleared(pixels, layout)) {
+      layout.format = SDL_PIXELFORMAT_RGB888;
+    }
+
+    // Surfaces can't describe rows stored from the bottom to the top: such
+    // images, which are the most common ones, are copied in a regular order.
+    // Only images stored from the top to the bottom are used in place.
+    if (layout.bottomUp) {
+      sdl::core::engine::SurfaceShPtr surface = copyBottomUp(pixels, layout);
+      munmap(addr, size);
+
+      return surface;
+    }
+
+    // The surface can be modified by its users: as the mapping is private
+    // the pages are copied when written to and the file is left unchanged.
+    if (mprotect(addr, size, PROT_READ | PROT_WRITE) != 0) {
+      munmap(addr, size);
+      return nullptr;
+    }
+
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormatFrom(
+      static_cast<std::uint8_t*>(addr) + layout.offset,
+      layout.w,
+      layout.h,
+      SDL_BITSPERPIXEL(layout.format),
+      layout.pitch,
+      layout.format
+    );
+
+    if (surface == nullptr) {
+      munmap(addr, size);
+      return nullptr;
+    }
+
+    // The surface does not own its pixels: release the mapping along with it.
+    return sdl::core::engine::SurfaceShPtr(
+      surface,
+      [addr, size](SDL_Surface* s) {
+        SDL_FreeSurface(s);
+        munmap(addr, size);
+      }
+    );
+  }
+
+}
+
+namespace sdl {
+  namespace core {
+    namespace engine {
+
+      SurfaceShPtr
+      loadBitmap(const std::string& file) {
+        // The pixels of the file are interpreted as little endian values so
+        // we can only map them directly on such platforms.
+        if constexpr (SDL_BYTEORDER == SDL_LIL_ENDIAN) {
+          SurfaceShPtr surface = map(file);
+
+          if (surface != nullptr) {
+            return surface;
+          }
+        }
+
+        // Fall back to the regular loading.
+        SDL_Surface* surface = SDL_LoadBMP(file.c_str());
+        if (surface == nullptr) {
+          return nullptr;
+        }
+
+        return SurfaceShPtr(surface, SDL_FreeSurface);
+      }
+
+      bool
+      readBitmapSize(const std::string& file,
+                     utils::Sizei& size) noexcept
+      {
+        const int fd = open(file.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+          return false;
+        }
+
+        // The dimensions are stored in the info header, right after the file
+        // header and the size of the info header itself.
+        std::uint8_t header[sk_fileHeaderSize + 12u];
+        const ssize_t count = pread(fd, header, sizeof(header), 0);
+        close(fd);
+
+        if (count != static_cast<ssize_t>(sizeof(header)) || header[0] != 'B' || header[1] != 'M') {
+          return false;
+        }
+
+        const std::uint8_t* info = header + sk_fileHeaderSize;
+        std::int32_t w = 0, h = 0;
+
+        // Old `BITMAPCOREHEADER` store the dimensions on 16 bits, all the
+        // other versions use signed 32 bits values.
+        if (readU32(info) == 12u) {
+          w = readU16(info + 4u);
+          h = readU16(info + 6u);
+        }
+        else {
+          w = static_cast<std::int32_t>(readU32(info + 4u));
+          h = static_cast<std::int32_t>(readU32(info + 8u));
+        }
+
+        // Images stored from the top to the bottom have a negative height.
+        if (w <= 0 || h == 0 || h == std::numeric_limits<std::int32_t>::min()) {
+          return false;
+        }
+
+        size = utils::Sizei(w, (h < 0 ? -h : h));
+
+        return true;
+      }
+
+    }
+  }
+}
@@ -0,0 +1,49 @@
+#ifndef    BITMAP_LOADER_HH
+# define   BITMAP_LOADER_HH
+
+# include <string>
+# include <maths_utils/Size.hh>
+# include "ImageCache.hh"
+
+namespace sdl {
+  namespace core {
+    namespace engine {
+
+      /**
+       * @brief - Loads the bitmap image described by the input file. Uncompressed
+       *          images with 24 or 32 bits per pixel are mapped in memory. Images
+       *          stored from the top to the bottom are used in place: the surface
+       *          is created directly over the mapped pixels and the file is neither
+       *          copied nor converted. Images stored from the bottom to the top, the
+       *          most common ones, are copied once in a regular surface.
+       *          As in `SDL_LoadBMP`, the fourth byte of 32 bits images without
+       *          masks is used as alpha unless it is zero for all the pixels.
+       *          Other variants (palettes, compression, unusual masks) are loaded
+       *          through the regular `SDL_LoadBMP` function.
+       *          In case the image can't be loaded a `null` surface is returned and
+       *          the error can be retrieved with `SDL_GetError`.
+       * @param file - the path to the bitmap image to load.
+       * @return - the surface describing the image or `null` if it can't be loaded.
+       */
+      SurfaceShPtr
+      loadBitmap(const std::string& file);
+
+      /**
+       * @brief - Reads the dimensions of the bitmap image described by the input
+       *          file. Only the headers of the file are read so this is cheap even
+       *          for large images: it can be used to know the size of an image
+       *          before decoding it.
+       * @param file - the path to the bitmap image.
+       * @param size - output argument receiving the size of the image.
+       * @return - `true` if the size could be read and `false` otherwise, in which
+       *           case `size` is left unchanged.
+       */
+      bool
+      readBitmapSize(const std::string& file,
+                     utils::Sizei& size) noexcept;
+
+    }
+  }
+}
+
+#endif    /* BITMAP_LOADER_HH */
@@ -11,7 +11,9 @@ namespace sdl {
         m_locker(),
 
         m_file(file),
-        m_image(nullptr)
+        m_image(nullptr),
+        m_ready(false),
+        m_failed(false)
       {
         setService("image");
       }
@@ -19,27 +21,32 @@ namespace sdl {
       void
       Image::load() {
         // Attempt to load the image from the file if needed.
-        if (m_file.empty()) {
+        if (m_file.empty() || isLoaded()) {
           return;
         }
 
-        m_image = SDL_LoadBMP(m_file.c_str());
+        m_image = ImageCache::getInstance().load(m_file);
 
         if (m_image == nullptr) {
+          m_failed.store(true);
+
           error(
             std::string("Unable to create image from file \"") + m_file + "\"",
             SDL_GetError()
           );
         }
+
+        m_failed.store(false);
+        m_ready.store(true);
       }
 
       void
       Image::unload() {
         const std::lock_guard guard(m_locker);
 
-        if (isLoaded()) {
-          SDL_FreeSurface(m_image);
-        }
+        // The surface is released by the cache when no more images use it.
+        m_ready.store(false);
+        m_image.reset();
       }
 
     }
@@ -3,9 +3,11 @@
 
 # include <memory>
 # include <mutex>
+# include <atomic>
 # include <core_utils/CoreObject.hh>
 # include <maths_utils/Size.hh>
 # include <SDL2/SDL.h>
+# include "ImageCache.hh"
 
 namespace sdl {
   namespace core {
@@ -63,6 +65,34 @@ namespace sdl {
           SDL_Surface*
           getSurface();
 
+          /**
+           * @brief - Forces the loading of the data of this image. This is typically
+           *          used to decode the image on a background thread so that the data
+           *          is readily available when the image is first used.
+           *          Raises an error if the image cannot be loaded.
+           */
+          void
+          preload();
+
+          /**
+           * @brief - Used to determine whether the data of this image is available. As
+           *          opposed to the other methods of this class this does not acquire
+           *          the locker and never triggers the loading of the data: it can be
+           *          used to poll an image being loaded in the background.
+           * @return - `true` if the data of the image is loaded and `false` otherwise.
+           */
+          bool
+          isReady() const noexcept;
+
+          /**
+           * @brief - Used to determine whether the last attempt to load the data of
+           *          this image failed. Just like `isReady` this method does not
+           *          acquire the locker.
+           * @return - `true` if the image could not be loaded.
+           */
+          bool
+          hasFailed() const noexcept;
+
         protected:
 
           /**
@@ -76,7 +106,8 @@ namespace sdl {
 
           /**
            * @brief - Used to perform the loading of the data for this image. Note that it is safe
-           *          to call this method if the data is already loaded.
+           *          to call this method if the data is already loaded: nothing happens in this
+           *          case. The data is retrieved from the `ImageCache`.
            *          Assumes that the locker is already acquired.
            */
           void
@@ -102,9 +133,22 @@ namespace sdl {
 
           /**
            * @brief - The loaded data for this image. This attribute is `null` until
-           *          the `load` method is called. It is managed internally.
+           *          the `load` method is called. The data is fetched from the global
+           *          `ImageCache` so that it is shared with other images referencing
+           *          the same file.
+           */
+          SurfaceShPtr m_image;
+
+          /**
+           * @brief - Whether the `m_image` is available. This mirrors `isLoaded` but can
+           *          be checked without acquiring the locker.
+           */
+          std::atomic<bool> m_ready;
+
+          /**
+           * @brief - Whether the last attempt to load the data of the image failed.
            */
-          SDL_Surface* m_image;
+          std::atomic<bool> m_failed;
       };
 
       using ImageShPtr = std::shared_ptr<Image>;
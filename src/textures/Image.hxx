@@ -61,7 +61,26 @@ namespace sdl {
         }
 
         // Return the loaded image.
-        return m_image;
+        return m_image.get();
+      }
+
+      inline
+      void
+      Image::preload() {
+        const std::lock_guard guard(m_locker);
+        load();
+      }
+
+      inline
+      bool
+      Image::isReady() const noexcept {
+        return m_ready.load();
+      }
+
+      inline
+      bool
+      Image::hasFailed() const noexcept {
+        return m_failed.load();
       }
 
       inline
@@ -0,0 +1,139 @@
+
+# include "ImageCache.hh"
+# include <filesystem>
+# include "BitmapLoader.hh"
+
+namespace sdl {
+  namespace core {
+    namespace engine {
+
+      ImageCache&
+      ImageCache::getInstance() {
+        // Default to a budget of 64MB of pixel data which is plenty for the
+        // icons and textures used by most applications.
+        static ImageCache cache(64u * 1024u * 1024u);
+        return cache;
+      }
+
+      ImageCache::ImageCache(std::size_t budget):
+        utils::CoreObject(std::string("image_cache")),
+
+        m_locker(),
+
+        m_entries(),
+        m_named(),
+
+        m_budget(budget),
+        m_size(0u),
+
+        m_clock(0u),
+
+        m_hits(0u),
+        m_misses(0u)
+      {
+        setService("image");
+      }
+
+      SurfaceShPtr
+      ImageCache::load(const std::string& file) {
+        // Images registered explicitly take precedence over the files.
+        {
+          const std::lock_guard guard(m_locker);
+
+          std::unordered_map<std::string, SurfaceShPtr>::const_iterator it = m_named.find(file);
+          if (it != m_named.cend()) {
+            ++m_hits;
+            return it->second;
+          }
+        }
+
+        // Identify the file: we use its canonical path so that several ways
+        // to reference the same file all hit the same entry. The modification
+        // time allows to detect files modified since they were last loaded.
+        std::error_code err;
+        const std::filesystem::path path = std::filesystem::canonical(file, err);
+        if (err) {
+          warn("Could not resolve path of image \"" + file + "\" (err: " + err.message() + ")");
+          SDL_SetError("%s", err.message().c_str());
+          return nullptr;
+        }
+
+        const std::filesystem::file_time_type time = std::filesystem::last_write_time(path, err);
+        if (err) {
+          warn("Could not retrieve modification time of image \"" + file + "\" (err: " + err.message() + ")");
+          SDL_SetError("%s", err.message().c_str());
+          return nullptr;
+        }
+
+        const std::string key = path.string();
+        const std::int64_t mtime = static_cast<std::int64_t>(time.time_since_epoch().count());
+
+        {
+          const std::lock_guard guard(m_locker);
+
+          Entries::iterator it = m_entries.find(key);
+          if (it != m_entries.end() && it->second.mtime == mtime) {
+            ++m_hits;
+            it->second.lastUse = ++m_clock;
+
+            return it->second.surface;
+          }
+
+          ++m_misses;
+        }
+
+        // Decode the file without holding the lock: this can take a while and
+        // we don't want to prevent other images from being served.
+        SurfaceShPtr surface = loadBitmap(key);
+        if (surface == nullptr) {
+          warn("Unable to create image from file \"" + file + "\" (err: " + SDL_GetError() + ")");
+          return nullptr;
+        }
+
+        const std::lock_guard guard(m_locker);
+
+        // Another thread might have loaded the same file in the meantime: in
+        // this case we keep the existing entry so that the data is shared.
+        Entries::iterator it = m_entries.find(key);
+        if (it != m_entries.end()) {
+          if (it->second.mtime == mtime) {
+            it->second.lastUse = ++m_clock;
+            return it->second.surface;
+          }
+
+          m_size -= it->second.bytes;
+          m_entries.erase(it);
+        }
+
+        const std::size_t bytes = bytesOf(*surface);
+        m_entries[key] = Entry{mtime, surface, bytes, ++m_clock};
+        m_size += bytes;
+
+        shrink();
+
+        return surface;
+      }
+
+      void
+      ImageCache::shrink() {
+        while (m_size > m_budget && !m_entries.empty()) {
+          // Find the least recently used entry. The number of images loaded by
+          // an application is usually small enough for a linear scan to be ok.
+          Entries::iterator oldest = m_entries.begin();
+
+          for (Entries::iterator it = m_entries.begin() ; it != m_entries.end() ; ++it) {
+            if (it->second.lastUse < oldest->second.lastUse) {
+              oldest = it;
+            }
+          }
+
+          verbose("Evicting image \"" + oldest->first + "\" from cache (" + std::to_string(oldest->second.bytes) + " byte(s))");
+
+          m_size -= oldest->second.bytes;
+          m_entries.erase(oldest);
+        }
+      }
+
+    }
+  }
+}
@@ -0,0 +1,189 @@
+#ifndef    IMAGE_CACHE_HH
+# define   IMAGE_CACHE_HH
+
+# include <mutex>
+# include <memory>
+# include <string>
+# include <cstdint>
+# include <unordered_map>
+# include <core_utils/CoreObject.hh>
+# include <SDL2/SDL.h>
+
+namespace sdl {
+  namespace core {
+    namespace engine {
+
+      /**
+       * @brief - Convenience define for a surface which is shared among several
+       *          objects. The surface is released when the last reference to it
+       *          goes away.
+       */
+      using SurfaceShPtr = std::shared_ptr<SDL_Surface>;
+
+      /**
+       * @brief - A process wide cache of the images loaded from disk. Each file is
+       *          decoded at most once as long as it is not modified and the result
+       *          is shared among all the images (and thus textures and windows)
+       *          referencing it.
+       *          Files are identified by their canonical path and last modification
+       *          time: modifying a file on disk invalidates the cached data.
+       *          The cache holds the decoded surfaces up to a certain memory budget
+       *          after which the least recently used entries are evicted. Note that
+       *          evicting an entry does not release the surface if it is still used
+       *          somewhere: it is just not shared with new users anymore.
+       *          This object is thread safe.
+       */
+      class ImageCache: public utils::CoreObject {
+        public:
+
+          /**
+           * @brief - Retrieves the unique instance of the cache for this process.
+           * @return - the image cache.
+           */
+          static
+          ImageCache&
+          getInstance();
+
+          ~ImageCache() = default;
+
+          /**
+           * @brief - Retrieves the surface describing the input file. The file is read
+           *          and decoded only if it was not yet in the cache or if it has been
+           *          modified since it was loaded.
+           *          In case the file cannot be loaded a `null` surface is returned.
+           * @param file - the path to the file to load.
+           * @return - the surface created from the file or `null` if it can't be read.
+           */
+          SurfaceShPtr
+          load(const std::string& file);
+
+          /**
+           * @brief - Registers a surface under the input name: subsequent requests to
+           *          load a file with this name are served by this surface without any
+           *          access to the disk. This is typically used to provide the images
+           *          loaded from a bundle. Such surfaces are never evicted.
+           *          Any existing surface registered with this name is replaced.
+           * @param name - the name of the image, as it will be requested.
+           * @param surface - the surface describing the image.
+           */
+          void
+          add(const std::string& name,
+              SurfaceShPtr surface);
+
+          /**
+           * @brief - Removes all the entries of the cache. Surfaces still referenced
+           *          elsewhere are kept alive until their last user releases them.
+           */
+          void
+          clear();
+
+          /**
+           * @brief - Defines the maximum number of bytes of pixel data the cache can
+           *          hold. Entries are evicted right away if needed.
+           * @param bytes - the new budget of the cache.
+           */
+          void
+          setBudget(std::size_t bytes);
+
+          /**
+           * @brief - Returns the maximum number of bytes of pixel data held by the cache.
+           * @return - the budget of the cache.
+           */
+          std::size_t
+          getBudget() const noexcept;
+
+          /**
+           * @brief - Returns the number of bytes of pixel data currently held by the cache.
+           * @return - the memory used by the cache.
+           */
+          std::size_t
+          getSize() const noexcept;
+
+          /**
+           * @brief - Returns the number of requests which were served from the cache.
+           * @return - the number of cache hits.
+           */
+          unsigned
+          getHits() const noexcept;
+
+          /**
+           * @brief - Returns the number of requests which required to read the file from
+           *          disk.
+           * @return - the number of cache misses.
+           */
+          unsigned
+          getMisses() const noexcept;
+
+        private:
+
+          /**
+           * @brief - Creates the image cache. Use `getInstance` to access it.
+           * @param budget - the maximum number of bytes of pixel data the cache can hold.
+           */
+          ImageCache(std::size_t budget);
+
+          /**
+           * @brief - Describes a file loaded in the cache.
+           */
+          struct Entry {
+            std::int64_t mtime;
+            SurfaceShPtr surface;
+            std::size_t bytes;
+            unsigned long lastUse;
+          };
+
+          using Entries = std::unordered_map<std::string, Entry>;
+
+          /**
+           * @brief - Computes the number of bytes of pixel data in the input surface.
+           * @param surface - the surface to measure.
+           * @return - the size in bytes of the pixels of the surface.
+           */
+          static
+          std::size_t
+          bytesOf(const SDL_Surface& surface) noexcept;
+
+          /**
+           * @brief - Evicts the least recently used entries until the size of the cache
+           *          is within the budget. Assumes that the locker is already acquired.
+           */
+          void
+          shrink();
+
+        private:
+
+          /**
+           * @brief - Protects the entries of the cache from concurrent accesses.
+           */
+          mutable std::mutex m_locker;
+
+          /**
+           * @brief - The files loaded so far indexed by their canonical path.
+           */
+          Entries m_entries;
+
+          /**
+           * @brief - The surfaces registered through `add`, indexed by their name.
+           */
+          std::unordered_map<std::string, SurfaceShPtr> m_named;
+
+          std::size_t m_budget;
+          std::size_t m_size;
+
+          /**
+           * @brief - A counter increased each time an entry is accessed: it allows to
+           *          determine the least recently used entries.
+           */
+          unsigned long m_clock;
+
+          unsigned m_hits;
+          unsigned m_misses;
+      };
+
+    }
+  }
+}
+
+# include "ImageCache.hxx"
+
+#endif    /* IMAGE_CACHE_HH */
@@ -0,0 +1,76 @@
+#ifndef    IMAGE_CACHE_HXX
+# define   IMAGE_CACHE_HXX
+
+# include "ImageCache.hh"
+
+namespace sdl {
+  namespace core {
+    namespace engine {
+
+      inline
+      void
+      ImageCache::add(const std::string& name,
+                      SurfaceShPtr surface)
+      {
+        const std::lock_guard guard(m_locker);
+        m_named[name] = surface;
+      }
+
+      inline
+      void
+      ImageCache::clear() {
+        const std::lock_guard guard(m_locker);
+
+        m_entries.clear();
+        m_named.clear();
+        m_size = 0u;
+      }
+
+      inline
+      void
+      ImageCache::setBudget(std::size_t bytes) {
+        const std::lock_guard guard(m_locker);
+
+        m_budget = bytes;
+        shrink();
+      }
+
+      inline
+      std::size_t
+      ImageCache::getBudget() const noexcept {
+        const std::lock_guard guard(m_locker);
+        return m_budget;
+      }
+
+      inline
+      std::size_t
+      ImageCache::getSize() const noexcept {
+        const std::lock_guard guard(m_locker);
+        return m_size;
+      }
+
+      inline
+      unsigned
+      ImageCache::getHits() const noexcept {
+        const std::lock_guard guard(m_locker);
+        return m_hits;
+      }
+
+      inline
+      unsigned
+      ImageCache::getMisses() const noexcept {
+        const std::lock_guard guard(m_locker);
+        return m_misses;
+      }
+
+      inline
+      std::size_t
+      ImageCache::bytesOf(const SDL_Surface& surface) noexcept {
+        return static_cast<std::size_t>(surface.pitch) * static_cast<std::size_t>(surface.h);
+      }
+
+    }
+  }
+}
+
+#endif    /* IMAGE_CACHE_HXX */
@@ -7,11 +7,6 @@ namespace sdl {
 
       SDL_Texture*
       SurfaceTexture::create() {
-        // Declare the support for the texture if we need to create it.
-        // Indeed we need to keep it available at least until we create
-        // the texture from the surface.
-        std::vector<std::uint8_t> raw;
-
         if (m_surface == nullptr) {
           // Check whether we should create the texture from its raw data.
           if (m_rawData == nullptr) {
@@ -21,33 +16,27 @@ namespace sdl {
             );
           }
 
-          // Assume 4 channels (fair assumption as the raw data is composed of
-          // `Color` objects.
-          const unsigned channelCount = 4u;
-          const unsigned depth = channelCount * sizeof(std::uint8_t) * 8u;
-          const unsigned pitch = m_rawData->dims.w() * channelCount;
-          const unsigned total = m_rawData->dims.w() * m_rawData->dims.h();
-          const std::uint32_t format = SDL_PIXELFORMAT_RGBA32;
-
-          raw.resize(channelCount * total, 0u);
+          // The raw data is already packed in a format understood by the SDL:
+          // the surface can use it directly. This is safe because the data is
+          // kept alive by the texture for at least as long as the surface.
+          const int w = m_rawData->dims.w();
+          const int h = m_rawData->dims.h();
 
-          for (unsigned id = 0u ; id < total ; ++id) {
-            raw[channelCount * id + 0u] = m_rawData->colors[id].rU();
-            raw[channelCount * id + 1u] = m_rawData->colors[id].gU();
-            raw[channelCount * id + 2u] = m_rawData->colors[id].bU();
-            raw[channelCount * id + 3u] = m_rawData->colors[id].aU();
+          if (m_rawData->colors.size() < static_cast<std::size_t>(w) * static_cast<std::size_t>(h)) {
+            error(
+              std::string("Could not create texture from surface"),
+              std::string("Raw data contains ") + std::to_string(m_rawData->colors.size()) +
+              " color(s) but surface has dimensions " + m_rawData->dims.toString()
+            );
           }
 
-          // Create the canvas with the requested dimensions. We
-          // use a dedicated method allowing to create the surface
-          // directly from the raw data.
           m_surface = SDL_CreateRGBSurfaceWithFormatFrom(
-            raw.data(),
-            m_rawData->dims.w(),
-            m_rawData->dims.h(),
-            depth,
-            pitch,
-            format
+            m_rawData->colors.data(),
+            w,
+            h,
+            32,
+            w * static_cast<int>(sizeof(PackedColor)),
+            SDL_PIXELFORMAT_ARGB8888
           );
 
           if (m_surface == nullptr) {
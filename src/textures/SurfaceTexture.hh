@@ -6,6 +6,7 @@
 # include <SDL2/SDL.h>
 # include "Texture.hh"
 # include "Color.hh"
+# include "PackedColor.hh"
 
 namespace sdl {
   namespace core {
@@ -21,7 +22,7 @@ namespace sdl {
            */
           struct RawSurfaceData {
             utils::Sizei dims;
-            std::vector<Color> colors;
+            std::vector<PackedColor> colors;
           };
 
           using RawSurfaceDataShPtr = std::shared_ptr<RawSurfaceData>;
@@ -36,6 +37,18 @@ namespace sdl {
            */
           static
           RawSurfaceDataShPtr
+          createFromData(const utils::Sizei& dims,
+                         std::vector<PackedColor>& colors);
+
+          /**
+           * @brief - Similar to the above method but the colors are packed first.
+           *          The input vector is also emptied by calling this function.
+           * @param dims - the dimensions of the colors array.
+           * @param colors - the list of colors representing the surface.
+           * @return - a pointer to the raw surface data created.
+           */
+          static
+          RawSurfaceDataShPtr
           createFromData(const utils::Sizei& dims,
                          std::vector<Color>& colors);
 
@@ -91,6 +104,8 @@ namespace sdl {
 
           /**
            * @brief - An alternative way to define the texture through its raw data.
+           *          The surface created from it references the colors directly so
+           *          the data is kept alive as long as the texture.
            */
           RawSurfaceDataShPtr m_rawData;
 
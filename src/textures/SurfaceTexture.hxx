@@ -10,10 +10,10 @@ namespace sdl {
       inline
       SurfaceTexture::RawSurfaceDataShPtr
       SurfaceTexture::createFromData(const utils::Sizei& dims,
-                                     std::vector<Color>& colors)
+                                     std::vector<PackedColor>& colors)
       {
         RawSurfaceDataShPtr data = std::make_shared<RawSurfaceData>(
-          RawSurfaceData{utils::Sizei(), std::vector<Color>()}
+          RawSurfaceData{utils::Sizei(), std::vector<PackedColor>()}
         );
 
         data->dims = dims;
@@ -22,6 +22,17 @@ namespace sdl {
         return data;
       }
 
+      inline
+      SurfaceTexture::RawSurfaceDataShPtr
+      SurfaceTexture::createFromData(const utils::Sizei& dims,
+                                     std::vector<Color>& colors)
+      {
+        std::vector<PackedColor> packed(colors.cbegin(), colors.cend());
+        colors.clear();
+
+        return createFromData(dims, packed);
+      }
+
       inline
       SurfaceTexture::SurfaceTexture(SDL_Renderer* renderer,
                                      SDL_Surface* surface,
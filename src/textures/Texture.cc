@@ -16,7 +16,7 @@ namespace sdl {
         createOnce();
 
         // Retrieve the color to use to fill the texture from the palette.
-        SDL_Color color = palette.getColorForRole(getRole()).toSDLColor();
+        const SDL_Color color = palette.getSDLColorForRole(getRole());
 
         // Save the current state of the renderer: this will automatically handle restoring
         // the state upon destroying this object.
@@ -43,14 +43,16 @@ namespace sdl {
           SDL_RenderFillRect(getRenderer(), &dstRect);
         }
 
-        // Also apply alpha modulation for this texture.
-        setAlpha(palette.getColorForRole(getRole()));
+        // Also apply alpha modulation for this texture. The texture is already
+        // created so there's no need to go through `setAlpha`.
+        SDL_SetTextureAlphaMod(m_texture, color.a);
       }
 
       void
       Texture::draw(const utils::Boxf* from,
                     const utils::Boxf* box,
-                    SDL_Texture* on)
+                    SDL_Texture* on,
+                    const SDL_Rect* clip)
       {
         // Performs the creation of the texture using the dedicated handler
         // which will only create it once.
@@ -60,8 +62,12 @@ namespace sdl {
         // initial rendering target and properties (color, etc.).
         RendererState state(getRenderer());
 
-        // Set the input texture as rendering target.
+        // Set the input texture as rendering target. The clip rectangle
+        // is reset when the target changes so it is applied afterwards.
         SDL_SetRenderTarget(getRenderer(), on);
+        if (clip != nullptr) {
+          SDL_RenderSetClipRect(getRenderer(), clip);
+        }
 
         // Draw the input texture at the corresponding location.
         if (from == nullptr) {
@@ -83,6 +89,10 @@ namespace sdl {
             SDL_RenderCopy(getRenderer(), m_texture, &srcArea, &dstArea);
           }
         }
+
+        if (clip != nullptr) {
+          SDL_RenderSetClipRect(getRenderer(), nullptr);
+        }
       }
 
       void
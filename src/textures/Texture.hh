@@ -55,11 +55,14 @@ namespace sdl {
            * @param on - an optional texture which indicates the destination texture where
            *             `this` texture should be drawn. If this value is null `this` texture
            *             is copied on the default rendering target pf the renderer.
+           * @param clip - an optional area of the destination outside of which nothing
+           *               is drawn. If this value is null the copy is not clipped.
            */
           void
           draw(const utils::Boxf* from,
                const utils::Boxf* where,
-               SDL_Texture* on = nullptr);
+               SDL_Texture* on = nullptr,
+               const SDL_Rect* clip = nullptr);
 
           void
           setAlpha(const Color& color);
@@ -99,6 +102,18 @@ namespace sdl {
           virtual SDL_Texture*
           create() = 0;
 
+          /**
+           * @brief - Used to determine whether the underlying SDL texture should be
+           *          created again. This is useful for textures which are not able
+           *          to provide their final content right away: they can create a
+           *          temporary texture and request to be recreated when the final
+           *          data is available.
+           *          The default implementation returns `false`.
+           * @return - `true` if the texture should be recreated.
+           */
+          virtual bool
+          outdated() const noexcept;
+
         private:
 
           void
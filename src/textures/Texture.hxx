@@ -59,6 +59,12 @@ namespace sdl {
         m_role = role;
       }
 
+      inline
+      bool
+      Texture::outdated() const noexcept {
+        return false;
+      }
+
       inline
       void
       Texture::clean() {
@@ -70,6 +76,17 @@ namespace sdl {
       inline
       void
       Texture::createOnce() {
+        // Get rid of the texture if it should be recreated: we keep the alpha
+        // modulation which might have been set on the previous texture.
+        Uint8 alpha = SDL_ALPHA_OPAQUE;
+
+        if (valid() && outdated()) {
+          SDL_GetTextureAlphaMod(m_texture, &alpha);
+
+          clean();
+          m_texture = nullptr;
+        }
+
         // Create the texture if needed.
         if (!valid()) {
           m_texture = create();
@@ -77,6 +94,10 @@ namespace sdl {
           if (!valid()) {
             error(std::string("Could not create texture with type ") + std::to_string(static_cast<int>(m_type)));
           }
+
+          if (alpha != SDL_ALPHA_OPAQUE) {
+            SDL_SetTextureAlphaMod(m_texture, alpha);
+          }
         }
       }
 
@@ -0,0 +1,358 @@
+
+# include "TextureBundle.hh"
+# include <cstring>
+# include <fstream>
+# include <fcntl.h>
+# include <unistd.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include "BitmapLoader.hh"
+
+namespace {
+
+  /**
+   * @brief - The magic identifying a bundle.
+   */
+  constexpr char sk_magic[4] = {'S', 'D', 'L', 'B'};
+
+  /**
+   * @brief - Size of the header of a bundle in bytes.
+   */
+  constexpr std::size_t sk_headerSize = 16u;
+
+  /**
+   * @brief - A region of memory mapped from a file: it is released when this
+   *          object is destroyed. Each surface created over the mapping keeps
+   *          a reference on it.
+   */
+  struct Mapping {
+    void* addr;
+    std::size_t size;
+
+    ~Mapping() {
+      munmap(addr, size);
+    }
+  };
+
+  using MappingShPtr = std::shared_ptr<Mapping>;
+
+  /**
+   * @brief - Describes an image of a bundle as read from its index.
+   */
+  struct IndexEntry {
+    std::string name;
+    std::uint32_t w;
+    std::uint32_t h;
+    std::uint64_t offset;
+  };
+
+  /**
+   * @brief - Reads a little endian unsigned integer of the specified size from
+   *          the input buffer and advances the buffer.
+   * @param data - the buffer to read from.
+   * @return - the value read.
+   */
+  template <typename Integer>
+  Integer
+  readInt(const std::uint8_t*& data) noexcept {
+    Integer out = 0u;
+
+    for (unsigned id = 0u ; id < sizeof(Integer) ; ++id) {
+      out |= static_cast<Integer>(data[id]) << (8u * id);
+    }
+
+    data += sizeof(Integer);
+
+    return out;
+  }
+
+  /**
+   * @brief - Writes a little endian unsigned integer to the input stream.
+   * @param out - the stream to write to.
+   * @param value - the value to write.
+   */
+  template <typename Integer>
+  void
+  writeInt(std::ostream& out,
+           Integer value)
+  {
+    for (unsigned id = 0u ; id < sizeof(Integer) ; ++id) {
+      out.put(static_cast<char>((value >> (8u * id)) & 0xFFu));
+    }
+  }
+
+}
+
+namespace sdl {
+  namespace core {
+    namespace engine {
+
+      TextureBundle::TextureBundle(const std::string& file):
+        utils::CoreObject(std::string("bundle_") + file),
+
+        m_file(file),
+        m_names()
+      {
+        setService("image");
+      }
+
+      unsigned
+      TextureBundle::load() {
+        // Map the bundle in memory: the mapping is shared by all the surfaces
+        // created from it.
+        const int fd = open(m_file.c_str(), O_RDONLY);
+        if (fd < 0) {
+          error(
+            std::string("Could not load bundle \"") + m_file + "\"",
+            std::string("Failed to open file")
+          );
+        }
+
+        struct stat info;
+        if (fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < sk_headerSize) {
+          close(fd);
+          error(
+            std::string("Could not load bundle \"") + m_file + "\"",
+            std::string("Invalid file size")
+          );
+        }
+
+        // The surfaces created over the mapping are handed out by the image
+        // cache and might be written to by their users: a private writable
+        // mapping only copies the pages which are actually modified.
+        const std::size_t size = static_cast<std::size_t>(info.st_size);
+        void* addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        close(fd);
+
+        if (addr == MAP_FAILED) {
+          error(
+            std::string("Could not load bundle \"") + m_file + "\"",
+            std::string("Failed to map file")
+          );
+        }
+
+        MappingShPtr mapping = std::make_shared<Mapping>(Mapping{addr, size});
+
+        const std::uint8_t* data = static_cast<const std::uint8_t*>(addr);
+        const std::uint8_t* end = data + size;
+
+        // Check the header.
+        if (std::memcmp(data, sk_magic, sizeof(sk_magic)) != 0) {
+          error(
+            std::string("Could not load bundle \"") + m_file + "\"",
+            std::string("Invalid magic")
+          );
+        }
+
+        const std::uint8_t* cur = data + sizeof(sk_magic);
+
+        const std::uint32_t version = readInt<std::uint32_t>(cur);
+        const std::uint32_t count = readInt<std::uint32_t>(cur);
+        const std::uint32_t indexSize = readInt<std::uint32_t>(cur);
+
+        if (version != sk_version || indexSize > size - sk_headerSize) {
+          error(
+            std::string("Could not load bundle \"") + m_file + "\"",
+            std::string("Unsupported version ") + std::to_string(version) + " or invalid index"
+          );
+        }
+
+        const std::uint8_t* indexEnd = cur + indexSize;
+
+        // Validate the whole index before registering anything: a corrupted
+        // bundle should not leave some of its images in the cache.
+        std::vector<IndexEntry> entries;
+        entries.reserve(count);
+
+        for (unsigned id = 0u ; id < count ; ++id) {
+          if (indexEnd - cur < 2) {
+            error(
+              std::string("Could not load bundle \"") + m_file + "\"",
+              std::string("Truncated index")
+            );
+          }
+
+          const std::uint16_t length = readInt<std::uint16_t>(cur);
+
+          // The name is followed by the dimensions and offset of the image.
+          if (indexEnd - cur < static_cast<long>(length) + 16l) {
+            error(
+              std::string("Could not load bundle \"") + m_file + "\"",
+              std::string("Truncated index")
+            );
+          }
+
+          IndexEntry entry;
+          entry.name = std::string(reinterpret_cast<const char*>(cur), length);
+          cur += length;
+
+          entry.w = readInt<std::uint32_t>(cur);
+          entry.h = readInt<std::uint32_t>(cur);
+          entry.offset = readInt<std::uint64_t>(cur);
+
+          const std::uint64_t bytes = 4ull * entry.w * entry.h;
+          if (entry.w == 0u || entry.h == 0u || entry.offset > size || bytes > size - entry.offset) {
+            error(
+              std::string("Could not load image \"") + entry.name + "\" from bundle \"" + m_file + "\"",
+              std::string("Invalid dimensions ") + std::to_string(entry.w) + "x" + std::to_string(entry.h)
+            );
+          }
+
+          entries.push_back(entry);
+        }
+
+        // Create a surface for each image.
+        std::vector<SurfaceShPtr> surfaces;
+        surfaces.reserve(entries.size());
+
+        for (unsigned id = 0u ; id < entries.size() ; ++id) {
+          const IndexEntry& entry = entries[id];
+
+          SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormatFrom(
+            static_cast<std::uint8_t*>(addr) + entry.offset,
+            static_cast<int>(entry.w),
+            static_cast<int>(entry.h),
+            32,
+            static_cast<int>(4u * entry.w),
+            SDL_PIXELFORMAT_ARGB8888
+          );
+
+          if (surface == nullptr) {
+            error(
+              std::string("Could not load image \"") + entry.name + "\" from bundle \"" + m_file + "\"",
+              SDL_GetError()
+            );
+          }
+
+          surfaces.push_back(
+            SurfaceShPtr(
+              surface,
+              [mapping](SDL_Surface* s) {
+                // Capturing the mapping keeps it alive as long as the surface.
+                SDL_FreeSurface(s);
+              }
+            )
+          );
+        }
+
+        // Register the images now that the bundle is known to be valid.
+        ImageCache& cache = ImageCache::getInstance();
+        std::vector<std::string> names;
+        names.reserve(entries.size());
+
+        for (unsigned id = 0u ; id < entries.size() ; ++id) {
+          cache.add(entries[id].name, surfaces[id]);
+          names.push_back(entries[id].name);
+        }
+
+        verbose("Loaded " + std::to_string(names.size()) + " image(s) from bundle \"" + m_file + "\" (" + std::to_string(size) + " byte(s))");
+
+        m_names.swap(names);
+
+        return m_names.size();
+      }
+
+      void
+      TextureBundle::write(const std::vector<std::string>& files) {
+        const std::string& output = m_file;
+
+        // Load and convert all the images first: this allows to compute the
+        // size of the index and thus the offset of each image.
+        std::vector<SurfaceShPtr> images;
+        images.reserve(files.size());
+
+        std::uint64_t indexSize = 0u;
+
+        for (unsigned id = 0u ; id < files.size() ; ++id) {
+          SurfaceShPtr raw = loadBitmap(files[id]);
+          if (raw == nullptr) {
+            error(
+              std::string("Could not add \"") + files[id] + "\" to bundle \"" + output + "\"",
+              SDL_GetError()
+            );
+          }
+
+          SDL_Surface* converted = SDL_ConvertSurfaceFormat(raw.get(), SDL_PIXELFORMAT_ARGB8888, 0);
+          if (converted == nullptr) {
+            error(
+              std::string("Could not convert \"") + files[id] + "\" for bundle \"" + output + "\"",
+              SDL_GetError()
+            );
+          }
+
+          if (files[id].size() > 0xFFFFu) {
+            SDL_FreeSurface(converted);
+            error(
+              std::string("Could not add \"") + files[id] + "\" to bundle \"" + output + "\"",
+              std::string("Name is too long")
+            );
+          }
+
+          images.push_back(SurfaceShPtr(converted, SDL_FreeSurface));
+          indexSize += 2u + files[id].size() + 16u;
+        }
+
+        std::ofstream out(output, std::ios::binary | std::ios::trunc);
+        if (!out) {
+          error(
+            std::string("Could not write bundle \"") + output + "\"",
+            std::string("Failed to open file")
+          );
+        }
+
+        // Header.
+        out.write(sk_magic, sizeof(sk_magic));
+        writeInt<std::uint32_t>(out, sk_version);
+        writeInt<std::uint32_t>(out, static_cast<std::uint32_t>(images.size()));
+        writeInt<std::uint32_t>(out, static_cast<std::uint32_t>(indexSize));
+
+        // Index: the pixels of each image are aligned on a fixed boundary.
+        std::vector<std::uint64_t> offsets;
+        offsets.reserve(images.size());
+
+        std::uint64_t offset = sk_headerSize + indexSize;
+
+        for (unsigned id = 0u ; id < images.size() ; ++id) {
+          offset = ((offset + sk_alignment - 1u) / sk_alignment) * sk_alignment;
+          offsets.push_back(offset);
+
+          writeInt<std::uint16_t>(out, static_cast<std::uint16_t>(files[id].size()));
+          out.write(files[id].data(), files[id].size());
+          writeInt<std::uint32_t>(out, static_cast<std::uint32_t>(images[id]->w));
+          writeInt<std::uint32_t>(out, static_cast<std::uint32_t>(images[id]->h));
+          writeInt<std::uint64_t>(out, offset);
+
+          offset += 4ull * images[id]->w * images[id]->h;
+        }
+
+        // Pixels: rows are written without padding.
+        std::uint64_t written = sk_headerSize + indexSize;
+
+        for (unsigned id = 0u ; id < images.size() ; ++id) {
+          for (; written < offsets[id] ; ++written) {
+            out.put('\0');
+          }
+
+          const SDL_Surface& img = *images[id];
+          const std::uint8_t* pixels = static_cast<const std::uint8_t*>(img.pixels);
+
+          for (int y = 0 ; y < img.h ; ++y) {
+            out.write(reinterpret_cast<const char*>(pixels + static_cast<std::size_t>(y) * img.pitch), 4 * img.w);
+          }
+
+          written += 4ull * img.w * img.h;
+        }
+
+        if (!out) {
+          error(
+            std::string("Could not write bundle \"") + output + "\"",
+            std::string("Failed to write data")
+          );
+        }
+
+        verbose("Wrote " + std::to_string(images.size()) + " image(s) to bundle \"" + output + "\" (" + std::to_string(written) + " byte(s))");
+      }
+
+    }
+  }
+}
@@ -0,0 +1,105 @@
+#ifndef    TEXTURE_BUNDLE_HH
+# define   TEXTURE_BUNDLE_HH
+
+# include <memory>
+# include <string>
+# include <vector>
+# include <cstdint>
+# include <core_utils/CoreObject.hh>
+# include "ImageCache.hh"
+
+namespace sdl {
+  namespace core {
+    namespace engine {
+
+      /**
+       * @brief - A bundle groups many images in a single file so that they can be
+       *          loaded in a single pass at startup. The images are stored already
+       *          converted to the `SDL_PIXELFORMAT_ARGB8888` format so that loading
+       *          the bundle only requires to map the file in memory: the surfaces
+       *          are created directly over the mapped pixels.
+       *          Each image of the bundle is identified by a name (usually the path
+       *          of the file it has been created from). Loading the bundle registers
+       *          all of them in the `ImageCache`: the regular `Image` class can then
+       *          be used with these names and no access to the disk is performed.
+       *          The layout of a bundle is as follows (all values little endian):
+       *            - a header: the `SDLB` magic, the version, the number of images
+       *              and the size of the index in bytes (4 bytes each).
+       *            - the index: for each image the length of its name (2 bytes),
+       *              its name, its width and height (4 bytes each) and the offset
+       *              of its pixels from the beginning of the file (8 bytes).
+       *            - the pixels of each image, with rows of `4 * width` bytes. The
+       *              pixels of each image start on a 16 bytes boundary.
+       */
+      class TextureBundle: public utils::CoreObject {
+        public:
+
+          /**
+           * @brief - Creates a bundle associated to the input file. The file is not
+           *          accessed until either `load` or `write` is called.
+           * @param file - the path to the bundle.
+           */
+          TextureBundle(const std::string& file);
+
+          ~TextureBundle() = default;
+
+          /**
+           * @brief - Maps the bundle in memory and registers all its images in the
+           *          `ImageCache`. An error is raised if the bundle is not valid.
+           *          The memory is released when none of the images are used any
+           *          more.
+           * @return - the number of images registered.
+           */
+          unsigned
+          load();
+
+          /**
+           * @brief - Returns the names of the images loaded from the bundle so far.
+           * @return - the names of the images of the bundle.
+           */
+          const std::vector<std::string>&
+          getNames() const noexcept;
+
+          /**
+           * @brief - Creates the bundle from the input list of files, overriding any
+           *          existing file. Each image is loaded and converted to the format
+           *          of the bundle and registered under its path as provided in the
+           *          input list.
+           *          An error is raised if any of the files cannot be loaded or if the
+           *          bundle cannot be written.
+           * @param files - the list of images to include in the bundle.
+           */
+          void
+          write(const std::vector<std::string>& files);
+
+        private:
+
+          /**
+           * @brief - The version of the format of the bundles produced by this class.
+           */
+          static constexpr std::uint32_t sk_version = 1u;
+
+          /**
+           * @brief - Alignment of the pixels of each image in the bundle.
+           */
+          static constexpr std::uint64_t sk_alignment = 16u;
+
+          /**
+           * @brief - The path to the bundle.
+           */
+          std::string m_file;
+
+          /**
+           * @brief - The names of the images of the bundle.
+           */
+          std::vector<std::string> m_names;
+      };
+
+      using TextureBundleShPtr = std::shared_ptr<TextureBundle>;
+    }
+  }
+}
+
+# include "TextureBundle.hxx"
+
+#endif    /* TEXTURE_BUNDLE_HH */
@@ -0,0 +1,20 @@
+#ifndef    TEXTURE_BUNDLE_HXX
+# define   TEXTURE_BUNDLE_HXX
+
+# include "TextureBundle.hh"
+
+namespace sdl {
+  namespace core {
+    namespace engine {
+
+      inline
+      const std::vector<std::string>&
+      TextureBundle::getNames() const noexcept {
+        return m_names;
+      }
+
+    }
+  }
+}
+
+#endif    /* TEXTURE_BUNDLE_HXX */
@@ -0,0 +1,38 @@
+
+# include <string>
+# include <vector>
+# include <iostream>
+# include <cstdlib>
+# include <exception>
+# include "TextureBundle.hh"
+
+/**
+ * @brief - Offline tool creating a bundle of textures from a list of bitmap
+ *          images. Each image is registered in the bundle under the path it
+ *          was provided with so the application should use the same paths to
+ *          reference them.
+ *          Usage: sdl_texture_packer <output> <image> [<image> ...]
+ */
+int
+main(int argc, char** argv) {
+  if (argc < 3) {
+    std::cerr << "Usage: " << argv[0] << " <output> <image> [<image> ...]" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const std::string output(argv[1]);
+  std::vector<std::string> files(argv + 2, argv + argc);
+
+  try {
+    sdl::core::engine::TextureBundle bundle(output);
+    bundle.write(files);
+  }
+  catch (const std::exception& e) {
+    std::cerr << "Could not create bundle \"" << output << "\": " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Packed " << files.size() << " image(s) into \"" << output << "\"" << std::endl;
+
+  return EXIT_SUCCESS;
+}